@@ -0,0 +1,142 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              access_index.h                              **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_ACCESS_INDEX_H
+#define OSL_ACCESS_INDEX_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <osl/attributes.h>
+#include <osl/relation.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define OSL_ACCESS_INDEX_NB_TYPES 4 /**< Access, read, write, may write */
+
+/**
+ * The osl_access_ref_t structure stores one access of a scop, i.e., an
+ * access relation together with the statement it belongs to.
+ */
+struct osl_access_ref {
+  osl_statement_p statement; /**< Statement performing the access */
+  int label;                 /**< Rank of the statement in the scop */
+  osl_relation_p access;     /**< Access relation */
+};
+typedef struct osl_access_ref osl_access_ref_t;
+typedef struct osl_access_ref* osl_access_ref_p;
+
+/**
+ * The osl_access_index_t structure is an inverted index of the accesses of
+ * a scop: it associates to every array identifier the accesses to this
+ * array, grouped by access type in the order OSL_TYPE_ACCESS, OSL_TYPE_READ,
+ * OSL_TYPE_WRITE and OSL_TYPE_MAY_WRITE, hence e.g. the writers of an
+ * array (writes and may writes) are contiguous in the ref array. The
+ * references of array id and of type t are ref[start[k]] to
+ * ref[start[k + 1] - 1] with k = id * OSL_ACCESS_INDEX_NB_TYPES +
+ * (t - OSL_TYPE_ACCESS). The index is a snapshot: it has to be generated
+ * again when the accesses of the scop are modified.
+ */
+struct osl_access_index {
+  int max_array_id;     /**< Greatest indexed array identifier */
+  size_t* start;        /**< Offsets of each (array, type) pair in ref */
+  size_t nb_refs;       /**< Number of indexed accesses */
+  osl_access_ref_p ref; /**< Indexed accesses, by array then type */
+  size_t nb_unindexed;  /**< Number of accesses without array id */
+};
+typedef struct osl_access_index osl_access_index_t;
+typedef struct osl_access_index* osl_access_index_p;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+void osl_access_index_idump(FILE*, const osl_access_index_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_access_index_dump(FILE*, const osl_access_index_t*)
+    OSL_NONNULL_ARGS(1);
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+osl_access_index_t* osl_access_index_malloc(void) OSL_WARN_UNUSED_RESULT;
+void osl_access_index_free(osl_access_index_t*);
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+osl_access_index_t* osl_access_index_generate(osl_scop_t*)
+    OSL_WARN_UNUSED_RESULT;
+size_t osl_access_index_lookup(const osl_access_index_t*, int, int,
+                               const osl_access_ref_t**);
+size_t osl_access_index_writers(const osl_access_index_t*, int,
+                                const osl_access_ref_t**);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_ACCESS_INDEX_H */
@@ -0,0 +1,160 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 arena.h                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_ARENA_H
+#define OSL_ARENA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <osl/attributes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define OSL_ARENA_ALIGNMENT 16
+#define OSL_ARENA_CHUNK_SIZE 65536
+#define OSL_ARENA_CHUNK_MAX_SIZE 16777216
+
+/**
+ * The osl_arena_chunk_t structure stores one memory block of an arena. It is
+ * a node of a NULL-terminated list of chunks, the most recent chunk first.
+ */
+struct osl_arena_chunk {
+  char* memory;                 /**< First usable byte of the chunk */
+  size_t size;                  /**< Number of usable bytes */
+  size_t used;                  /**< Number of bytes already handed out */
+  struct osl_arena_chunk* next; /**< Next (older) chunk in the list */
+};
+typedef struct osl_arena_chunk osl_arena_chunk_t;
+typedef struct osl_arena_chunk* osl_arena_chunk_p;
+
+/**
+ * The osl_arena_t structure stores a bump allocator. While an arena is the
+ * current arena of a thread (see osl_arena_set_current()), every allocation
+ * the library does on that thread through OSL_malloc, OSL_realloc or
+ * OSL_strdup is carved out of the arena, and osl_arena_free() releases all
+ * of it at once, without visiting the objects. The rules for mixing arena
+ * and heap objects are the following:
+ * - A block belongs to the arena that was current when it was allocated,
+ *   and it keeps belonging to it when it is resized with OSL_realloc.
+ * - The osl_*_free functions skip arena blocks and release heap blocks, so
+ *   calling them on arena data, or on a mix of both, is always safe.
+ * - Objects attached to an arena scop while no arena is current (e.g., by
+ *   osl_relation_insert_constraints() or osl_generic_add()) are heap
+ *   objects that osl_arena_free() does not reclaim. Either make the arena
+ *   current again while mutating the scop, or call osl_scop_free() (which
+ *   only releases the heap parts) before osl_arena_free().
+ * - Strings returned by the library while an arena is current (e.g., by
+ *   osl_relation_sprint()) belong to the arena: release them with OSL_free
+ *   or leave them to osl_arena_free(), never with free().
+ * - In multiple precision, integer limbs are allocated by GMP itself and
+ *   are not reclaimed by osl_arena_free(): call osl_scop_free() first.
+ * Arenas are not thread-safe: a given arena must be current on at most one
+ * thread at a time, and arenas must not be created or freed while other
+ * threads are using the library.
+ */
+struct osl_arena {
+  osl_arena_chunk_p chunk; /**< List of chunks, the most recent first */
+  size_t chunk_size;       /**< Size of the next chunk to allocate */
+  size_t nb_chunks;        /**< Number of chunks in the list */
+  size_t allocated;        /**< Total number of bytes handed out */
+  struct osl_arena* next;  /**< Next live arena (library registry) */
+};
+typedef struct osl_arena osl_arena_t;
+typedef struct osl_arena* osl_arena_p;
+
+/* Number of live arenas. The library allocator (OSL_realloc, OSL_free) only
+ * looks for the arena owning a block when it is not 0, so that programs that
+ * never create an arena do not pay for the lookup. Read-only for users.
+ */
+extern size_t osl_arena_nb_live;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+void osl_arena_idump(FILE*, const osl_arena_t*, int) OSL_NONNULL_ARGS(1);
+void osl_arena_dump(FILE*, const osl_arena_t*) OSL_NONNULL_ARGS(1);
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+osl_arena_t* osl_arena_malloc(void) OSL_WARN_UNUSED_RESULT;
+void osl_arena_free(osl_arena_t*);
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+void* osl_arena_alloc(osl_arena_t*, size_t) OSL_NONNULL_ARGS(1);
+void* osl_arena_realloc(osl_arena_t*, void*, size_t) OSL_NONNULL_ARGS(1);
+int osl_arena_owns(const osl_arena_t*, const void*);
+osl_arena_t* osl_arena_lookup(const void*);
+osl_arena_t* osl_arena_set_current(osl_arena_t*);
+osl_arena_t* osl_arena_get_current(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_ARENA_H */
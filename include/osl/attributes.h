@@ -97,4 +97,13 @@
 #define OSL_WARN_UNUSED_RESULT
 #endif
 
+// Vector kernels get one clone per instruction set, chosen at load time.
+#if !defined(__clang__) && (__GNUC__ >= 6) && defined(__x86_64__) && \
+    defined(__linux__)
+#define OSL_TARGET_CLONES \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define OSL_TARGET_CLONES
+#endif
+
 #endif
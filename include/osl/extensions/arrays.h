@@ -77,12 +77,19 @@ extern "C" {
  * The osl_arrays_t structure stores a set of array textual names in
  * the extension part of the OpenScop representation. Each name has a
  * name string and an identifier: the ith name as name string names[i]
- * and identifier id[i].
+ * and identifier id[i]. From the first index lookup (see
+ * osl_arrays_index_build()), the structure also holds id and name hash maps
+ * for the lookups, that are kept up to date by the osl_arrays functions.
  */
 struct osl_arrays {
-  int nb_names; /**< Number of names. */
-  int* id;      /**< Array of nb_names identifiers. */
-  char** names; /**< Array of nb_names names. */
+  int nb_names;   /**< Number of names. */
+  int* id;        /**< Array of nb_names identifiers. */
+  char** names;   /**< Array of nb_names names. */
+  int size;       /**< Number of allocated identifiers and names. */
+  int nb_indexed; /**< Number of indexed names, 0 if not indexed. */
+  int nb_slots;   /**< Number of slots of each hash map. */
+  int* id_slot;   /**< Identifier hash map: index + 1, 0 if empty. */
+  int* name_slot; /**< Name hash map: index + 1, 0 if empty. */
 };
 typedef struct osl_arrays osl_arrays_t;
 typedef struct osl_arrays* osl_arrays_p;
@@ -114,11 +121,13 @@ void osl_arrays_free(osl_arrays_t*);
 
 osl_arrays_t* osl_arrays_clone(const osl_arrays_t*) OSL_WARN_UNUSED_RESULT;
 bool osl_arrays_equal(const osl_arrays_t*, const osl_arrays_t*);
+uint64_t osl_arrays_hash(const osl_arrays_t*);
 osl_strings_t* osl_arrays_to_strings(const osl_arrays_t*)
     OSL_WARN_UNUSED_RESULT;
 int osl_arrays_add(osl_arrays_t*, int, const char*);
 size_t osl_arrays_get_index_from_id(const osl_arrays_t*, int);
 size_t osl_arrays_get_index_from_name(const osl_arrays_t*, const char*);
+void osl_arrays_index_build(osl_arrays_t*);
 osl_interface_t* osl_arrays_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
@@ -203,6 +203,8 @@ bool osl_dependence_equal(const osl_dependence_t*, const osl_dependence_t*);
 void osl_dependence_add(osl_dependence_t**, osl_dependence_t**,
                         osl_dependence_t*);
 int osl_nb_dependences(const osl_dependence_t*);
+int osl_dependence_prune_empty(osl_dependence_t**);
+int osl_dependence_resolve(osl_dependence_t*, osl_statement_index_t*);
 osl_interface_t* osl_dependence_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
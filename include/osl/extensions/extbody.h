@@ -117,6 +117,7 @@ void osl_extbody_free(osl_extbody_t*);
 
 osl_extbody_t* osl_extbody_clone(const osl_extbody_t*) OSL_WARN_UNUSED_RESULT;
 bool osl_extbody_equal(const osl_extbody_t*, const osl_extbody_t*);
+uint64_t osl_extbody_hash(const osl_extbody_t*);
 osl_interface_t* osl_extbody_interface(void) OSL_WARN_UNUSED_RESULT;
 void osl_extbody_add(osl_extbody_t*, int, int);
 
@@ -92,6 +92,33 @@ struct osl_symbols {
 typedef struct osl_symbols osl_symbols_t;
 typedef struct osl_symbols* osl_symbols_p;
 
+#define OSL_SYMBOLS_INDEX_NB_TYPES 5 /**< Undefined, then OSL_SYMBOL_TYPE_* */
+
+/**
+ * The osl_symbols_index_t structure indexes a list of symbols, to get a
+ * symbol from its name (the string of its identifier) in constant time and
+ * the symbols of a given type as a contiguous array. It also stores the
+ * name, type and number of dimensions of the symbols in flat arrays, by
+ * rank in the list, so that bulk queries neither walk the list nor unpack
+ * generics. The symbols of type t are by_type[start[k]] to
+ * by_type[start[k + 1] - 1] with k = t for the OSL_SYMBOL_TYPE_* types and
+ * k = 0 otherwise. The index is a snapshot: it has to be built again when
+ * the list is modified.
+ */
+struct osl_symbols_index {
+  int nb_symbols;         /**< Number of indexed symbols */
+  osl_symbols_p* symbol;  /**< Indexed symbols, by rank */
+  const char** name;      /**< Symbol names (NULL if none), by rank */
+  int* type;              /**< Symbol types, by rank */
+  int* nb_dims;           /**< Symbol numbers of dimensions, by rank */
+  int* start;             /**< Offsets of each type in by_type */
+  osl_symbols_p* by_type; /**< Indexed symbols, by type then rank */
+  size_t nb_slots;        /**< Size of slot (a power of 2) */
+  int* slot;              /**< Hash table of ranks + 1, by name */
+};
+typedef struct osl_symbols_index osl_symbols_index_t;
+typedef struct osl_symbols_index* osl_symbols_index_p;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -99,6 +126,10 @@ typedef struct osl_symbols* osl_symbols_p;
 void osl_symbols_idump(FILE*, const osl_symbols_t*, int) OSL_NONNULL_ARGS(1);
 void osl_symbols_dump(FILE*, const osl_symbols_t*) OSL_NONNULL_ARGS(1);
 char* osl_symbols_sprint(const osl_symbols_t*) OSL_WARN_UNUSED_RESULT;
+void osl_symbols_index_idump(FILE*, const osl_symbols_index_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_symbols_index_dump(FILE*, const osl_symbols_index_t*)
+    OSL_NONNULL_ARGS(1);
 
 /******************************************************************************
  *                               Reading function                             *
@@ -112,6 +143,7 @@ osl_symbols_t* osl_symbols_sread(char**) OSL_WARN_UNUSED_RESULT;
 
 osl_symbols_t* osl_symbols_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_symbols_free(osl_symbols_t*);
+void osl_symbols_index_free(osl_symbols_index_t*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -127,6 +159,13 @@ osl_symbols_t* osl_symbols_lookup(osl_symbols_t*,
 osl_symbols_t* osl_symbols_remove(osl_symbols_t**,
                                   osl_symbols_t*) OSL_WARN_UNUSED_RESULT;
 int osl_symbols_get_nb_symbols(const osl_symbols_t*);
+const char* osl_symbols_get_name(const osl_symbols_t*);
+osl_symbols_index_t* osl_symbols_index_build(osl_symbols_t*)
+    OSL_WARN_UNUSED_RESULT;
+osl_symbols_t* osl_symbols_index_lookup(const osl_symbols_index_t*,
+                                        const char*);
+int osl_symbols_index_get_type(const osl_symbols_index_t*, int,
+                               osl_symbols_t* const**);
 osl_interface_t* osl_symbols_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
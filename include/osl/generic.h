@@ -68,16 +68,35 @@
 extern "C" {
 #endif
 
+/**
+ * The osl_generic_index_t structure indexes a list of generics by URI, to
+ * get a generic from its URI in constant expected time, e.g., for the
+ * extensions of a scop or of a statement. It belongs to the head of the
+ * list (see osl_generic_t), and osl_generic_add(), osl_generic_remove()
+ * and osl_generic_remove_node() keep it in sync with the list.
+ */
+struct osl_generic_index {
+  int nb_generics;           /**< Number of indexed generics */
+  size_t nb_slots;           /**< Size of slot (a power of 2) */
+  struct osl_generic** slot; /**< Hash table of the generics, by URI */
+};
+typedef struct osl_generic_index osl_generic_index_t;
+typedef struct osl_generic_index* osl_generic_index_p;
+
 /**
  * The osl_generic_t structure stores OpenScop data and operations with
  * no pre-defined type. The information is accessible through the data pointer
  * while the type and operations are accessible through the interface pointer.
  * A generic is a also a node of a NULL-terminated linked list of generics.
+ * The head of a list built with osl_generic_add() owns an index of the list
+ * by URI (index, NULL in the other nodes). A list whose nodes are linked or
+ * unlinked directly has to be indexed again with osl_generic_index_sync().
  */
 struct osl_generic {
   void* data;                /**< Pointer to the data. */
   osl_interface_p interface; /**< Interface to work with the data. */
   struct osl_generic* next;  /**< Pointer to the next generic. */
+  osl_generic_index_p index; /**< Index of the list (head only) or NULL. */
 };
 typedef struct osl_generic osl_generic_t;
 typedef struct osl_generic* osl_generic_p;
@@ -93,6 +112,10 @@ void osl_generic_idump(FILE*, const osl_generic_t*, int) OSL_NONNULL_ARGS(1);
 void osl_generic_dump(FILE*, const osl_generic_t*) OSL_NONNULL_ARGS(1);
 void osl_generic_print(FILE*, const osl_generic_t*) OSL_NONNULL_ARGS(1);
 char* osl_generic_sprint(const osl_generic_t*);
+void osl_generic_index_idump(FILE*, const osl_generic_index_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_generic_index_dump(FILE*, const osl_generic_index_t*)
+    OSL_NONNULL_ARGS(1);
 
 // SCoPLib Compatibility
 void osl_generic_print_options_scoplib(FILE*, const osl_generic_t*)
@@ -116,6 +139,7 @@ void osl_generic_remove_node(osl_generic_t**, osl_generic_t*)
 void osl_generic_remove(osl_generic_t**, const char*) OSL_NONNULL_ARGS(1);
 osl_generic_t* osl_generic_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_generic_free(osl_generic_t*);
+void osl_generic_index_free(osl_generic_index_t*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -125,11 +149,13 @@ osl_generic_t* osl_generic_clone(const osl_generic_t*) OSL_WARN_UNUSED_RESULT;
 osl_generic_t* osl_generic_nclone(const osl_generic_t*,
                                   int) OSL_WARN_UNUSED_RESULT;
 bool osl_generic_equal(const osl_generic_t*, const osl_generic_t*);
+uint64_t osl_generic_hash(const osl_generic_t*);
 int osl_generic_has_URI(const osl_generic_t*, char const* const);
 void* osl_generic_lookup(const osl_generic_t*, char const* const);
 osl_generic_t* osl_generic_shell(void*,
                                  osl_interface_t*) OSL_WARN_UNUSED_RESULT;
 int osl_generic_count(const osl_generic_t*);
+void osl_generic_index_sync(osl_generic_t*);
 
 #if defined(__cplusplus)
 }
@@ -61,6 +61,7 @@
 #ifndef OSL_INT_H
 #define OSL_INT_H
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -147,12 +148,23 @@ void osl_int_abs(int, osl_int_t*, const osl_int_t);
 size_t osl_int_size_in_base_2(int const, const osl_int_t);
 size_t osl_int_size_in_base_10(int const, const osl_int_t);
 
+/******************************************************************************
+ *                              Array Operations                              *
+ ******************************************************************************/
+
+void osl_int_oppose_array(int, osl_int_t*, size_t);
+void osl_int_addmul_array(int, osl_int_t*, const osl_int_t*, size_t,
+                          const osl_int_t);
+void osl_int_div_exact_array(int, osl_int_t*, size_t, const osl_int_t);
+void osl_int_gcd_array(int, osl_int_t*, const osl_int_t*, size_t);
+
 /******************************************************************************
  *                            Conditional Operations                          *
  ******************************************************************************/
 
 int osl_int_eq(int, const osl_int_t, const osl_int_t);
 int osl_int_ne(int, const osl_int_t, const osl_int_t);
+int osl_int_eq_array(int, const osl_int_t*, const osl_int_t*, size_t);
 int osl_int_lt(int, const osl_int_t, const osl_int_t);
 int osl_int_le(int, const osl_int_t, const osl_int_t);
 int osl_int_gt(int, const osl_int_t, const osl_int_t);
@@ -163,6 +175,7 @@ int osl_int_zero(int, const osl_int_t);
 int osl_int_one(int, const osl_int_t);
 int osl_int_mone(int, const osl_int_t);
 int osl_int_divisible(int, const osl_int_t, const osl_int_t);
+uint64_t osl_int_hash(int, const osl_int_t);
 
 /******************************************************************************
  *                            Processing functions                            *
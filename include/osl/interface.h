@@ -62,6 +62,7 @@
 #define OSL_INTERFACE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <osl/attributes.h>
@@ -77,11 +78,15 @@ typedef void* (*osl_malloc_f)(void);
 typedef void (*osl_free_f)(void*);
 typedef void* (*osl_clone_f)(void*);
 typedef bool (*osl_equal_f)(void*, void*);
+typedef uint64_t (*osl_hash_f)(void*);
 
 /**
  * The osl_interface structure stores the URI and base
  * functions pointers an openscop object implementation has to offer. It
- * is a node in a NULL-terminated list of interfaces.
+ * is a node in a NULL-terminated list of interfaces. Interfaces of the
+ * frozen registry (see osl_interface_get_frozen_registry()) are shared
+ * by reference: cloning returns them as they are, freeing ignores them, and
+ * adding an interface to a list copies its frozen part first.
  */
 struct osl_interface {
   char* URI;                  /**< Unique identifier string */
@@ -92,6 +97,8 @@ struct osl_interface {
   osl_free_f free;            /**< Pointer to free function */
   osl_clone_f clone;          /**< Pointer to clone function */
   osl_equal_f equal;          /**< Pointer to equal function */
+  osl_hash_f hash;            /**< Pointer to hash function (or NULL) */
+  int frozen;                 /**< Rank + 1 in the frozen registry, or 0 */
   struct osl_interface* next; /**< Next interface in the list */
 };
 typedef struct osl_interface osl_interface_t;
@@ -127,6 +134,9 @@ bool osl_interface_equal(const osl_interface_t*, const osl_interface_t*);
 osl_interface_t* osl_interface_lookup(osl_interface_t*, const char*);
 osl_interface_t* osl_interface_get_default_registry(void)
     OSL_WARN_UNUSED_RESULT;
+osl_interface_t* osl_interface_get_frozen_registry(void);
+const char* osl_interface_atom(const char*);
+int osl_interface_is_atom(const char*);
 
 #if defined(__cplusplus)
 }
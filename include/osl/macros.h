@@ -83,6 +83,10 @@
 #define OSL_FMT_TXT_DP "%lld"
 #define OSL_FMT_TXT_MP "%s"
 
+#define OSL_CHECK_NONE 0    // No integrity check when reading.
+#define OSL_CHECK_FULL 1    // Integrity check of the scops once read.
+#define OSL_CHECK_INLINE 2  // Integrity check of each part when read.
+
 #define OSL_BACKEND_C 0
 #define OSL_BACKEND_FORTRAN 1
 #define OSL_UNDEFINED -1
@@ -149,18 +153,20 @@
 
 #define OSL_overflow(msg) OSL_error(msg)
 
-#define OSL_malloc(ptr, type, size)           \
-  do {                                        \
-    if (((ptr) = (type)malloc(size)) == NULL) \
-      OSL_error("memory overflow");           \
+#define OSL_malloc(ptr, type, size)                    \
+  do {                                                 \
+    if (((ptr) = (type)osl_util_malloc(size)) == NULL) \
+      OSL_error("memory overflow");                    \
   } while (0)
 
-#define OSL_realloc(ptr, type, size)                \
-  do {                                              \
-    if (((ptr) = (type)realloc(ptr, size)) == NULL) \
-      OSL_error("memory overflow");                 \
+#define OSL_realloc(ptr, type, size)                         \
+  do {                                                       \
+    if (((ptr) = (type)osl_util_realloc(ptr, size)) == NULL) \
+      OSL_error("memory overflow");                          \
   } while (0)
 
+#define OSL_free(ptr) osl_util_free(ptr)
+
 #define OSL_strdup(destination, source)                      \
   do {                                                       \
     if (source != NULL) {                                    \
@@ -86,11 +86,14 @@
  * - vector
  */
 
+#include <osl/access_index.h>
+#include <osl/arena.h>
 #include <osl/body.h>
 #include <osl/int.h>
 #include <osl/interface.h>
 #include <osl/macros.h>
 #include <osl/relation.h>
+#include <osl/relation_array.h>
 #include <osl/relation_list.h>
 #include <osl/strings.h>
 #include <osl/util.h>
@@ -73,6 +73,69 @@ extern "C" {
 #endif
 
 #define OSL_URI_RELATION "relation"
+#define OSL_RELATION_TABLE_SIZE 64         // Initial interning table size.
+#define OSL_RELATION_EMPTY_MAX_ROWS 4096   // Row limit of emptiness checks.
+#define OSL_RELATION_EMPTY_MAX_NODES 4096  // Branch and bound node limit.
+
+/**
+ * The osl_relation_sparse_t structure stores the constraint matrix of a
+ * relation union part in compressed sparse row (CSR) form: the non-zero
+ * elements of the row i are value[k], in column column[k], for
+ * row_start[i] <= k < row_start[i + 1]. Within a row, columns are sorted in
+ * increasing order and zero elements are never stored.
+ */
+struct osl_relation_sparse {
+  int nb_nonzeros;  /**< Number of stored (non-zero) elements */
+  int size;         /**< Allocated size of the column and value arrays */
+  int* row_start;   /**< Index of the first element of each row in column
+                         and value, row_start[nb_rows] == nb_nonzeros */
+  int* column;      /**< Column of each stored element */
+  osl_int_t* value; /**< Value of each stored element */
+};
+typedef struct osl_relation_sparse osl_relation_sparse_t;
+typedef struct osl_relation_sparse* osl_relation_sparse_p;
+
+/**
+ * The osl_relation_shared_t structure stores the bookkeeping of a relation
+ * matrix (dense or sparse) shared by several relation union parts, see
+ * osl_relation_intern(). The parts sharing the matrix point to the same m
+ * or sparse fields, which are released with the last part. A shared matrix
+ * is never modified in place: library functions duplicate it first (see
+ * osl_relation_unshare()), and code writing in m directly has to do so too.
+ * Reference counts are not atomic: relations sharing matrices must not be
+ * used by several threads without external synchronization.
+ */
+struct osl_relation_shared {
+  int refcount;                     /**< Number of parts sharing it */
+  uint64_t hash;                    /**< Hash of the matrix content */
+  int precision;                    /**< Precision of the elements */
+  int nb_rows;                      /**< Number of rows */
+  int nb_columns;                   /**< Number of columns */
+  osl_int_t** m;                    /**< Shared dense matrix (or NULL) */
+  osl_relation_sparse_t* sparse;    /**< Shared sparse matrix (or NULL) */
+  struct osl_relation_table* table; /**< Interning table (or NULL) */
+  struct osl_relation_shared* next; /**< Next entry in the table bucket */
+};
+typedef struct osl_relation_shared osl_relation_shared_t;
+typedef struct osl_relation_shared* osl_relation_shared_p;
+
+/**
+ * The osl_relation_table_t structure is an interning table of relation
+ * matrices: a hash table of shared matrices where identical matrices are
+ * stored only once (see osl_relation_intern()). Freeing the table does not
+ * free the matrices, which live as long as a relation part uses them.
+ */
+struct osl_relation_table {
+  size_t nb_buckets;             /**< Number of buckets (a power of 2) */
+  size_t nb_entries;             /**< Number of interned matrices */
+  osl_relation_shared_p* bucket; /**< Array of bucket lists */
+};
+typedef struct osl_relation_table osl_relation_table_t;
+typedef struct osl_relation_table* osl_relation_table_p;
+
+// Array of the parts of a relation union, see relation_array.h.
+typedef struct osl_relation_array osl_relation_array_t;
+typedef struct osl_relation_array* osl_relation_array_p;
 
 /**
  * The osl_relation_t structure stores a union of relations. It is a
@@ -98,22 +161,43 @@ extern "C" {
  * - An iteration domain : OSL_TYPE_DOMAIN,
  * - A scattering relation : OSL_TYPE_SCATTERING,
  * - An access relation : OSL_TYPE_ACCESS.
+ * Each union part stores its matrix either densely (m) or, optionally, in
+ * compressed sparse row form (sparse, then m is NULL), see
+ * osl_relation_to_sparse(). Library functions accept both layouts, but code
+ * accessing m directly has to call osl_relation_to_dense() first. The matrix
+ * may also be shared with other parts (see osl_relation_intern()), then
+ * code writing in m directly has to call osl_relation_unshare() first.
+ * Access parts may cache their array identifier on request (see
+ * osl_relation_cache_array_id()), which is trusted until the matrix is
+ * modified by the library, released or unshared.
+ * The first part of a union may own an array of its parts giving the number
+ * of parts and any part in constant time (see osl_relation_array_get()).
+ * Library functions keep it up to date, but code editing next fields
+ * directly has to call osl_relation_array_sync() afterwards.
  */
 struct osl_relation {
-  int type;                  /**< Semantics about the relation */
-  int precision;             /**< Precision of relation matrix elements*/
-  int nb_rows;               /**< Number of rows */
-  int nb_columns;            /**< Number of columns */
-  int nb_output_dims;        /**< Number of output dimensions */
-  int nb_input_dims;         /**< Number of input dimensions */
-  int nb_local_dims;         /**< Number of local (existentially
-                                  quantified) dimensions */
-  int nb_parameters;         /**< Number of parameters */
-  osl_int_t** m;             /**< An array of pointers to the beginning
-                                  of each row of the relation matrix */
-  void* usr;                 /**< User-managed field, untouched by osl */
-  struct osl_relation* next; /**< Pointer to the next relation in the
-                                  union of relations (NULL if none) */
+  int type;                     /**< Semantics about the relation */
+  int precision;                /**< Precision of relation matrix elements*/
+  int nb_rows;                  /**< Number of rows */
+  int nb_columns;               /**< Number of columns */
+  int nb_output_dims;           /**< Number of output dimensions */
+  int nb_input_dims;            /**< Number of input dimensions */
+  int nb_local_dims;            /**< Number of local (existentially
+                                     quantified) dimensions */
+  int nb_parameters;            /**< Number of parameters */
+  osl_int_t** m;                /**< An array of pointers to the beginning
+                                     of each row of the relation matrix */
+  osl_relation_sparse_p sparse; /**< Sparse (CSR) relation matrix, NULL
+                                     if the matrix is stored in m */
+  osl_relation_shared_p shared; /**< Sharing information, NULL if the
+                                     matrix is owned by this part only */
+  int array_id;                 /**< Cached array identifier of an access
+                                     part, 0 if not computed yet */
+  void* usr;                    /**< User-managed field, untouched by osl */
+  osl_relation_array_p parts;   /**< Array of the union parts, owned by
+                                     the first part (or NULL) */
+  struct osl_relation* next;    /**< Pointer to the next relation in the
+                                     union of relations (NULL if none) */
 };
 typedef struct osl_relation osl_relation_t;
 typedef struct osl_relation* osl_relation_p;
@@ -124,6 +208,10 @@ typedef struct osl_relation* osl_relation_p;
 
 void osl_relation_idump(FILE*, const osl_relation_t*, int) OSL_NONNULL_ARGS(1);
 void osl_relation_dump(FILE*, const osl_relation_t*) OSL_NONNULL_ARGS(1);
+void osl_relation_table_idump(FILE*, const osl_relation_table_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_relation_table_dump(FILE*, const osl_relation_table_t*)
+    OSL_NONNULL_ARGS(1);
 char* osl_relation_expression(const osl_relation_t*, int row,
                               char** names) OSL_NONNULL;
 char* osl_relation_spprint_polylib(const osl_relation_t*, const osl_names_t*);
@@ -156,6 +244,10 @@ osl_relation_t* osl_relation_psread_polylib(char**, int)
 osl_relation_t* osl_relation_sread(char**) OSL_NONNULL OSL_WARN_UNUSED_RESULT;
 osl_relation_t* osl_relation_sread_polylib(char**)
     OSL_NONNULL OSL_WARN_UNUSED_RESULT;
+osl_relation_t* osl_relation_pread_sparse(FILE*, int)
+    OSL_NONNULL OSL_WARN_UNUSED_RESULT;
+osl_relation_t* osl_relation_psread_sparse(char**, int)
+    OSL_NONNULL OSL_WARN_UNUSED_RESULT;
 
 /******************************************************************************
  *                    Memory allocation/deallocation function                 *
@@ -166,6 +258,8 @@ osl_relation_t* osl_relation_malloc(int, int) OSL_WARN_UNUSED_RESULT;
 osl_relation_t* osl_relation_interface_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_relation_free_inside(osl_relation_t*);
 void osl_relation_free(osl_relation_t*);
+osl_relation_table_t* osl_relation_table_malloc(void) OSL_WARN_UNUSED_RESULT;
+void osl_relation_table_free(osl_relation_table_t*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -178,6 +272,7 @@ osl_relation_t* osl_relation_clone_nconstraints(const osl_relation_t*,
                                                 int) OSL_WARN_UNUSED_RESULT;
 osl_relation_t* osl_relation_clone(const osl_relation_t*)
     OSL_WARN_UNUSED_RESULT;
+osl_relation_t* osl_relation_clone_cow(osl_relation_t*) OSL_WARN_UNUSED_RESULT;
 void osl_relation_add(osl_relation_t**, osl_relation_t*);
 void osl_relation_remove_part(osl_relation_t**, osl_relation_t*);
 osl_relation_t* osl_relation_union(osl_relation_t*,
@@ -197,26 +292,53 @@ void osl_relation_replace_constraints(osl_relation_t*, const osl_relation_t*,
 void osl_relation_insert_constraints(osl_relation_t*, const osl_relation_t*,
                                      int);
 void osl_relation_swap_constraints(osl_relation_t*, int, int);
+void osl_relation_row_gcd(const osl_relation_t*, int, osl_int_t*) OSL_NONNULL;
+void osl_relation_row_normalize(osl_relation_t*, int);
+void osl_relation_row_oppose(osl_relation_t*, int);
+void osl_relation_row_addmul(osl_relation_t*, int, int, const osl_int_t);
 void osl_relation_remove_row(osl_relation_t*, int);
 void osl_relation_remove_column(osl_relation_t*, int);
+void osl_relation_specialize_parameters(osl_relation_t*, const long*,
+                                        const int*);
+void osl_relation_eliminate_equalities(osl_relation_t*);
+int osl_relation_project_out(osl_relation_t*, int, int);
+int osl_relation_is_trivially_empty(const osl_relation_t*);
+int osl_relation_is_empty(const osl_relation_t*);
 void osl_relation_insert_columns(osl_relation_t*, const osl_relation_t*, int);
 osl_relation_t* osl_relation_concat_constraints(
     const osl_relation_t*, const osl_relation_t*) OSL_WARN_UNUSED_RESULT;
 bool osl_relation_part_equal(const osl_relation_t*, const osl_relation_t*);
 bool osl_relation_equal(const osl_relation_t*, const osl_relation_t*);
+uint64_t osl_relation_part_hash(const osl_relation_t*);
+uint64_t osl_relation_hash(const osl_relation_t*);
 int osl_relation_integrity_check(const osl_relation_t*, int, int, int, int);
 void osl_relation_set_attributes_one(osl_relation_t*, int, int, int, int);
 void osl_relation_set_attributes(osl_relation_t*, int, int, int, int);
 void osl_relation_set_type(osl_relation_t*, int);
 int osl_relation_get_array_id(const osl_relation_t*);
+void osl_relation_cache_array_id(osl_relation_t*);
 int osl_relation_is_access(const osl_relation_t*);
 void osl_relation_get_attributes(const osl_relation_t*, int*, int*, int*, int*,
                                  int*);
 osl_relation_t* osl_relation_extend_output(const osl_relation_t*,
                                            int) OSL_WARN_UNUSED_RESULT;
+void osl_relation_extend_output_inplace(osl_relation_t*, int);
 osl_interface_t* osl_relation_interface(void) OSL_WARN_UNUSED_RESULT;
 void osl_relation_set_precision(int const, osl_relation_t*);
 void osl_relation_set_same_precision(osl_relation_t*, osl_relation_t*);
+int osl_relation_is_sparse(const osl_relation_t*);
+void osl_relation_to_sparse(osl_relation_t*);
+void osl_relation_to_dense(osl_relation_t*);
+void osl_relation_get_value(const osl_relation_t*, int, int, osl_int_t*)
+    OSL_NONNULL;
+void osl_relation_set_value(osl_relation_t*, int, int, const osl_int_t)
+    OSL_NONNULL_ARGS(1);
+void osl_relation_intern(osl_relation_table_t*, osl_relation_t*)
+    OSL_NONNULL_ARGS(1);
+void osl_relation_share(osl_relation_t*);
+int osl_relation_is_shared(const osl_relation_t*);
+void osl_relation_unshare(osl_relation_t*);
+void osl_relation_canonicalize(osl_relation_t*);
 
 #if defined(__cplusplus)
 }
@@ -0,0 +1,134 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                             relation_array.h                             **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_RELATION_ARRAY_H
+#define OSL_RELATION_ARRAY_H
+
+#include <stdio.h>
+
+#include <osl/attributes.h>
+#include <osl/relation.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * The osl_relation_array_t structure stores the parts of a relation union
+ * in a contiguous array, with a cached number of parts, to provide random
+ * access to any part in constant time. It is owned by the first part of the
+ * union (its parts field, see osl_relation_array_get()) and does not own
+ * the parts, which are still linked through their next field
+ * (part[k]->next == part[k + 1]): the union remains a regular relation that
+ * any osl_relation_* function accepts. Library functions adding or removing
+ * union parts keep the array up to date; code editing next fields directly
+ * has to call osl_relation_array_sync() on the union afterwards.
+ */
+struct osl_relation_array {
+  int nb_parts;         /**< Number of union parts */
+  int size;             /**< Number of allocated slots in part */
+  osl_relation_p* part; /**< Union parts, in the union order */
+};
+
+/**
+ * Function called for each part of a relation array by
+ * osl_relation_array_parallel_for(): it receives the part, its rank in the
+ * union and the user data.
+ */
+typedef void (*osl_relation_array_f)(osl_relation_t*, int, void*);
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+void osl_relation_array_idump(FILE*, const osl_relation_array_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_relation_array_dump(FILE*, const osl_relation_array_t*)
+    OSL_NONNULL_ARGS(1);
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+osl_relation_array_t* osl_relation_array_malloc(void) OSL_WARN_UNUSED_RESULT;
+void osl_relation_array_free(osl_relation_array_t*);
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+int osl_relation_array_is_current(const osl_relation_t*);
+osl_relation_array_t* osl_relation_array_get(osl_relation_t*);
+osl_relation_array_t* osl_relation_array_sync(osl_relation_t*);
+osl_relation_t* osl_relation_array_head(const osl_relation_array_t*);
+int osl_relation_array_nb_parts(const osl_relation_array_t*);
+osl_relation_t* osl_relation_array_part(const osl_relation_array_t*, int);
+void osl_relation_array_add(osl_relation_array_t*, osl_relation_t*)
+    OSL_NONNULL_ARGS(1);
+osl_relation_t* osl_relation_array_remove(osl_relation_array_t*, int)
+    OSL_WARN_UNUSED_RESULT OSL_NONNULL_ARGS(1);
+void osl_relation_array_parallel_for(osl_relation_array_t*,
+                                     osl_relation_array_f, void*);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_RELATION_ARRAY_H */
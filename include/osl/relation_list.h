@@ -127,6 +127,8 @@ osl_relation_list_t* osl_relation_list_node(const osl_relation_t*)
     OSL_WARN_UNUSED_RESULT;
 osl_relation_list_t* osl_relation_list_clone(const osl_relation_list_t*)
     OSL_WARN_UNUSED_RESULT;
+osl_relation_list_t* osl_relation_list_clone_cow(osl_relation_list_t*)
+    OSL_WARN_UNUSED_RESULT;
 osl_relation_list_t* osl_relation_list_concat(const osl_relation_list_t*,
                                               const osl_relation_list_t*)
     OSL_WARN_UNUSED_RESULT;
@@ -137,6 +139,14 @@ osl_relation_list_t* osl_relation_list_pop(osl_relation_list_p*)
 void osl_relation_list_dup(osl_relation_list_t**);
 void osl_relation_list_drop(osl_relation_list_t**);
 void osl_relation_list_destroy(osl_relation_list_t**);
+uint64_t osl_relation_list_hash(const osl_relation_list_t*);
+void osl_relation_list_share(osl_relation_list_t*);
+void osl_relation_list_canonicalize(osl_relation_list_t*);
+void osl_relation_list_specialize_parameters(osl_relation_list_t*,
+                                             const long*, const int*);
+void osl_relation_list_eliminate_equalities(osl_relation_list_t*);
+void osl_relation_list_intern(osl_relation_table_t*, osl_relation_list_t*)
+    OSL_NONNULL_ARGS(1);
 int osl_relation_list_equal(const osl_relation_list_t*,
                             const osl_relation_list_t*);
 int osl_relation_list_integrity_check(const osl_relation_list_t*, int, int, int,
@@ -94,6 +94,27 @@ struct osl_statement {
 typedef struct osl_statement osl_statement_t;
 typedef struct osl_statement* osl_statement_p;
 
+/**
+ * The osl_statement_index_t structure indexes a list of statements, to get
+ * a statement from its label (its rank in the list, from 0) and the label
+ * of a statement from its address in constant time. It is bound to the
+ * list head it indexes (e.g., &scop->statement): statements appended to the
+ * list, e.g., with osl_statement_add(), are indexed at the next use of the
+ * index, and statements have to be removed through
+ * osl_statement_index_remove() to keep both in sync. Any other modification
+ * of the list requires to generate the index again.
+ */
+struct osl_statement_index {
+  osl_statement_p* list;      /**< Address of the indexed list head */
+  int nb_statements;          /**< Number of indexed statements */
+  int size;                   /**< Number of allocated slots in statement */
+  osl_statement_p* statement; /**< Indexed statements, by label */
+  size_t nb_slots;            /**< Size of slot (a power of 2) */
+  int* slot;                  /**< Hash table of labels, by address */
+};
+typedef struct osl_statement_index osl_statement_index_t;
+typedef struct osl_statement_index* osl_statement_index_p;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -104,6 +125,10 @@ void osl_statement_dump(FILE*, const osl_statement_t*) OSL_NONNULL_ARGS(1);
 void osl_statement_pprint(FILE*, const osl_statement_t*, const osl_names_t*)
     OSL_NONNULL_ARGS(1);
 void osl_statement_print(FILE*, const osl_statement_t*) OSL_NONNULL_ARGS(1);
+void osl_statement_index_idump(FILE*, const osl_statement_index_t*, int)
+    OSL_NONNULL_ARGS(1);
+void osl_statement_index_dump(FILE*, const osl_statement_index_t*)
+    OSL_NONNULL_ARGS(1);
 
 // SCoPLib Compatibility
 void osl_statement_pprint_scoplib(FILE*, const osl_statement_t*,
@@ -122,6 +147,7 @@ osl_statement_t* osl_statement_read(FILE*) OSL_NONNULL_ARGS(1);
 
 osl_statement_t* osl_statement_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_statement_free(osl_statement_t*);
+void osl_statement_index_free(osl_statement_index_t*);
 
 /******************************************************************************
  *                           Processing functions                             *
@@ -134,14 +160,33 @@ osl_statement_t* osl_statement_nclone(const osl_statement_t*,
                                       int) OSL_WARN_UNUSED_RESULT;
 osl_statement_t* osl_statement_clone(const osl_statement_t*)
     OSL_WARN_UNUSED_RESULT;
+osl_statement_t* osl_statement_clone_cow(osl_statement_t*)
+    OSL_WARN_UNUSED_RESULT;
 osl_statement_t* osl_statement_remove_unions(const osl_statement_t*)
     OSL_WARN_UNUSED_RESULT;
 int osl_statement_equal(const osl_statement_t*, const osl_statement_t*);
+uint64_t osl_statement_hash(const osl_statement_t*);
+void osl_statement_share(osl_statement_t*);
+void osl_statement_canonicalize(osl_statement_t*);
+void osl_statement_specialize_parameters(osl_statement_t*, const long*,
+                                         const int*);
+void osl_statement_eliminate_equalities(osl_statement_t*);
+void osl_statement_substitute_iterators(osl_statement_t*);
+void osl_statement_intern(osl_relation_table_t*, osl_statement_t*)
+    OSL_NONNULL_ARGS(1);
 int osl_statement_integrity_check(const osl_statement_t*, int);
 int osl_statement_get_nb_iterators(const osl_statement_t*);
 void osl_statement_get_attributes(const osl_statement_t*, int*, int*, int*,
                                   int*, int*);
 osl_body_t* osl_statement_get_body(const osl_statement_t*);
+osl_statement_index_t* osl_statement_index_generate(osl_statement_t**)
+    OSL_WARN_UNUSED_RESULT OSL_NONNULL_ARGS(1);
+osl_statement_t* osl_statement_index_get(osl_statement_index_t*, int);
+int osl_statement_index_label(osl_statement_index_t*, const osl_statement_t*);
+void osl_statement_index_add(osl_statement_index_t*, osl_statement_t*)
+    OSL_NONNULL_ARGS(1);
+osl_statement_t* osl_statement_index_remove(osl_statement_index_t*, int)
+    OSL_WARN_UNUSED_RESULT OSL_NONNULL_ARGS(1);
 #if defined(__cplusplus)
 }
 #endif
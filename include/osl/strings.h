@@ -74,10 +74,20 @@ extern "C" {
 
 /* The "strings" type is simply a NULL-terminated array of C character
  * strings, i.e. a char **. It is encapsulated into a structure to allow
- * its manipulation through a generic type.
+ * its manipulation through a generic type. The structure also caches the
+ * number of strings and the allocated capacity of the array, and may hold a
+ * hash index of the strings for osl_strings_find(). These fields are kept
+ * up to date by the osl_strings functions and trusted in constant time, as
+ * long as the array itself is not replaced: code replacing, adding or
+ * removing strings in the array directly has to call osl_strings_sync().
  */
 struct osl_strings {
-  char** string; /**< NULL-terminated array of character strings */
+  char** string;   /**< NULL-terminated array of character strings */
+  char** array;    /**< Array the cached fields refer to */
+  size_t size;     /**< Cached number of strings */
+  size_t capacity; /**< Number of allocated slots, NULL included */
+  size_t nb_slots; /**< Number of hash index slots, 0 if not indexed */
+  size_t* slot;    /**< Hash index slots: position + 1, 0 if empty */
 };
 typedef struct osl_strings osl_strings_t;
 typedef struct osl_strings* osl_strings_p;
@@ -117,7 +127,10 @@ osl_strings_t* osl_strings_clone(const osl_strings_t*) OSL_WARN_UNUSED_RESULT;
 void osl_strings_add(osl_strings_t*, char const* const) OSL_NONNULL;
 size_t osl_strings_find(const osl_strings_t*, char const* const) OSL_NONNULL;
 bool osl_strings_equal(const osl_strings_t*, const osl_strings_t*);
+uint64_t osl_strings_hash(const osl_strings_t*);
 size_t osl_strings_size(const osl_strings_t*);
+void osl_strings_sync(osl_strings_t*);
+void osl_strings_index_build(osl_strings_t*);
 osl_strings_t* osl_strings_encapsulate(char*) OSL_WARN_UNUSED_RESULT;
 osl_interface_t* osl_strings_interface(void) OSL_WARN_UNUSED_RESULT;
 osl_strings_t* osl_strings_generate(const char*,
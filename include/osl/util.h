@@ -61,12 +61,47 @@
 #ifndef OSL_UTIL_H
 #define OSL_UTIL_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
+/**
+ * Allocator hooks (see osl_set_allocator()): each hook receives the user
+ * pointer given to osl_set_allocator() as its last argument.
+ */
+typedef void* (*osl_util_malloc_f)(size_t, void*);
+typedef void* (*osl_util_realloc_f)(void*, size_t, void*);
+typedef void (*osl_util_free_f)(void*, void*);
+
+/**
+ * Loop body for osl_util_parallel_for(): it receives the user data and the
+ * iteration number.
+ */
+typedef void (*osl_util_loop_f)(void*, int);
+
+/**
+ * The osl_util_substitution_t structure prepares the substitution of a list
+ * of identifiers in expressions (see osl_util_substitution_apply()), to scan
+ * each expression once. The identifiers made of [A-Za-z0-9_] characters are
+ * hashed to be found from the tokens of the expressions, the (irregular)
+ * other ones are looked for at each token.
+ */
+struct osl_util_substitution {
+  int nb_identifiers; /**< Number of identifiers */
+  char** identifiers; /**< NULL-terminated array of identifiers (not owned) */
+  size_t* length;     /**< Lengths of the identifiers */
+  int nb_irregular;   /**< Number of irregular identifiers */
+  int* irregular;     /**< Ranks of the irregular identifiers, increasing */
+  size_t nb_slots;    /**< Size of slot (a power of 2) */
+  int* slot;          /**< Hash table of the other ranks + 1 (0: empty) */
+};
+typedef struct osl_util_substitution osl_util_substitution_t;
+typedef struct osl_util_substitution* osl_util_substitution_p;
+
 /******************************************************************************
  *                            Utility functions                               *
  ******************************************************************************/
@@ -83,9 +118,27 @@ char* osl_util_read_uptoendtag(FILE*, char**, const char*);
 char* osl_util_tag_content(const char*, const char*);
 void osl_util_safe_strcat(char**, const char*, size_t*);
 char* osl_util_strdup(char const*);
+void* osl_util_malloc(size_t);
+void* osl_util_realloc(void*, size_t);
+void osl_util_free(void*);
+void* osl_util_heap_malloc(size_t);
+void* osl_util_heap_realloc(void*, size_t);
+void osl_util_heap_free(void*);
+void osl_set_allocator(osl_util_malloc_f, osl_util_realloc_f, osl_util_free_f,
+                       void*);
 int osl_util_get_precision(void);
 void osl_util_print_provided(FILE*, int, const char*);
 char* osl_util_identifier_substitution(const char*, char**);
+osl_util_substitution_t* osl_util_substitution_generate(char**);
+void osl_util_substitution_free(osl_util_substitution_t*);
+char* osl_util_substitution_apply(const osl_util_substitution_t*, const char*,
+                                  size_t*);
+uint64_t osl_util_hash_combine(uint64_t, uint64_t);
+uint64_t osl_util_hash_string(uint64_t, const char*);
+void osl_util_set_nb_threads(int);
+int osl_util_get_nb_threads(void);
+int osl_util_is_parallel_supported(void);
+void osl_util_parallel_for(int, osl_util_loop_f, void*);
 
 #if defined(__cplusplus)
 }
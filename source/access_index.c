@@ -0,0 +1,374 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              access_index.c                              **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <osl/access_index.h>
+#include <osl/macros.h>
+#include <osl/relation.h>
+#include <osl/relation_list.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+#include <osl/util.h>
+
+static int osl_access_index_array_id(osl_relation_t*);
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_access_index_idump function:
+ * this function displays an osl_access_index_t structure (*index) into a
+ * file (file, possibly stdout) in a way that trends to be understandable.
+ * It includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The access index whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_access_index_idump(FILE* const file,
+                            const osl_access_index_t* const index,
+                            int level) {
+  int i, j;
+  size_t k;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (index != NULL) {
+    fprintf(file,
+            "+-- osl_access_index_t: %zu access(es), %zu without array "
+            "identifier\n",
+            index->nb_refs, index->nb_unindexed);
+
+    // One line per array: the number of accesses of each type.
+    for (i = 1; i <= index->max_array_id; i++) {
+      k = (size_t)i * OSL_ACCESS_INDEX_NB_TYPES;
+      if (index->start[k] == index->start[k + OSL_ACCESS_INDEX_NB_TYPES])
+        continue;
+      for (j = 0; j <= level; j++)
+        fprintf(file, "|\t");
+      fprintf(file, "Array %d: %zu read(s), %zu write(s), %zu may write(s)",
+              i, index->start[k + 2] - index->start[k + 1],
+              index->start[k + 3] - index->start[k + 2],
+              index->start[k + 4] - index->start[k + 3]);
+      if (index->start[k + 1] != index->start[k])
+        fprintf(file, ", %zu other access(es)",
+                index->start[k + 1] - index->start[k]);
+      fprintf(file, "\n");
+    }
+  } else {
+    fprintf(file, "+-- NULL access index\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_access_index_dump function:
+ * this function prints the content of an osl_access_index_t structure
+ * (*index) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The access index whose information has to be printed.
+ */
+void osl_access_index_dump(FILE* const file,
+                           const osl_access_index_t* const index) {
+  osl_access_index_idump(file, index, 0);
+}
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+/**
+ * osl_access_index_malloc function:
+ * this function allocates the memory space for an empty osl_access_index_t
+ * structure and sets its fields with default values. Then it returns a
+ * pointer to the allocated space.
+ * \return A pointer to an empty access index.
+ */
+osl_access_index_t* osl_access_index_malloc(void) {
+  int k;
+  osl_access_index_p index;
+
+  OSL_malloc(index, osl_access_index_p, sizeof(osl_access_index_t));
+  index->max_array_id = 0;
+  OSL_malloc(index->start, size_t*,
+             (OSL_ACCESS_INDEX_NB_TYPES + 1) * sizeof(size_t));
+  for (k = 0; k <= OSL_ACCESS_INDEX_NB_TYPES; k++)
+    index->start[k] = 0;
+  index->nb_refs = 0;
+  index->ref = NULL;
+  index->nb_unindexed = 0;
+
+  return index;
+}
+
+/**
+ * osl_access_index_free function:
+ * this function frees the allocated memory for an osl_access_index_t
+ * structure. The indexed statements and relations are not freed.
+ * \param[in,out] index The pointer to the access index to free.
+ */
+void osl_access_index_free(osl_access_index_t* index) {
+  if (index == NULL)
+    return;
+
+  OSL_free(index->start);
+  OSL_free(index->ref);
+  OSL_free(index);
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_access_index_array_id internal function:
+ * this function returns the array identifier of an access relation, after
+ * caching it into the relation, or OSL_UNDEFINED if the relation is not an
+ * access relation or if it has no regular array identifier.
+ * \param[in,out] access The access relation.
+ * \return The array identifier of the access relation or OSL_UNDEFINED.
+ */
+int osl_access_index_array_id(osl_relation_t* access) {
+  if ((access == NULL) || !osl_relation_is_access(access))
+    return OSL_UNDEFINED;
+
+  osl_relation_cache_array_id(access);
+  return osl_relation_get_array_id(access);
+}
+
+/**
+ * osl_access_index_generate function:
+ * this function builds the inverted index of the accesses of the statements
+ * of a scop (only the first scop of a list). The array identifiers of the
+ * access relations are cached along the way (see
+ * osl_relation_cache_array_id()). Accesses without a regular array
+ * identifier are only counted. The index has to be generated again when
+ * the accesses of the scop are modified.
+ * \param[in,out] scop The scop whose accesses have to be indexed.
+ * \return A newly allocated access index.
+ */
+osl_access_index_t* osl_access_index_generate(osl_scop_t* scop) {
+  int label, array_id;
+  int* ids = NULL;
+  size_t k, nb_slots, nb_accesses = 0, size = 0;
+  size_t* next;
+  osl_statement_p statement;
+  osl_relation_list_p list;
+  osl_access_index_p index = osl_access_index_malloc();
+
+  if (scop == NULL)
+    return index;
+
+  // First pass: find the identifier of each access, in the order of the
+  // next passes, and the greatest one to size the index.
+  for (statement = scop->statement; statement != NULL;
+       statement = statement->next) {
+    for (list = statement->access; list != NULL; list = list->next) {
+      array_id = osl_access_index_array_id(list->elt);
+      if (nb_accesses == size) {
+        size = (size == 0) ? 16 : 2 * size;
+        OSL_realloc(ids, int*, size * sizeof(int));
+      }
+      ids[nb_accesses++] = array_id;
+      if (array_id == OSL_UNDEFINED) {
+        index->nb_unindexed++;
+      } else {
+        index->max_array_id = OSL_max(index->max_array_id, array_id);
+        index->nb_refs++;
+      }
+    }
+  }
+
+  nb_slots = (size_t)(index->max_array_id + 1) * OSL_ACCESS_INDEX_NB_TYPES;
+  OSL_free(index->start);
+  OSL_malloc(index->start, size_t*, (nb_slots + 1) * sizeof(size_t));
+  for (k = 0; k <= nb_slots; k++)
+    index->start[k] = 0;
+  if (index->nb_refs == 0) {
+    OSL_free(ids);
+    return index;
+  }
+
+  // Second pass: count the accesses of each (array, type) pair.
+  nb_accesses = 0;
+  for (statement = scop->statement; statement != NULL;
+       statement = statement->next) {
+    for (list = statement->access; list != NULL; list = list->next) {
+      array_id = ids[nb_accesses++];
+      if (array_id != OSL_UNDEFINED) {
+        k = (size_t)array_id * OSL_ACCESS_INDEX_NB_TYPES +
+            (size_t)(list->elt->type - OSL_TYPE_ACCESS);
+        index->start[k + 1]++;
+      }
+    }
+  }
+  for (k = 0; k < nb_slots; k++)
+    index->start[k + 1] += index->start[k];
+
+  // Third pass: fill the references, in statement order for each pair.
+  OSL_malloc(index->ref, osl_access_ref_p,
+             index->nb_refs * sizeof(osl_access_ref_t));
+  OSL_malloc(next, size_t*, nb_slots * sizeof(size_t));
+  for (k = 0; k < nb_slots; k++)
+    next[k] = index->start[k];
+  label = 0;
+  nb_accesses = 0;
+  for (statement = scop->statement; statement != NULL;
+       statement = statement->next) {
+    for (list = statement->access; list != NULL; list = list->next) {
+      array_id = ids[nb_accesses++];
+      if (array_id != OSL_UNDEFINED) {
+        k = (size_t)array_id * OSL_ACCESS_INDEX_NB_TYPES +
+            (size_t)(list->elt->type - OSL_TYPE_ACCESS);
+        index->ref[next[k]].statement = statement;
+        index->ref[next[k]].label = label;
+        index->ref[next[k]].access = list->elt;
+        next[k]++;
+      }
+    }
+    label++;
+  }
+  OSL_free(next);
+  OSL_free(ids);
+
+  return index;
+}
+
+/**
+ * osl_access_index_lookup function:
+ * this function returns the number of accesses of a given type to a given
+ * array in an access index, in constant time. The references of these
+ * accesses, in statement order, are returned through refs (if not NULL).
+ * \param[in]  index    The access index.
+ * \param[in]  array_id The array identifier.
+ * \param[in]  type     The access type (e.g., OSL_TYPE_READ), or
+ *                      OSL_UNDEFINED for all the accesses to the array.
+ * \param[out] refs     Address of the first reference (NULL if none).
+ * \return The number of references.
+ */
+size_t osl_access_index_lookup(const osl_access_index_t* index, int array_id,
+                               int type, const osl_access_ref_t** refs) {
+  size_t k, first, last;
+
+  if ((type != OSL_UNDEFINED) &&
+      ((type < OSL_TYPE_ACCESS) || (type > OSL_TYPE_MAY_WRITE)))
+    OSL_error("unknown access type");
+
+  if ((index == NULL) || (array_id <= 0) ||
+      (array_id > index->max_array_id)) {
+    if (refs != NULL)
+      *refs = NULL;
+    return 0;
+  }
+
+  k = (size_t)array_id * OSL_ACCESS_INDEX_NB_TYPES;
+  if (type == OSL_UNDEFINED) {
+    first = index->start[k];
+    last = index->start[k + OSL_ACCESS_INDEX_NB_TYPES];
+  } else {
+    first = index->start[k + (size_t)(type - OSL_TYPE_ACCESS)];
+    last = index->start[k + (size_t)(type - OSL_TYPE_ACCESS) + 1];
+  }
+
+  if (refs != NULL)
+    *refs = (last > first) ? &index->ref[first] : NULL;
+  return last - first;
+}
+
+/**
+ * osl_access_index_writers function:
+ * this function returns the number of accesses that may write a given
+ * array (OSL_TYPE_WRITE and OSL_TYPE_MAY_WRITE accesses) in an access
+ * index, in constant time. The references of these accesses, writes first,
+ * are returned through refs (if not NULL).
+ * \param[in]  index    The access index.
+ * \param[in]  array_id The array identifier.
+ * \param[out] refs     Address of the first reference (NULL if none).
+ * \return The number of references.
+ */
+size_t osl_access_index_writers(const osl_access_index_t* index, int array_id,
+                                const osl_access_ref_t** refs) {
+  size_t k, first, last;
+
+  if ((index == NULL) || (array_id <= 0) ||
+      (array_id > index->max_array_id)) {
+    if (refs != NULL)
+      *refs = NULL;
+    return 0;
+  }
+
+  // Writes and may writes are contiguous in the index.
+  k = (size_t)array_id * OSL_ACCESS_INDEX_NB_TYPES;
+  first = index->start[k + (size_t)(OSL_TYPE_WRITE - OSL_TYPE_ACCESS)];
+  last = index->start[k + (size_t)(OSL_TYPE_MAY_WRITE - OSL_TYPE_ACCESS) + 1];
+
+  if (refs != NULL)
+    *refs = (last > first) ? &index->ref[first] : NULL;
+  return last - first;
+}
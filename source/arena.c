@@ -0,0 +1,376 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 arena.c                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/arena.h>
+#include <osl/macros.h>
+#include <osl/util.h>
+
+static size_t osl_arena_round(size_t);
+static osl_arena_chunk_p osl_arena_chunk_malloc(size_t);
+
+// List of the live arenas, used to find the owner of a memory block.
+static osl_arena_p osl_arena_list = NULL;
+
+// Number of live arenas (see osl_arena_nb_live in arena.h).
+size_t osl_arena_nb_live = 0;
+
+// Arena serving the allocations of the current thread (NULL for the heap).
+static _Thread_local osl_arena_p osl_arena_current = NULL;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_arena_idump function:
+ * this function displays an osl_arena_t structure (*arena) into a file
+ * (file, possibly stdout) in a way that trends to be understandable. It
+ * includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] arena The arena whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_arena_idump(FILE* const file, const osl_arena_t* const arena,
+                     int level) {
+  int j;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (arena != NULL) {
+    fprintf(file,
+            "+-- osl_arena_t: %zu chunk(s), %zu byte(s) allocated, "
+            "next chunk size %zu\n",
+            arena->nb_chunks, arena->allocated, arena->chunk_size);
+  } else {
+    fprintf(file, "+-- NULL arena\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_arena_dump function:
+ * this function prints the content of an osl_arena_t structure (*arena)
+ * into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] arena The arena whose information has to be printed.
+ */
+void osl_arena_dump(FILE* const file, const osl_arena_t* const arena) {
+  osl_arena_idump(file, arena, 0);
+}
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+/**
+ * osl_arena_round internal function:
+ * this function rounds a size up to the arena alignment.
+ * \param[in] size The size to round.
+ * \return The smallest multiple of OSL_ARENA_ALIGNMENT not smaller than size.
+ */
+size_t osl_arena_round(size_t size) {
+  return (size + OSL_ARENA_ALIGNMENT - 1) & ~(size_t)(OSL_ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * osl_arena_chunk_malloc internal function:
+ * this function allocates a new arena chunk able to store size bytes.
+ * \param[in] size The number of usable bytes in the chunk.
+ * \return A pointer to an empty chunk.
+ */
+osl_arena_chunk_p osl_arena_chunk_malloc(size_t size) {
+  osl_arena_chunk_p chunk;
+
+  chunk = (osl_arena_chunk_p)osl_util_heap_malloc(sizeof(osl_arena_chunk_t));
+  if (chunk == NULL)
+    OSL_error("memory overflow");
+  if ((chunk->memory = (char*)osl_util_heap_malloc(size)) == NULL)
+    OSL_error("memory overflow");
+  chunk->size = size;
+  chunk->used = 0;
+  chunk->next = NULL;
+
+  return chunk;
+}
+
+/**
+ * osl_arena_malloc function:
+ * this function allocates the memory space for an osl_arena_t structure,
+ * registers it as a live arena and returns a pointer to it. The arena gets
+ * its first chunk on its first allocation.
+ * \return A pointer to an empty arena.
+ */
+osl_arena_t* osl_arena_malloc(void) {
+  osl_arena_p arena;
+
+  arena = (osl_arena_p)osl_util_heap_malloc(sizeof(osl_arena_t));
+  if (arena == NULL)
+    OSL_error("memory overflow");
+  arena->chunk = NULL;
+  arena->chunk_size = OSL_ARENA_CHUNK_SIZE;
+  arena->nb_chunks = 0;
+  arena->allocated = 0;
+  arena->next = osl_arena_list;
+  osl_arena_list = arena;
+  osl_arena_nb_live++;
+
+  return arena;
+}
+
+/**
+ * osl_arena_free function:
+ * this function releases, at once, every block allocated in an arena, then
+ * the arena itself. The cost depends on the number of chunks only, not on
+ * the number of objects stored in the arena. Any pointer to a block of the
+ * arena becomes invalid. If the arena is the current one of the calling
+ * thread, the thread goes back to heap allocation. In multiple precision,
+ * the integer limbs of the objects of the arena are allocated by GMP on the
+ * heap and are NOT reclaimed: call osl_scop_free() (or the osl_*_free
+ * function of the objects) before, which releases only the heap parts.
+ * \param[in] arena The arena to release.
+ */
+void osl_arena_free(osl_arena_t* arena) {
+  osl_arena_p* link;
+  osl_arena_chunk_p chunk, next;
+
+  if (arena == NULL)
+    return;
+
+  for (link = &osl_arena_list; *link != NULL; link = &(*link)->next) {
+    if (*link == arena) {
+      *link = arena->next;
+      osl_arena_nb_live--;
+      break;
+    }
+  }
+
+  if (osl_arena_current == arena)
+    osl_arena_current = NULL;
+
+  for (chunk = arena->chunk; chunk != NULL; chunk = next) {
+    next = chunk->next;
+    osl_util_heap_free(chunk->memory);
+    osl_util_heap_free(chunk);
+  }
+  osl_util_heap_free(arena);
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_arena_alloc function:
+ * this function bump-allocates a block of a given size in an arena and
+ * returns a pointer to it. The block is aligned on OSL_ARENA_ALIGNMENT bytes
+ * and remembers its size, so that it can be resized with
+ * osl_arena_realloc(). When the current chunk is full, a new chunk is
+ * allocated, each chunk being twice as large as the previous one (up to
+ * OSL_ARENA_CHUNK_MAX_SIZE), or just large enough for a bigger block.
+ * \param[in,out] arena The arena where to allocate the block.
+ * \param[in]     size  The size of the block.
+ * \return A pointer to the allocated block.
+ */
+void* osl_arena_alloc(osl_arena_t* arena, size_t size) {
+  size_t needed = OSL_ARENA_ALIGNMENT + osl_arena_round(size);
+  size_t chunk_size;
+  osl_arena_chunk_p chunk = arena->chunk;
+  char* block;
+
+  if ((chunk == NULL) || (chunk->size - chunk->used < needed)) {
+    chunk_size = OSL_max(arena->chunk_size, needed);
+    chunk = osl_arena_chunk_malloc(chunk_size);
+    chunk->next = arena->chunk;
+    arena->chunk = chunk;
+    arena->nb_chunks++;
+    if (arena->chunk_size < OSL_ARENA_CHUNK_MAX_SIZE)
+      arena->chunk_size *= 2;
+  }
+
+  block = chunk->memory + chunk->used;
+  chunk->used += needed;
+  arena->allocated += needed;
+  *(size_t*)block = size;
+
+  return block + OSL_ARENA_ALIGNMENT;
+}
+
+/**
+ * osl_arena_realloc function:
+ * this function resizes a block of an arena. The block is grown or shrunk in
+ * place when it is the last block of the most recent chunk and there is room
+ * enough, otherwise a new block is allocated in the arena and the content is
+ * copied (the old block is only reclaimed when the arena is released).
+ * \param[in,out] arena The arena owning the block.
+ * \param[in]     ptr   The block to resize (NULL to allocate a new one).
+ * \param[in]     size  The new size of the block.
+ * \return A pointer to the resized block.
+ */
+void* osl_arena_realloc(osl_arena_t* arena, void* ptr, size_t size) {
+  char* block;
+  size_t old_size;
+  size_t old_needed, new_needed;
+  osl_arena_chunk_p chunk = arena->chunk;
+  void* resized;
+
+  if (ptr == NULL)
+    return osl_arena_alloc(arena, size);
+
+  block = (char*)ptr - OSL_ARENA_ALIGNMENT;
+  old_size = *(size_t*)block;
+  old_needed = OSL_ARENA_ALIGNMENT + osl_arena_round(old_size);
+  new_needed = OSL_ARENA_ALIGNMENT + osl_arena_round(size);
+
+  // The last block of the most recent chunk can move its end freely.
+  if ((chunk != NULL) && (block + old_needed == chunk->memory + chunk->used) &&
+      (chunk->used - old_needed + new_needed <= chunk->size)) {
+    chunk->used = chunk->used - old_needed + new_needed;
+    arena->allocated = arena->allocated - old_needed + new_needed;
+    *(size_t*)block = size;
+    return ptr;
+  }
+
+  resized = osl_arena_alloc(arena, size);
+  memcpy(resized, ptr, OSL_min(old_size, size));
+  return resized;
+}
+
+/**
+ * osl_arena_owns function:
+ * this function returns 1 if a pointer points inside one of the chunks of
+ * an arena, 0 otherwise.
+ * \param[in] arena The arena to check.
+ * \param[in] ptr   The pointer to check.
+ * \return 1 if ptr belongs to the arena, 0 otherwise.
+ */
+int osl_arena_owns(const osl_arena_t* arena, const void* ptr) {
+  const char* address = (const char*)ptr;
+  osl_arena_chunk_p chunk;
+
+  if ((arena == NULL) || (ptr == NULL))
+    return 0;
+
+  for (chunk = arena->chunk; chunk != NULL; chunk = chunk->next) {
+    if ((address >= chunk->memory) && (address < chunk->memory + chunk->used))
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * osl_arena_lookup function:
+ * this function returns the live arena owning a memory block, or NULL if
+ * the block does not belong to any arena (i.e., it is a heap block). Since
+ * chunk sizes grow geometrically, the cost is logarithmic in the size of
+ * each arena. The library allocator does not call it at all when no arena
+ * is alive (see osl_arena_nb_live).
+ * \param[in] ptr The pointer to a memory block.
+ * \return The arena owning ptr, or NULL.
+ */
+osl_arena_t* osl_arena_lookup(const void* ptr) {
+  osl_arena_p arena;
+
+  for (arena = osl_arena_list; arena != NULL; arena = arena->next) {
+    if (osl_arena_owns(arena, ptr))
+      return arena;
+  }
+
+  return NULL;
+}
+
+/**
+ * osl_arena_set_current function:
+ * this function sets the arena serving the library allocations of the
+ * calling thread (NULL to go back to heap allocation) and returns the
+ * previous one, so that calls can be nested:
+ *   osl_arena_p previous = osl_arena_set_current(arena);
+ *   scop = osl_scop_read(file);
+ *   osl_arena_set_current(previous);
+ * In multiple precision, the integer limbs allocated meanwhile still come
+ * from the heap (see osl_arena_free()).
+ * \param[in] arena The new current arena (possibly NULL).
+ * \return The previous current arena (possibly NULL).
+ */
+osl_arena_t* osl_arena_set_current(osl_arena_t* arena) {
+  osl_arena_p previous = osl_arena_current;
+
+  osl_arena_current = arena;
+  return previous;
+}
+
+/**
+ * osl_arena_get_current function:
+ * this function returns the arena serving the library allocations of the
+ * calling thread, or NULL if they go to the heap.
+ * \return The current arena (possibly NULL).
+ */
+osl_arena_t* osl_arena_get_current(void) { return osl_arena_current; }
@@ -204,14 +204,14 @@ char* osl_body_sprint(const osl_body_t* const body) {
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
       iterators = osl_strings_sprint(body->iterators);
       osl_util_safe_strcat(&string, iterators, &high_water_mark);
-      free(iterators);
+      OSL_free(iterators);
     }
 
     sprintf(buffer, "# Statement body expression\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     expression = osl_strings_sprint(body->expression);
     osl_util_safe_strcat(&string, expression, &high_water_mark);
-    free(expression);
+    OSL_free(expression);
   } else {
     sprintf(buffer, "# NULL body\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
@@ -295,7 +295,7 @@ void osl_body_free(osl_body_t* body) {
   if (body != NULL) {
     osl_strings_free(body->iterators);
     osl_strings_free(body->expression);
-    free(body);
+    OSL_free(body);
   }
 }
 
@@ -354,6 +354,22 @@ bool osl_body_equal(const osl_body_t* const b1, const osl_body_t* const b2) {
   return 1;
 }
 
+/**
+ * osl_body_hash function:
+ * this function returns a 64-bit hash of the content of an osl_body_t
+ * structure. Two bodies that are equal according to osl_body_equal() have
+ * the same hash.
+ * \param[in] body The body structure to hash (possibly NULL).
+ * \return The hash of the body structure.
+ */
+uint64_t osl_body_hash(const osl_body_t* const body) {
+  if (body == NULL)
+    return osl_util_hash_combine(0, 0);
+
+  return osl_util_hash_combine(osl_strings_hash(body->iterators),
+                               osl_strings_hash(body->expression));
+}
+
 /**
  * osl_body_interface function:
  * this function creates an interface structure corresponding to the body
@@ -371,6 +387,7 @@ osl_interface_t* osl_body_interface(void) {
   interface->free = (osl_free_f)osl_body_free;
   interface->clone = (osl_clone_f)osl_body_clone;
   interface->equal = (osl_equal_f)osl_body_equal;
+  interface->hash = (osl_hash_f)osl_body_hash;
 
   return interface;
 }
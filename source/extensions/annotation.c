@@ -85,11 +85,11 @@ int osl_annotation_text_append(osl_annotation_text_t* text, int line_type,
                                char* line) {
   const size_t count = text->count + 1;
 
-  char** lines = realloc(text->lines, count * sizeof *lines);
+  char** lines = osl_util_realloc(text->lines, count * sizeof *lines);
   if (!lines)
     return 1;
 
-  int* types = realloc(text->types, count * sizeof *types);
+  int* types = osl_util_realloc(text->types, count * sizeof *types);
   if (!types)
     return 1;
 
@@ -120,7 +120,7 @@ osl_annotation_text_t osl_annotation_text_clone(
       .lines = 0,
   };
   for (size_t i = 0; i < source->count; ++i) {
-    char* line = strdup(source->lines[i]);
+    char* line = osl_util_strdup(source->lines[i]);
     osl_annotation_text_append(&destination, source->types[i], line);
   }
   return destination;
@@ -136,12 +136,12 @@ void osl_annotation_text_clean(osl_annotation_text_t* text) {
   if (text->lines) {
     for (size_t i = 0; i < text->count; ++i) {
       if (text->lines[i])
-        free(text->lines[i]);
+        OSL_free(text->lines[i]);
     }
-    free(text->lines);
+    OSL_free(text->lines);
   }
   if (text->types) {
-    free(text->types);
+    OSL_free(text->types);
   }
 }
 
@@ -278,7 +278,7 @@ osl_annotation_t* osl_annotation_sread(char** input) {
  ******************************************************************************/
 
 osl_annotation_t* osl_annotation_malloc(void) {
-  osl_annotation_t* const annotation = malloc(sizeof *annotation);
+  osl_annotation_t* const annotation = osl_util_malloc(sizeof *annotation);
   if (!annotation) {
     fprintf(stderr, "[osl] Error: memory overflow (%s).\n", __func__);
     exit(1);
@@ -293,7 +293,7 @@ osl_annotation_t* osl_annotation_malloc(void) {
 void osl_annotation_free(osl_annotation_t* annotation) {
   osl_annotation_text_clean(&annotation->prefix);
   osl_annotation_text_clean(&annotation->suffix);
-  free(annotation);
+  OSL_free(annotation);
 }
 
 /*****************************************************************************
@@ -70,6 +70,9 @@
 
 #include <osl/extensions/arrays.h>
 
+static void osl_arrays_index_insert(osl_arrays_t*, int);
+static void osl_arrays_index_update(const osl_arrays_t*);
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -214,6 +217,7 @@ osl_arrays_t* osl_arrays_sread(char** input) {
     // Get the array name string.
     arrays->names[k] = osl_util_read_string(NULL, input);
   }
+  arrays->size = nb_names;
 
   return arrays;
 }
@@ -237,6 +241,11 @@ osl_arrays_t* osl_arrays_malloc(void) {
   arrays->nb_names = 0;
   arrays->id = NULL;
   arrays->names = NULL;
+  arrays->size = 0;
+  arrays->nb_indexed = 0;
+  arrays->nb_slots = 0;
+  arrays->id_slot = NULL;
+  arrays->name_slot = NULL;
 
   return arrays;
 }
@@ -250,11 +259,13 @@ void osl_arrays_free(osl_arrays_t* const arrays) {
   int i;
 
   if (arrays != NULL) {
-    free(arrays->id);
+    OSL_free(arrays->id);
     for (i = 0; i < arrays->nb_names; i++)
-      free(arrays->names[i]);
-    free(arrays->names);
-    free(arrays);
+      OSL_free(arrays->names[i]);
+    OSL_free(arrays->names);
+    OSL_free(arrays->id_slot);
+    OSL_free(arrays->name_slot);
+    OSL_free(arrays);
   }
 }
 
@@ -285,6 +296,10 @@ osl_arrays_t* osl_arrays_clone(const osl_arrays_t* const arrays) {
     clone->id[i] = arrays->id[i];
     OSL_strdup(clone->names[i], arrays->names[i]);
   }
+  clone->size = arrays->nb_names;
+
+  if (arrays->nb_slots > 0)
+    osl_arrays_index_build(clone);
 
   return clone;
 }
@@ -336,6 +351,27 @@ bool osl_arrays_equal(const osl_arrays_t* const a1,
   return 1;
 }
 
+/**
+ * osl_arrays_hash function:
+ * this function returns a 64-bit hash of the content of an arrays structure.
+ * As osl_arrays_equal(), it does not depend on the order of the names.
+ * \param[in] arrays The arrays structure to hash (possibly NULL).
+ * \return The hash of the arrays structure.
+ */
+uint64_t osl_arrays_hash(const osl_arrays_t* const arrays) {
+  uint64_t sum = 0;
+  int i;
+
+  if (arrays == NULL)
+    return osl_util_hash_combine(0, 0);
+
+  // Summing the per-name hashes makes the result order-independent.
+  for (i = 0; i < arrays->nb_names; i++)
+    sum += osl_util_hash_string((uint64_t)arrays->id[i], arrays->names[i]);
+
+  return osl_util_hash_combine((uint64_t)arrays->nb_names + 1, sum);
+}
+
 /**
  * osl_arrays_to_strings function:
  * this function creates a strings structure containing the textual names
@@ -363,16 +399,19 @@ osl_strings_t* osl_arrays_to_strings(const osl_arrays_t* const arrays) {
   // Build a strings structure for this number of ids.
   strings = osl_strings_generate("Dummy", max_id);
   for (i = 0; i < arrays->nb_names; i++) {
-    free(strings->string[arrays->id[i] - 1]);
+    OSL_free(strings->string[arrays->id[i] - 1]);
     OSL_strdup(strings->string[arrays->id[i] - 1], arrays->names[i]);
   }
+  osl_strings_sync(strings);
 
   return strings;
 }
 
 /**
  * osl_arrays_add function:
- * this function adds a new variable at the end of osl_array
+ * this function adds a new variable at the end of osl_array. The arrays
+ * grow geometrically, and the hash maps (if any, see
+ * osl_arrays_index_build()) are updated with each new name.
  *
  * \param[in] arrays The arrays structure to modify.
  * \param[in] id     The new variable's id.
@@ -383,41 +422,76 @@ int osl_arrays_add(osl_arrays_t* const arrays, int id, const char* const name) {
   if (arrays == NULL || name == NULL)
     return -1;
 
-  OSL_realloc(arrays->id, int*, (size_t)(arrays->nb_names + 1) * sizeof(int));
-  OSL_realloc(arrays->names, char**,
-              (size_t)(arrays->nb_names + 1) * sizeof(char*));
+  if (arrays->nb_names >= arrays->size) {
+    arrays->size = OSL_max(2 * arrays->size, arrays->nb_names + 1);
+    OSL_realloc(arrays->id, int*, (size_t)arrays->size * sizeof(int));
+    OSL_realloc(arrays->names, char**, (size_t)arrays->size * sizeof(char*));
+  }
   arrays->id[arrays->nb_names] = id;
   OSL_strdup(arrays->names[arrays->nb_names], name);
   arrays->nb_names++;
 
+  // Keep the hash maps (if any) at most half full.
+  if ((arrays->nb_slots > 0) &&
+      (arrays->nb_indexed == arrays->nb_names - 1)) {
+    if (2 * arrays->nb_names <= arrays->nb_slots) {
+      osl_arrays_index_insert(arrays, arrays->nb_names - 1);
+      arrays->nb_indexed++;
+    } else {
+      osl_arrays_index_build(arrays);
+    }
+  }
+
   return arrays->nb_names;
 }
 
+/**
+ * osl_arrays_index_update internal function:
+ * this function builds the hash maps of an arrays structure if it is not
+ * indexed yet. The maps are a cache, hence they may be built from a const
+ * structure.
+ * \param[in] arrays The arrays structure to index.
+ */
+static void osl_arrays_index_update(const osl_arrays_t* const arrays) {
+  if ((arrays->nb_slots == 0) || (arrays->nb_indexed != arrays->nb_names))
+    osl_arrays_index_build((osl_arrays_t*)(uintptr_t)arrays);
+}
+
 /**
  * osl_arrays_get_index_from_id function:
- * this function the index of a variable given its identifier
+ * this function the index of a variable given its identifier (the first one
+ * if several variables have this identifier). It uses the identifier hash
+ * map, which is built on the first lookup if the structure is not indexed
+ * yet (see osl_arrays_index_build()), hence it takes constant time on
+ * average.
  *
  * \param[in] arrays The arrays structure to modify.
  * \param[in] id     The variable's id.
  * \return index of the variable, array->nb_names means error
  */
 size_t osl_arrays_get_index_from_id(const osl_arrays_t* const arrays, int id) {
-  size_t i = 0;
+  int i, mask;
 
   if (arrays == NULL)
     return 0;
 
-  for (i = 0; i < (size_t)arrays->nb_names; i++) {
-    if (arrays->id[i] == id)
-      break;
-  }
+  osl_arrays_index_update(arrays);
+
+  mask = arrays->nb_slots - 1;
+  i = (int)(osl_util_hash_combine(0, (uint64_t)id) & (uint64_t)mask);
+  for (; arrays->id_slot[i] != 0; i = (i + 1) & mask)
+    if (arrays->id[arrays->id_slot[i] - 1] == id)
+      return (size_t)(arrays->id_slot[i] - 1);
 
-  return i < (size_t)arrays->nb_names ? i : (size_t)arrays->nb_names;
+  return (size_t)arrays->nb_names;
 }
 
 /**
  * osl_arrays_get_index_from_name function:
- * this function the index of a variable given its name
+ * this function the index of a variable given its name (the first one if
+ * several variables have this name). It uses the name hash map, which is
+ * built on the first lookup if the structure is not indexed yet (see
+ * osl_arrays_index_build()), hence it takes constant time on average.
  *
  * \param[in] arrays The arrays structure to modify.
  * \param[in] name     The variable's name.
@@ -425,18 +499,55 @@ size_t osl_arrays_get_index_from_id(const osl_arrays_t* const arrays, int id) {
  */
 size_t osl_arrays_get_index_from_name(const osl_arrays_t* const arrays,
                                       const char* const name) {
-  size_t i = 0;
+  int i, mask;
 
   if (arrays == NULL || name == NULL)
     return 0;
 
-  for (i = 0; i < (size_t)arrays->nb_names; i++) {
-    if (!strcmp(arrays->names[i], name))
-      break;
+  osl_arrays_index_update(arrays);
+
+  mask = arrays->nb_slots - 1;
+  i = (int)(osl_util_hash_string(0, name) & (uint64_t)mask);
+  for (; arrays->name_slot[i] != 0; i = (i + 1) & mask)
+    if (!strcmp(arrays->names[arrays->name_slot[i] - 1], name))
+      return (size_t)(arrays->name_slot[i] - 1);
+
+  return (size_t)arrays->nb_names;
+}
+
+/**
+ * osl_arrays_index_build function:
+ * this function builds (or rebuilds) the identifier and name hash maps of
+ * an arrays structure, so that osl_arrays_get_index_from_id() and
+ * osl_arrays_get_index_from_name() take constant time on average. Lookups
+ * call it when the structure is not indexed yet, the maps are then kept up
+ * to date by osl_arrays_add() and copied by osl_arrays_clone(). Lookups
+ * trust the maps: this function has to be called again after names or
+ * identifiers are modified directly.
+ * \param[in,out] arrays The arrays structure to index.
+ */
+void osl_arrays_index_build(osl_arrays_t* const arrays) {
+  int i;
+
+  if (arrays == NULL)
+    return;
+
+  OSL_free(arrays->id_slot);
+  OSL_free(arrays->name_slot);
+  arrays->nb_slots = 32;
+  while (arrays->nb_slots < 2 * arrays->nb_names)
+    arrays->nb_slots *= 2;
+  OSL_malloc(arrays->id_slot, int*, (size_t)arrays->nb_slots * sizeof(int));
+  OSL_malloc(arrays->name_slot, int*,
+             (size_t)arrays->nb_slots * sizeof(int));
+  for (i = 0; i < arrays->nb_slots; i++) {
+    arrays->id_slot[i] = 0;
+    arrays->name_slot[i] = 0;
   }
 
-  return i < (size_t)arrays->nb_names ? i : (size_t)arrays->nb_names;
-  ;
+  for (i = 0; i < arrays->nb_names; i++)
+    osl_arrays_index_insert(arrays, i);
+  arrays->nb_indexed = arrays->nb_names;
 }
 
 /**
@@ -456,6 +567,31 @@ osl_interface_t* osl_arrays_interface(void) {
   interface->free = (osl_free_f)osl_arrays_free;
   interface->clone = (osl_clone_f)osl_arrays_clone;
   interface->equal = (osl_equal_f)osl_arrays_equal;
+  interface->hash = (osl_hash_f)osl_arrays_hash;
 
   return interface;
 }
+
+/**
+ * osl_arrays_index_insert internal function:
+ * this function inserts the name at a given index into the identifier and
+ * name hash maps of an arrays structure. The hash maps must have free
+ * slots.
+ * \param[in,out] arrays The arrays structure.
+ * \param[in]     index  The index of the name to insert.
+ */
+void osl_arrays_index_insert(osl_arrays_t* const arrays, int index) {
+  int mask = arrays->nb_slots - 1;
+  int i;
+
+  i = (int)(osl_util_hash_combine(0, (uint64_t)arrays->id[index]) &
+            (uint64_t)mask);
+  while (arrays->id_slot[i] != 0)
+    i = (i + 1) & mask;
+  arrays->id_slot[i] = index + 1;
+
+  i = (int)(osl_util_hash_string(0, arrays->names[index]) & (uint64_t)mask);
+  while (arrays->name_slot[i] != 0)
+    i = (i + 1) & mask;
+  arrays->name_slot[i] = index + 1;
+}
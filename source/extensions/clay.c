@@ -107,7 +107,7 @@ void osl_clay_idump(FILE* const file, const osl_clay_t* const clay, int level) {
       if (tmp[l] == '\n')
         tmp[l] = ' ';
     fprintf(file, "script: %s\n", tmp);
-    free(tmp);
+    OSL_free(tmp);
   }
 
   // The last line.
@@ -226,8 +226,8 @@ osl_clay_t* osl_clay_malloc(void) {
 void osl_clay_free(osl_clay_t* clay) {
   if (clay != NULL) {
     if (clay->script != NULL)
-      free(clay->script);
-    free(clay);
+      OSL_free(clay->script);
+    OSL_free(clay);
   }
 }
 
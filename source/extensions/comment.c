@@ -108,7 +108,7 @@ void osl_comment_idump(FILE* const file, const osl_comment_t* const comment,
       if (tmp[l] == '\n')
         tmp[l] = ' ';
     fprintf(file, "comment: %s\n", tmp);
-    free(tmp);
+    OSL_free(tmp);
   }
 
   // The last line.
@@ -220,8 +220,8 @@ osl_comment_t* osl_comment_malloc(void) {
 void osl_comment_free(osl_comment_t* comment) {
   if (comment != NULL) {
     if (comment->comment != NULL)
-      free(comment->comment);
-    free(comment);
+      OSL_free(comment->comment);
+    OSL_free(comment);
   }
 }
 
@@ -276,6 +276,18 @@ bool osl_comment_equal(const osl_comment_t* const c1,
   return 1;
 }
 
+/**
+ * osl_comment_hash function:
+ * this function returns a 64-bit hash of an osl_comment_t structure. Since
+ * osl_comment_equal() does not compare the comment texts, the hash only
+ * depends on whether the structure is NULL or not.
+ * \param[in] comment The comment structure to hash (possibly NULL).
+ * \return The hash of the comment structure.
+ */
+uint64_t osl_comment_hash(const osl_comment_t* const comment) {
+  return osl_util_hash_combine(0, (comment != NULL) ? 1 : 0);
+}
+
 /**
  * osl_comment_interface function:
  * this function creates an interface structure corresponding to the comment
@@ -293,6 +305,7 @@ osl_interface_t* osl_comment_interface(void) {
   interface->free = (osl_free_f)osl_comment_free;
   interface->clone = (osl_clone_f)osl_comment_clone;
   interface->equal = (osl_equal_f)osl_comment_equal;
+  interface->hash = (osl_hash_f)osl_comment_hash;
 
   return interface;
 }
@@ -254,8 +254,8 @@ osl_coordinates_t* osl_coordinates_malloc(void) {
  */
 void osl_coordinates_free(osl_coordinates_t* const coordinates) {
   if (coordinates != NULL) {
-    free(coordinates->name);
-    free(coordinates);
+    OSL_free(coordinates->name);
+    OSL_free(coordinates);
   }
 }
 
@@ -237,7 +237,7 @@ void osl_dependence_print(FILE* const file,
                           const osl_dependence_t* const dependence) {
   char* string = osl_dependence_sprint(dependence);
   fprintf(file, "%s\n", string);
-  free(string);
+  OSL_free(string);
 }
 
 /**
@@ -321,7 +321,7 @@ char* osl_dependence_sprint(const osl_dependence_t* const dependence) {
       /* Output dependence domain. */
       pbuffer = osl_relation_sprint(tmp->domain);
       osl_util_safe_strcat(&buffer, pbuffer, &buffer_size);
-      free(pbuffer);
+      OSL_free(pbuffer);
     }
   }
 
@@ -349,7 +349,7 @@ static osl_dependence_p osl_dependence_read_one_dep(char** input,
     dep->type = OSL_DEPENDENCE_WAW;
   else if (!strcmp(buffer, "RAW_SCALPRIV"))
     dep->type = OSL_DEPENDENCE_RAW_SCALPRIV;
-  free(buffer);
+  OSL_free(buffer);
 
   /* # From source statement xxx */
   dep->label_source = osl_util_read_int(NULL, input);
@@ -493,7 +493,7 @@ void osl_dependence_free(osl_dependence_t* dependence) {
   while (dependence != NULL) {
     next = dependence->next;
     osl_relation_free(dependence->domain);
-    free(dependence);
+    OSL_free(dependence);
     dependence = next;
   }
 }
@@ -656,6 +656,83 @@ int osl_nb_dependences(const osl_dependence_t* deps) {
   return num;
 }
 
+/**
+ * osl_dependence_prune_empty function:
+ * this function removes from a dependence list, and frees, the dependences
+ * whose dependence polyhedron contains no integer point (see
+ * osl_relation_is_empty()). Dependences without a polyhedron are kept. It
+ * returns the number of removed dependences.
+ * \param[in,out] deps Pointer to the first dependence of the list.
+ * \return The number of removed dependences.
+ */
+int osl_dependence_prune_empty(osl_dependence_t** deps) {
+  int nb_removed = 0;
+  osl_dependence_p dep;
+
+  while (*deps != NULL) {
+    if (!osl_relation_is_empty((*deps)->domain)) {
+      deps = &(*deps)->next;
+      continue;
+    }
+    dep = *deps;
+    *deps = dep->next;
+    dep->next = NULL;
+    osl_dependence_free(dep);
+    nb_removed++;
+  }
+
+  return nb_removed;
+}
+
+/**
+ * osl_dependence_resolve function:
+ * this function sets the statement and access pointers of a list of
+ * dependences (stmt_source_ptr, stmt_target_ptr, ref_source_access_ptr and
+ * ref_target_access_ptr) from their labels and reference positions, using
+ * a statement index of the scop to find each statement in constant time
+ * (see osl_statement_index_generate()). The pointers of the dependences
+ * that cannot be resolved are set to NULL.
+ * \param[in,out] dependence The list of dependences to resolve.
+ * \param[in]     index      The statement index of the scop.
+ * \return The number of dependences that could not be fully resolved.
+ */
+int osl_dependence_resolve(osl_dependence_t* dependence,
+                           osl_statement_index_t* index) {
+  int i, nb_unresolved = 0;
+  osl_relation_list_p access;
+
+  for (; dependence != NULL; dependence = dependence->next) {
+    dependence->stmt_source_ptr =
+        osl_statement_index_get(index, dependence->label_source);
+    dependence->stmt_target_ptr =
+        osl_statement_index_get(index, dependence->label_target);
+
+    dependence->ref_source_access_ptr = NULL;
+    if (dependence->stmt_source_ptr != NULL) {
+      access = dependence->stmt_source_ptr->access;
+      for (i = 0; (access != NULL) && (i < dependence->ref_source); i++)
+        access = access->next;
+      if ((access != NULL) && (dependence->ref_source >= 0))
+        dependence->ref_source_access_ptr = access->elt;
+    }
+
+    dependence->ref_target_access_ptr = NULL;
+    if (dependence->stmt_target_ptr != NULL) {
+      access = dependence->stmt_target_ptr->access;
+      for (i = 0; (access != NULL) && (i < dependence->ref_target); i++)
+        access = access->next;
+      if ((access != NULL) && (dependence->ref_target >= 0))
+        dependence->ref_target_access_ptr = access->elt;
+    }
+
+    if ((dependence->ref_source_access_ptr == NULL) ||
+        (dependence->ref_target_access_ptr == NULL))
+      nb_unresolved++;
+  }
+
+  return nb_unresolved;
+}
+
 /**
  * osl_dependence_interface function:
  * this function creates an interface structure corresponding to the dependence
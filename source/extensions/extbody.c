@@ -170,7 +170,7 @@ char* osl_extbody_sprint(const osl_extbody_t* const ebody) {
 
     body_string = osl_body_sprint(ebody->body);
     osl_util_safe_strcat(&string, body_string, &high_water_mark);
-    free(body_string);
+    OSL_free(body_string);
   }
 
   return string;
@@ -259,10 +259,10 @@ osl_extbody_t* osl_extbody_malloc(void) {
  */
 void osl_extbody_free(osl_extbody_t* ebody) {
   if (ebody != NULL) {
-    free(ebody->start);
-    free(ebody->length);
+    OSL_free(ebody->start);
+    OSL_free(ebody->length);
     osl_body_free(ebody->body);
-    free(ebody);
+    OSL_free(ebody);
   }
 }
 
@@ -346,6 +346,30 @@ bool osl_extbody_equal(const osl_extbody_t* const e1,
   return osl_body_equal(e1->body, e2->body);
 }
 
+/**
+ * osl_extbody_hash function:
+ * this function returns a 64-bit hash of the content of an extbody
+ * structure. As osl_extbody_equal(), it does not depend on the order of the
+ * start/length pairs.
+ * \param[in] ebody The extbody structure to hash (possibly NULL).
+ * \return The hash of the extbody structure.
+ */
+uint64_t osl_extbody_hash(const osl_extbody_t* const ebody) {
+  uint64_t sum = 0;
+  size_t i;
+
+  if (ebody == NULL)
+    return osl_util_hash_combine(0, 0);
+
+  // Summing the per-access hashes makes the result order-independent.
+  for (i = 0; i < ebody->nb_access; i++)
+    sum += osl_util_hash_combine((uint64_t)ebody->start[i],
+                                 (uint64_t)ebody->length[i]);
+
+  return osl_util_hash_combine(osl_body_hash(ebody->body),
+                               osl_util_hash_combine(ebody->nb_access, sum));
+}
+
 /**
  * osl_extbody_interface function:
  * this function creates an interface structure corresponding to the
@@ -363,6 +387,7 @@ osl_interface_t* osl_extbody_interface(void) {
   interface->free = (osl_free_f)osl_extbody_free;
   interface->clone = (osl_clone_f)osl_extbody_clone;
   interface->equal = (osl_equal_f)osl_extbody_equal;
+  interface->hash = (osl_hash_f)osl_extbody_hash;
 
   return interface;
 }
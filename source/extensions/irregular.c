@@ -240,7 +240,7 @@ char* osl_irregular_sprint(const osl_irregular_t* const irregular) {
 
     // Keep only the memory space we need.
     OSL_realloc(string, char*, (strlen(string) + 1) * sizeof(char));
-    free(buffer);
+    OSL_free(buffer);
   }
 
   return string;
@@ -367,27 +367,27 @@ void osl_irregular_free(osl_irregular_t* const irregular) {
 
   if (irregular != NULL) {
     for (i = 0; i < irregular->nb_statements; i++)
-      free(irregular->predicates[i]);
+      OSL_free(irregular->predicates[i]);
 
     if (irregular->predicates != NULL)
-      free(irregular->predicates);
+      OSL_free(irregular->predicates);
 
     nb_predicates = irregular->nb_control + irregular->nb_exit;
     for (i = 0; i < nb_predicates; i++) {
       for (j = 0; j < irregular->nb_iterators[i]; j++)
-        free(irregular->iterators[i][j]);
-      free(irregular->iterators[i]);
-      free(irregular->body[i]);
+        OSL_free(irregular->iterators[i][j]);
+      OSL_free(irregular->iterators[i]);
+      OSL_free(irregular->body[i]);
     }
     if (irregular->iterators != NULL)
-      free(irregular->iterators);
+      OSL_free(irregular->iterators);
     if (irregular->nb_iterators != NULL)
-      free(irregular->nb_iterators);
+      OSL_free(irregular->nb_iterators);
     if (irregular->body != NULL)
-      free(irregular->body);
+      OSL_free(irregular->body);
     if (irregular->nb_predicates != NULL)
-      free(irregular->nb_predicates);
-    free(irregular);
+      OSL_free(irregular->nb_predicates);
+    OSL_free(irregular);
   }
 }
 
@@ -411,19 +411,19 @@ osl_irregular_t* osl_irregular_clone(const osl_irregular_t* irregular) {
 
   copy = osl_irregular_malloc();
   copy->nb_statements = irregular->nb_statements;
-  copy->nb_predicates = (int*)malloc(sizeof(int) * copy->nb_statements);
+  copy->nb_predicates = (int*)osl_util_malloc(sizeof(int) * copy->nb_statements);
   if (copy->nb_predicates == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->predicates = (int**)malloc(sizeof(int*) * copy->nb_statements);
+  copy->predicates = (int**)osl_util_malloc(sizeof(int*) * copy->nb_statements);
   if (copy->predicates == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (i = 0; i < copy->nb_statements; i++) {
     copy->nb_predicates[i] = irregular->nb_predicates[i];
-    copy->predicates[i] = (int*)malloc(sizeof(int) * copy->nb_predicates[i]);
+    copy->predicates[i] = (int*)osl_util_malloc(sizeof(int) * copy->nb_predicates[i]);
     if (copy->predicates[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -435,24 +435,24 @@ osl_irregular_t* osl_irregular_clone(const osl_irregular_t* irregular) {
   copy->nb_control = irregular->nb_control;
   copy->nb_exit = irregular->nb_exit;
   int nb_predicates = irregular->nb_control + irregular->nb_exit;
-  copy->nb_iterators = (int*)malloc(sizeof(int) * nb_predicates);
+  copy->nb_iterators = (int*)osl_util_malloc(sizeof(int) * nb_predicates);
   if (copy->nb_iterators == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->iterators = (char***)malloc(sizeof(char**) * nb_predicates);
+  copy->iterators = (char***)osl_util_malloc(sizeof(char**) * nb_predicates);
   if (copy->iterators == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->body = (char**)malloc(sizeof(char*) * nb_predicates);
+  copy->body = (char**)osl_util_malloc(sizeof(char*) * nb_predicates);
   if (copy->body == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (i = 0; i < nb_predicates; i++) {
     copy->nb_iterators[i] = irregular->nb_iterators[i];
-    copy->iterators[i] = (char**)malloc(sizeof(char*) * copy->nb_iterators[i]);
+    copy->iterators[i] = (char**)osl_util_malloc(sizeof(char*) * copy->nb_iterators[i]);
     if (copy->iterators[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -520,9 +520,9 @@ osl_irregular_t* osl_irregular_add_control(
   result->nb_statements = irregular->nb_statements;
   int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = (char***)malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = (int*)malloc(sizeof(int) * nb_predicates);
-  result->body = (char**)malloc(sizeof(char*) * nb_predicates);
+  result->iterators = (char***)osl_util_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = (int*)osl_util_malloc(sizeof(int) * nb_predicates);
+  result->body = (char**)osl_util_malloc(sizeof(char*) * nb_predicates);
   if (result->iterators == NULL || result->nb_iterators == NULL ||
       result->body == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
@@ -533,7 +533,7 @@ osl_irregular_t* osl_irregular_add_control(
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
     result->iterators[i] =
-        (char**)malloc(sizeof(char*) * irregular->nb_iterators[i]);
+        (char**)osl_util_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (result->iterators[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -543,7 +543,7 @@ osl_irregular_t* osl_irregular_add_control(
   }
   // add controls
   result->iterators[irregular->nb_control] =
-      (char**)malloc(sizeof(char*) * nb_iterators);
+      (char**)osl_util_malloc(sizeof(char*) * nb_iterators);
   if (result->iterators[irregular->nb_control] == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -557,7 +557,7 @@ osl_irregular_t* osl_irregular_add_control(
     result->nb_iterators[i] = irregular->nb_iterators[i - 1];
     OSL_strdup(result->body[i], irregular->body[i - 1]);
     result->iterators[i] =
-        (char**)malloc(sizeof(char*) * irregular->nb_iterators[i - 1]);
+        (char**)osl_util_malloc(sizeof(char*) * irregular->nb_iterators[i - 1]);
     if (result->iterators[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -566,15 +566,15 @@ osl_irregular_t* osl_irregular_add_control(
       OSL_strdup(result->iterators[i][j], irregular->iterators[i - 1][j]);
   }
   // copy statements
-  result->nb_predicates = (int*)malloc(sizeof(int) * irregular->nb_statements);
-  result->predicates = (int**)malloc(sizeof(int*) * irregular->nb_statements);
+  result->nb_predicates = (int*)osl_util_malloc(sizeof(int) * irregular->nb_statements);
+  result->predicates = (int**)osl_util_malloc(sizeof(int*) * irregular->nb_statements);
   if (result->nb_predicates == NULL || result->predicates == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (i = 0; i < irregular->nb_statements; i++) {
     result->predicates[i] =
-        (int*)malloc(sizeof(int) * irregular->nb_predicates[i]);
+        (int*)osl_util_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (result->predicates[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -597,9 +597,9 @@ osl_irregular_p osl_irregular_add_exit(const osl_irregular_t* const irregular,
   result->nb_statements = irregular->nb_statements;
   int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = (char***)malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = (int*)malloc(sizeof(int) * nb_predicates);
-  result->body = (char**)malloc(sizeof(char*) * nb_predicates);
+  result->iterators = (char***)osl_util_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = (int*)osl_util_malloc(sizeof(int) * nb_predicates);
+  result->body = (char**)osl_util_malloc(sizeof(char*) * nb_predicates);
   if (result->iterators == NULL || result->nb_iterators == NULL ||
       result->body == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
@@ -610,7 +610,7 @@ osl_irregular_p osl_irregular_add_exit(const osl_irregular_t* const irregular,
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
     result->iterators[i] =
-        (char**)malloc(sizeof(char*) * irregular->nb_iterators[i]);
+        (char**)osl_util_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (result->iterators[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -620,7 +620,7 @@ osl_irregular_p osl_irregular_add_exit(const osl_irregular_t* const irregular,
   }
   // add exit
   result->iterators[nb_predicates - 1] =
-      (char**)malloc(sizeof(char*) * nb_iterators);
+      (char**)osl_util_malloc(sizeof(char*) * nb_iterators);
   if (result->iterators[nb_predicates - 1] == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -631,15 +631,15 @@ osl_irregular_p osl_irregular_add_exit(const osl_irregular_t* const irregular,
   result->nb_iterators[nb_predicates - 1] = nb_iterators;
   OSL_strdup(result->body[nb_predicates - 1], body);
   // copy statements
-  result->nb_predicates = (int*)malloc(sizeof(int) * irregular->nb_statements);
-  result->predicates = (int**)malloc(sizeof(int*) * irregular->nb_statements);
+  result->nb_predicates = (int*)osl_util_malloc(sizeof(int) * irregular->nb_statements);
+  result->predicates = (int**)osl_util_malloc(sizeof(int*) * irregular->nb_statements);
   if (result->nb_predicates == NULL || result->predicates == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (i = 0; i < irregular->nb_statements; i++) {
     result->predicates[i] =
-        (int*)malloc(sizeof(int) * irregular->nb_predicates[i]);
+        (int*)osl_util_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (result->predicates[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -662,9 +662,9 @@ osl_irregular_p osl_irregular_add_predicates(
   result->nb_statements = irregular->nb_statements + 1;
   int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = (char***)malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = (int*)malloc(sizeof(int) * nb_predicates);
-  result->body = (char**)malloc(sizeof(char*) * nb_predicates);
+  result->iterators = (char***)osl_util_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = (int*)osl_util_malloc(sizeof(int) * nb_predicates);
+  result->body = (char**)osl_util_malloc(sizeof(char*) * nb_predicates);
   if (result->iterators == NULL || result->nb_iterators == NULL ||
       result->body == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
@@ -675,7 +675,7 @@ osl_irregular_p osl_irregular_add_predicates(
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
     result->iterators[i] =
-        (char**)malloc(sizeof(char*) * irregular->nb_iterators[i]);
+        (char**)osl_util_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (result->iterators[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -684,15 +684,15 @@ osl_irregular_p osl_irregular_add_predicates(
       OSL_strdup(result->iterators[i][j], irregular->iterators[i][j]);
   }
   // copy statements
-  result->nb_predicates = (int*)malloc(sizeof(int) * result->nb_statements);
-  result->predicates = (int**)malloc(sizeof(int*) * result->nb_statements);
+  result->nb_predicates = (int*)osl_util_malloc(sizeof(int) * result->nb_statements);
+  result->predicates = (int**)osl_util_malloc(sizeof(int*) * result->nb_statements);
   if (result->nb_predicates == NULL || result->predicates == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (i = 0; i < irregular->nb_statements; i++) {
     result->predicates[i] =
-        (int*)malloc(sizeof(int) * irregular->nb_predicates[i]);
+        (int*)osl_util_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (result->predicates[i] == NULL) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -703,7 +703,7 @@ osl_irregular_p osl_irregular_add_predicates(
   }
   // add statement
   result->predicates[irregular->nb_statements] =
-      (int*)malloc(sizeof(int) * nb_add_predicates);
+      (int*)osl_util_malloc(sizeof(int) * nb_add_predicates);
   if (result->predicates[irregular->nb_statements] == NULL) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -290,7 +290,7 @@ osl_loop_t* osl_loop_sread(char** input) {
 
     loop->private_vars = osl_util_read_line(NULL, input);
     if (!strcmp(loop->private_vars, "(null)")) {
-      free(loop->private_vars);
+      OSL_free(loop->private_vars);
       loop->private_vars = NULL;
     }
 
@@ -300,7 +300,7 @@ osl_loop_t* osl_loop_sread(char** input) {
     if (loop->directive & OSL_LOOP_DIRECTIVE_USER) {
       loop->user = osl_util_read_line(NULL, input);
       if (!strcmp(loop->user, "(null)")) {
-        free(loop->user);
+        OSL_free(loop->user);
         loop->user = NULL;
       }
     }
@@ -354,17 +354,17 @@ void osl_loop_free(osl_loop_t* loop) {
     osl_loop_p tmp = loop;
 
     if (loop->iter)
-      free(loop->iter);
+      OSL_free(loop->iter);
     if (loop->stmt_ids)
-      free(loop->stmt_ids);
+      OSL_free(loop->stmt_ids);
     if (loop->private_vars)
-      free(loop->private_vars);
+      OSL_free(loop->private_vars);
     if (loop->user)
-      free(loop->user);
+      OSL_free(loop->user);
 
     loop = loop->next;
 
-    free(tmp);
+    OSL_free(tmp);
   }
 }
 
@@ -557,6 +557,49 @@ bool osl_loop_equal(const osl_loop_t* a1, const osl_loop_t* a2) {
   return 1;
 }
 
+/**
+ * osl_loop_hash_one function:
+ * this function returns a 64-bit hash of the content of one loop structure
+ * (the next loops are ignored). As osl_loop_equal_one(), it does not depend
+ * on the order of the statement identifiers.
+ * \param[in] loop The loop structure to hash (possibly NULL).
+ * \return The hash of the loop structure.
+ */
+uint64_t osl_loop_hash_one(const osl_loop_t* const loop) {
+  uint64_t hash, sum = 0;
+  size_t i;
+
+  if (loop == NULL)
+    return osl_util_hash_combine(0, 0);
+
+  for (i = 0; i < loop->nb_stmts; i++)
+    sum += osl_util_hash_combine(0, (uint64_t)loop->stmt_ids[i]);
+
+  hash = osl_util_hash_string(0, loop->iter);
+  hash = osl_util_hash_combine(hash, loop->nb_stmts);
+  hash = osl_util_hash_combine(hash, sum);
+  hash = osl_util_hash_string(hash, loop->private_vars);
+  hash = osl_util_hash_combine(hash, (uint64_t)loop->directive);
+  return osl_util_hash_string(hash, loop->user);
+}
+
+/**
+ * osl_loop_hash function:
+ * this function returns a 64-bit hash of the content of a list of loops.
+ * As osl_loop_equal(), it does not depend on the order of the loops.
+ * \param[in] loop The list of loops to hash (possibly NULL).
+ * \return The hash of the list of loops.
+ */
+uint64_t osl_loop_hash(const osl_loop_t* loop) {
+  uint64_t sum = 0;
+
+  // Summing the per-loop hashes makes the result order-independent.
+  for (; loop != NULL; loop = loop->next)
+    sum += osl_loop_hash_one(loop);
+
+  return osl_util_hash_combine(0, sum);
+}
+
 /**
  * osl_loop_interface function:
  * this function creates an interface structure corresponding to the loop
@@ -575,6 +618,7 @@ osl_interface_p osl_loop_interface(void) {
   interface->free = (osl_free_f)osl_loop_free;
   interface->clone = (osl_clone_f)osl_loop_clone;
   interface->equal = (osl_equal_f)osl_loop_equal;
+  interface->hash = (osl_hash_f)osl_loop_hash;
 
   return interface;
 }
@@ -188,7 +188,7 @@ osl_null_t* osl_null_malloc(void) {
  */
 void osl_null_free(osl_null_t* null) {
   if (null != NULL) {
-    free(null);
+    OSL_free(null);
   }
 }
 
@@ -277,8 +277,8 @@ void osl_pluto_unroll_free(osl_pluto_unroll_t* pluto_unroll) {
   if (pluto_unroll != NULL) {
     osl_pluto_unroll_free(pluto_unroll->next);
 
-    free(pluto_unroll->iter);
-    free(pluto_unroll);
+    OSL_free(pluto_unroll->iter);
+    OSL_free(pluto_unroll);
     pluto_unroll = NULL;
   }
 }
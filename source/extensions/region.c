@@ -83,11 +83,11 @@ static void osl_region_text_idump(FILE* file, const osl_region_text_t* text,
 int osl_region_text_append(osl_region_text_t* text, int line_type, char* line) {
   const size_t count = text->count + 1;
 
-  char** lines = realloc(text->lines, count * sizeof *lines);
+  char** lines = osl_util_realloc(text->lines, count * sizeof *lines);
   if (!lines)
     return 1;
 
-  int* types = realloc(text->types, count * sizeof *types);
+  int* types = osl_util_realloc(text->types, count * sizeof *types);
   if (!types)
     return 1;
 
@@ -118,7 +118,7 @@ osl_region_text_t osl_region_text_clone(const osl_region_text_t* source) {
       .lines = 0,
   };
   for (size_t i = 0; i < source->count; ++i) {
-    char* line = strdup(source->lines[i]);
+    char* line = osl_util_strdup(source->lines[i]);
     osl_region_text_append(&destination, source->types[i], line);
   }
   return destination;
@@ -134,12 +134,12 @@ void osl_region_text_clean(osl_region_text_t* text) {
   if (text->lines) {
     for (size_t i = 0; i < text->count; ++i) {
       if (text->lines[i])
-        free(text->lines[i]);
+        OSL_free(text->lines[i]);
     }
-    free(text->lines);
+    OSL_free(text->lines);
   }
   if (text->types) {
-    free(text->types);
+    OSL_free(text->types);
   }
 }
 
@@ -340,7 +340,7 @@ osl_region_t* osl_region_sread(char** input) {
  ******************************************************************************/
 
 osl_region_t* osl_region_malloc(void) {
-  osl_region_t* const region = malloc(sizeof *region);
+  osl_region_t* const region = osl_util_malloc(sizeof *region);
   if (!region) {
     fprintf(stderr, "[osl] Error: memory overflow (%s).\n", __func__);
     exit(1);
@@ -372,7 +372,7 @@ void osl_region_free(osl_region_t* region) {
     region = region->next;
 
     /* Do not forget to free the current region. */
-    free(tmp);
+    OSL_free(tmp);
   }
 }
 
@@ -292,12 +292,12 @@ osl_scatinfos_t* osl_scatinfos_malloc(void) {
 void osl_scatinfos_free(osl_scatinfos_t* scatinfos) {
   if (scatinfos) {
     if (scatinfos->parallel)
-      free(scatinfos->parallel);
+      OSL_free(scatinfos->parallel);
     if (scatinfos->permutable)
-      free(scatinfos->permutable);
+      OSL_free(scatinfos->permutable);
     if (scatinfos->type)
-      free(scatinfos->type);
-    free(scatinfos);
+      OSL_free(scatinfos->type);
+    OSL_free(scatinfos);
   }
 }
 
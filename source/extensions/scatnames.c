@@ -199,7 +199,7 @@ osl_scatnames_t* osl_scatnames_malloc(void) {
 void osl_scatnames_free(osl_scatnames_t* scatnames) {
   if (scatnames != NULL) {
     osl_strings_free(scatnames->names);
-    free(scatnames);
+    OSL_free(scatnames);
   }
 }
 
@@ -65,10 +65,13 @@
 #include <osl/interface.h>
 #include <osl/macros.h>
 #include <osl/relation.h>
+#include <osl/strings.h>
 #include <osl/util.h>
 
 #include <osl/extensions/symbols.h>
 
+static int osl_symbols_index_type_rank(int);
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -270,28 +273,28 @@ char* osl_symbols_sprint(const osl_symbols_t* symbols) {
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->identifier);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
 
     // Printing Datatype
     sprintf(buffer, "\n# %d.5 Datatype\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->datatype);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
 
     // Printing Scope
     sprintf(buffer, "\n# %d.6 Scope\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->scope);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
 
     // Printing Extent
     sprintf(buffer, "\n# %d.7 Extent\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->extent);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
 
     symbols = symbols->next;
   }
@@ -300,6 +303,50 @@ char* osl_symbols_sprint(const osl_symbols_t* symbols) {
   return string;
 }
 
+/**
+ * osl_symbols_index_idump function:
+ * this function displays an osl_symbols_index_t structure (*index) into a
+ * file (file, possibly stdout) in a way that trends to be understandable.
+ * It includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The symbols index whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_symbols_index_idump(FILE* const file,
+                             const osl_symbols_index_t* const index,
+                             int level) {
+  int j;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (index != NULL) {
+    fprintf(file, "+-- osl_symbols_index_t: %d symbol(s), %zu slot(s)\n",
+            index->nb_symbols, index->nb_slots);
+  } else {
+    fprintf(file, "+-- NULL symbols index\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_symbols_index_dump function:
+ * this function prints the content of an osl_symbols_index_t structure
+ * (*index) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The symbols index whose information has to be printed.
+ */
+void osl_symbols_index_dump(FILE* const file,
+                            const osl_symbols_index_t* const index) {
+  osl_symbols_index_idump(file, index, 0);
+}
+
 /******************************************************************************
  *                               Reading function                             *
  ******************************************************************************/
@@ -336,7 +383,7 @@ osl_symbols_t* osl_symbols_sread(char** input) {
     return NULL;
 
   head = symbols = osl_symbols_malloc();
-  registry = osl_interface_get_default_registry();
+  registry = osl_interface_get_frozen_registry();
 
   while (nb_symbols != 0) {
     // Reading the type of symbol
@@ -352,7 +399,7 @@ osl_symbols_t* osl_symbols_sread(char** input) {
         symbols->type = OSL_SYMBOL_TYPE_FUNCTION;
       else
         symbols->type = OSL_UNDEFINED;
-      free(type);
+      OSL_free(type);
     }
 
     // Reading origin of symbol
@@ -380,7 +427,6 @@ osl_symbols_t* osl_symbols_sread(char** input) {
     }
   }
 
-  osl_interface_free(registry);
   return head;
 }
 
@@ -427,11 +473,30 @@ void osl_symbols_free(osl_symbols_t* symbols) {
     osl_generic_free(symbols->datatype);
     osl_generic_free(symbols->scope);
     osl_generic_free(symbols->extent);
-    free(symbols);
+    OSL_free(symbols);
     symbols = tmp;
   }
 }
 
+/**
+ * osl_symbols_index_free function:
+ * this function frees the allocated memory for an osl_symbols_index_t
+ * structure. The indexed symbols are not freed.
+ * \param[in,out] index The pointer to the symbols index to free.
+ */
+void osl_symbols_index_free(osl_symbols_index_t* index) {
+  if (index != NULL) {
+    OSL_free(index->symbol);
+    OSL_free(index->name);
+    OSL_free(index->type);
+    OSL_free(index->nb_dims);
+    OSL_free(index->start);
+    OSL_free(index->by_type);
+    OSL_free(index->slot);
+    OSL_free(index);
+  }
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -539,6 +604,183 @@ int osl_symbols_get_nb_symbols(const osl_symbols_t* symbols) {
   return nb_symbols;
 }
 
+/**
+ * osl_symbols_lookup function:
+ * this function returns the first symbol of a symbols list with a given
+ * identifier, or NULL if there is no such symbol. For repeated lookups by
+ * name, see osl_symbols_index_build().
+ * \param[in] symbols    The head of the symbol list.
+ * \param[in] identifier The identifier of the symbol to find.
+ * \return The symbol with the identifier, NULL if not found.
+ */
+osl_symbols_t* osl_symbols_lookup(osl_symbols_t* symbols,
+                                  osl_generic_t* identifier) {
+  while (symbols != NULL) {
+    if (osl_generic_equal(symbols->identifier, identifier))
+      return symbols;
+    symbols = symbols->next;
+  }
+  return NULL;
+}
+
+/**
+ * osl_symbols_remove function:
+ * this function removes a symbol from the symbols list pointed by
+ * "location" and returns it (unlinked, but not freed), or NULL if the
+ * symbol does not belong to the list.
+ * \param[in,out] location Address of the first element of the symbols list.
+ * \param[in]     symbol   The symbol to remove.
+ * \return The removed symbol, NULL if not found.
+ */
+osl_symbols_t* osl_symbols_remove(osl_symbols_t** location,
+                                  osl_symbols_t* symbol) {
+  while (*location != NULL) {
+    if (*location == symbol) {
+      *location = symbol->next;
+      symbol->next = NULL;
+      return symbol;
+    }
+    location = &((*location)->next);
+  }
+  return NULL;
+}
+
+/**
+ * osl_symbols_get_name function:
+ * this function returns the name of a symbol, i.e., the first string of
+ * its identifier when it is a strings generic.
+ * \param[in] symbol The symbol.
+ * \return The name of the symbol, NULL if it has no textual identifier.
+ */
+const char* osl_symbols_get_name(const osl_symbols_t* symbol) {
+  osl_strings_p identifier;
+
+  if ((symbol == NULL) ||
+      !osl_generic_has_URI(symbol->identifier,
+                           osl_interface_atom(OSL_URI_STRINGS)))
+    return NULL;
+
+  identifier = symbol->identifier->data;
+  if ((identifier == NULL) || (osl_strings_size(identifier) == 0))
+    return NULL;
+  return identifier->string[0];
+}
+
+/**
+ * osl_symbols_index_build function:
+ * this function builds an index of a symbols list (see osl_symbols_index_t).
+ * If several symbols have the same name, osl_symbols_index_lookup() returns
+ * the first one in the list.
+ * \param[in] symbols The head of the symbol list to index.
+ * \return A new symbols index, to free with osl_symbols_index_free().
+ */
+osl_symbols_index_t* osl_symbols_index_build(osl_symbols_t* symbols) {
+  int i, k, n;
+  size_t h, mask;
+  osl_symbols_index_p index;
+
+  n = osl_symbols_get_nb_symbols(symbols);
+  OSL_malloc(index, osl_symbols_index_p, sizeof(osl_symbols_index_t));
+  index->nb_symbols = n;
+  OSL_malloc(index->symbol, osl_symbols_p*,
+             (size_t)(n + 1) * sizeof(osl_symbols_p));
+  OSL_malloc(index->name, const char**, (size_t)(n + 1) * sizeof(char*));
+  OSL_malloc(index->type, int*, (size_t)(n + 1) * sizeof(int));
+  OSL_malloc(index->nb_dims, int*, (size_t)(n + 1) * sizeof(int));
+  OSL_malloc(index->start, int*,
+             (OSL_SYMBOLS_INDEX_NB_TYPES + 1) * sizeof(int));
+  OSL_malloc(index->by_type, osl_symbols_p*,
+             (size_t)(n + 1) * sizeof(osl_symbols_p));
+
+  // Flatten the list and count the symbols of each type.
+  for (k = 0; k <= OSL_SYMBOLS_INDEX_NB_TYPES; k++)
+    index->start[k] = 0;
+  for (i = 0; i < n; i++, symbols = symbols->next) {
+    index->symbol[i] = symbols;
+    index->name[i] = osl_symbols_get_name(symbols);
+    index->type[i] = symbols->type;
+    index->nb_dims[i] = symbols->nb_dims;
+    index->start[osl_symbols_index_type_rank(symbols->type) + 1]++;
+  }
+
+  // Group the symbols by type, keeping the list order.
+  for (k = 0; k < OSL_SYMBOLS_INDEX_NB_TYPES; k++)
+    index->start[k + 1] += index->start[k];
+  for (i = 0; i < n; i++) {
+    k = osl_symbols_index_type_rank(index->type[i]);
+    index->by_type[index->start[k]++] = index->symbol[i];
+  }
+  for (k = OSL_SYMBOLS_INDEX_NB_TYPES; k > 0; k--)
+    index->start[k] = index->start[k - 1];
+  index->start[0] = 0;
+
+  // Hash the names, in list order so that the first one is found first.
+  index->nb_slots = 16;
+  while (index->nb_slots < 2 * (size_t)n)
+    index->nb_slots *= 2;
+  OSL_malloc(index->slot, int*, index->nb_slots * sizeof(int));
+  for (h = 0; h < index->nb_slots; h++)
+    index->slot[h] = 0;
+  mask = index->nb_slots - 1;
+  for (i = 0; i < n; i++) {
+    if (index->name[i] == NULL)
+      continue;
+    h = (size_t)osl_util_hash_string(0, index->name[i]) & mask;
+    while (index->slot[h] != 0)
+      h = (h + 1) & mask;
+    index->slot[h] = i + 1;
+  }
+
+  return index;
+}
+
+/**
+ * osl_symbols_index_lookup function:
+ * this function returns the first indexed symbol with a given name, or NULL
+ * if there is no such symbol.
+ * \param[in] index The symbols index.
+ * \param[in] name  The name of the symbol to find.
+ * \return The symbol with the name, NULL if not found.
+ */
+osl_symbols_t* osl_symbols_index_lookup(const osl_symbols_index_t* index,
+                                        const char* name) {
+  size_t h, mask;
+
+  if ((index == NULL) || (name == NULL))
+    return NULL;
+
+  mask = index->nb_slots - 1;
+  h = (size_t)osl_util_hash_string(0, name) & mask;
+  for (; index->slot[h] != 0; h = (h + 1) & mask)
+    if (!strcmp(index->name[index->slot[h] - 1], name))
+      return index->symbol[index->slot[h] - 1];
+  return NULL;
+}
+
+/**
+ * osl_symbols_index_get_type function:
+ * this function sets *symbols to the contiguous array of the indexed
+ * symbols of a given type (in list order) and returns their number. Types
+ * other than the OSL_SYMBOL_TYPE_* ones are gathered with OSL_UNDEFINED.
+ * \param[in]  index   The symbols index.
+ * \param[in]  type    The symbol type (OSL_SYMBOL_TYPE_* or OSL_UNDEFINED).
+ * \param[out] symbols Address where to store the array of symbols.
+ * \return The number of symbols of the type.
+ */
+int osl_symbols_index_get_type(const osl_symbols_index_t* index, int type,
+                               osl_symbols_t* const** symbols) {
+  int k;
+
+  if (index == NULL) {
+    *symbols = NULL;
+    return 0;
+  }
+
+  k = osl_symbols_index_type_rank(type);
+  *symbols = index->by_type + index->start[k];
+  return index->start[k + 1] - index->start[k];
+}
+
 /**
  * osl_symbols_interface function:
  * this function creates an interface structure corresponding to the symbols
@@ -558,3 +800,15 @@ osl_interface_t* osl_symbols_interface(void) {
   interface->equal = (osl_equal_f)osl_symbols_equal;
   return interface;
 }
+
+/**
+ * osl_symbols_index_type_rank internal function:
+ * this function returns the rank of a symbol type in a symbols index.
+ * \param[in] type The symbol type.
+ * \return The rank of the type, 0 if it is not an OSL_SYMBOL_TYPE_* one.
+ */
+int osl_symbols_index_type_rank(int type) {
+  if ((type >= OSL_SYMBOL_TYPE_ITERATOR) && (type <= OSL_SYMBOL_TYPE_FUNCTION))
+    return type - OSL_SYMBOL_TYPE_ITERATOR + 1;
+  return 0;
+}
@@ -112,7 +112,7 @@ void osl_textual_idump(FILE* const file, const osl_textual_t* const textual,
     } else {
       fprintf(file, "%s\n", tmp);
     }
-    free(tmp);
+    OSL_free(tmp);
   } else {
     fprintf(file, "+-- NULL textual\n");
   }
@@ -149,7 +149,7 @@ char * osl_textual_sprint(const osl_textual_t* const textual) {
     if (strlen(textual->textual) > OSL_MAX_STRING) 
       OSL_error("textual too long");
     
-    string = strdup(textual->textual);
+    string = osl_util_strdup(textual->textual);
     if (string == NULL)
       OSL_error("memory overflow");
   }
@@ -229,8 +229,8 @@ osl_textual_t* osl_textual_malloc(void) {
 void osl_textual_free(osl_textual_t* textual) {
   if (textual != NULL) {
     if (textual->textual != NULL)
-      free(textual->textual);
-    free(textual);
+      OSL_free(textual->textual);
+    OSL_free(textual);
   }
 }
 
@@ -279,6 +279,19 @@ bool osl_textual_equal(const osl_textual_t* f1, const osl_textual_t* f2) {
 
   return 1;
 }
+
+/**
+ * osl_textual_hash function:
+ * this function returns a 64-bit hash of the content of a textual structure.
+ * \param textual The textual structure to hash (possibly NULL).
+ * \return The hash of the textual structure.
+ */
+uint64_t osl_textual_hash(const osl_textual_t* textual) {
+  if (textual == NULL)
+    return osl_util_hash_combine(0, 0);
+
+  return osl_util_hash_string(1, textual->textual);
+}
 #else
 /**
  * osl_textual_equal function:
@@ -294,6 +307,18 @@ bool osl_textual_equal(const osl_textual_t* f1, const osl_textual_t* f2) {
   (void)f2;
   return 1;
 }
+
+/**
+ * osl_textual_hash function:
+ * this function returns a constant, consistently with osl_textual_equal()
+ * which considers all textual structures as identical.
+ * \param[in] textual The textual structure to hash (ignored).
+ * \return A constant hash.
+ */
+uint64_t osl_textual_hash(const osl_textual_t* textual) {
+  (void)textual;
+  return osl_util_hash_combine(0, 1);
+}
 #endif
 
 /**
@@ -313,6 +338,7 @@ osl_interface_t* osl_textual_interface(void) {
   interface->free = (osl_free_f)osl_textual_free;
   interface->clone = (osl_clone_f)osl_textual_clone;
   interface->equal = (osl_equal_f)osl_textual_equal;
+  interface->hash = (osl_hash_f)osl_textual_hash;
 
   return interface;
 }
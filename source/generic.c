@@ -68,6 +68,12 @@
 #include <osl/macros.h>
 #include <osl/util.h>
 
+static size_t osl_generic_index_hash(const osl_generic_index_t*, const char*);
+static osl_generic_t* osl_generic_index_find(const osl_generic_index_t*,
+                                             const char*);
+static void osl_generic_index_insert(osl_generic_index_t*, osl_generic_t*);
+static void osl_generic_index_erase(osl_generic_index_t*, osl_generic_t*);
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -164,7 +170,7 @@ char* osl_generic_sprint(const osl_generic_t* generic) {
         sprintf(buffer, "<%s>\n", generic->interface->URI);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
         osl_util_safe_strcat(&string, content, &high_water_mark);
-        free(content);
+        OSL_free(content);
         sprintf(buffer, "</%s>\n", generic->interface->URI);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
       }
@@ -192,7 +198,7 @@ void osl_generic_print(FILE* const file, const osl_generic_t* const generic) {
   string = osl_generic_sprint(generic);
   if (string != NULL) {
     fprintf(file, "%s", string);
-    free(string);
+    OSL_free(string);
   }
 }
 
@@ -207,13 +213,58 @@ void osl_generic_print_options_scoplib(FILE* const file,
                                        const osl_generic_t* const generic) {
   char* string;
 
-  osl_generic_p arrays = osl_generic_lookup(generic, OSL_URI_ARRAYS);
+  osl_generic_p arrays =
+      osl_generic_lookup(generic, osl_interface_atom(OSL_URI_ARRAYS));
 
   string = osl_arrays_sprint((osl_arrays_p)arrays);
   if (string != NULL) {
     fprintf(file, "<arrays>\n%s</arrays>\n", string);
-    free(string);
+    OSL_free(string);
+  }
+}
+
+/**
+ * osl_generic_index_idump function:
+ * this function displays an osl_generic_index_t structure (*index) into a
+ * file (file, possibly stdout) in a way that trends to be understandable.
+ * It includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The generic index whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_generic_index_idump(FILE* const file,
+                             const osl_generic_index_t* const index,
+                             int level) {
+  int j;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (index != NULL) {
+    fprintf(file, "+-- osl_generic_index_t: %d generic(s), %zu slot(s)\n",
+            index->nb_generics, index->nb_slots);
+  } else {
+    fprintf(file, "+-- NULL generic index\n");
   }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_generic_index_dump function:
+ * this function prints the content of an osl_generic_index_t structure
+ * (*index) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The generic index whose information has to be printed.
+ */
+void osl_generic_index_dump(FILE* const file,
+                            const osl_generic_index_t* const index) {
+  osl_generic_index_idump(file, index, 0);
 }
 
 /******************************************************************************
@@ -280,8 +331,8 @@ osl_generic_t* osl_generic_sread_one(char** const input,
     generic->data = interface->sread(&temp);
   }
 
-  free(content);
-  free(tag);
+  OSL_free(content);
+  OSL_free(tag);
   return generic;
 }
 
@@ -322,8 +373,8 @@ osl_generic_t* osl_generic_read_one(FILE* const file,
     generic->data = interface->sread(&temp);
   }
 
-  free(content);
-  free(tag);
+  OSL_free(content);
+  OSL_free(tag);
   return generic;
 }
 
@@ -344,7 +395,7 @@ osl_generic_t* osl_generic_read(FILE* const file,
   generic_string = osl_util_read_uptoendtag(file, NULL, OSL_URI_SCOP);
   temp = generic_string;
   generic_list = osl_generic_sread(&temp, registry);
-  free(generic_string);
+  OSL_free(generic_string);
   return generic_list;
 }
 
@@ -356,7 +407,8 @@ osl_generic_t* osl_generic_read(FILE* const file,
  * osl_generic_add function:
  * this function adds a generic node (it may be a list as well) to a list
  * of generics provided as parameter (list). The new node is inserted at
- * the end of the list.
+ * the end of the list, and the index of the list (see osl_generic_t) is
+ * updated.
  * \param[in] list    The list of generics to add a node (NULL if empty).
  * \param[in] generic The generic list to add to the initial list.
  */
@@ -364,6 +416,9 @@ void osl_generic_add(osl_generic_t** list, osl_generic_t* generic) {
   osl_generic_p tmp = *list, check;
 
   if (generic != NULL) {
+    if ((*list != NULL) && ((*list)->index == NULL))
+      osl_generic_index_sync(*list);
+
     // First, check that the generic list is OK.
     check = generic;
     while (check != NULL) {
@@ -380,28 +435,49 @@ void osl_generic_add(osl_generic_t** list, osl_generic_t* generic) {
       while (tmp->next != NULL)
         tmp = tmp->next;
       tmp->next = generic;
+
+      // The index of the added list, if any, is merged in the list's one.
+      osl_generic_index_free(generic->index);
+      generic->index = NULL;
+      for (; generic != NULL; generic = generic->next)
+        osl_generic_index_insert((*list)->index, generic);
     } else {
       *list = generic;
+      if (generic->index == NULL)
+        osl_generic_index_sync(generic);
     }
   }
 }
 
 /**
  * osl_generic_remove_node function:
- * this functions removes a given generic from a generic list
+ * this functions removes a given generic from a generic list, and from the
+ * index of the list (see osl_generic_t), which moves to the new head if
+ * the head is removed.
  * \param[in] list    Address of a generic list
  * \param[in] generic Pointer to the generic to be removed
  *                    Assumes a single node is to be removed.
  */
 void osl_generic_remove_node(osl_generic_t** list, osl_generic_t* generic) {
   osl_generic_p tmp = NULL;
+  osl_generic_index_p index;
 
   if (generic != NULL) {
     if (*list != NULL) {
+      index = (*list)->index;
+
       // target is the first element of list
       if (*list == generic) {
         *list = generic->next;
         generic->next = NULL;  // free below removes the whole list!
+        generic->index = NULL;
+        if (index != NULL) {
+          osl_generic_index_erase(index, generic);
+          if (*list != NULL)
+            (*list)->index = index;
+          else
+            osl_generic_index_free(index);
+        }
         osl_generic_free(generic);
         return;
       }
@@ -414,6 +490,8 @@ void osl_generic_remove_node(osl_generic_t** list, osl_generic_t* generic) {
       if (tmp->next == generic) {
         tmp->next = generic->next;
         generic->next = NULL;  // free below removes the whole list!
+        if (index != NULL)
+          osl_generic_index_erase(index, generic);
         osl_generic_free(generic);
       } else  // target not found
         OSL_warning("generic not found in the list\n");
@@ -430,10 +508,14 @@ void osl_generic_remove_node(osl_generic_t** list, osl_generic_t* generic) {
 void osl_generic_remove(osl_generic_t** list, const char* URI) {
   osl_generic_p tmp = *list;
 
-  while (tmp != NULL) {
-    if (osl_generic_has_URI(tmp, URI))
-      break;
-    tmp = tmp->next;
+  if ((tmp != NULL) && (tmp->index != NULL)) {
+    tmp = osl_generic_index_find(tmp->index, URI);
+  } else {
+    while (tmp != NULL) {
+      if (osl_generic_has_URI(tmp, URI))
+        break;
+      tmp = tmp->next;
+    }
   }
 
   if (tmp != NULL) {
@@ -456,6 +538,7 @@ osl_generic_t* osl_generic_malloc(void) {
   generic->interface = NULL;
   generic->data = NULL;
   generic->next = NULL;
+  generic->index = NULL;
 
   return generic;
 }
@@ -476,14 +559,29 @@ void osl_generic_free(osl_generic_t* generic) {
     } else {
       if (generic->data != NULL) {
         OSL_warning("unregistered interface, memory leaks are possible");
-        free(generic->data);
+        OSL_free(generic->data);
       }
     }
-    free(generic);
+    osl_generic_index_free(generic->index);
+    OSL_free(generic);
     generic = next;
   }
 }
 
+/**
+ * osl_generic_index_free function:
+ * this function frees the allocated memory for an osl_generic_index_t
+ * structure. The indexed generics are not freed.
+ * \param[in,out] index The pointer to the generic index to free.
+ */
+void osl_generic_index_free(osl_generic_index_t* index) {
+  if (index == NULL)
+    return;
+
+  OSL_free(index->slot);
+  OSL_free(index);
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -625,32 +723,83 @@ bool osl_generic_equal(const osl_generic_t* x1, const osl_generic_t* x2) {
   return 1;
 }
 
+/**
+ * osl_generic_hash function:
+ * this function returns a 64-bit hash of the content of a generic list.
+ * As osl_generic_equal(), the hash does not depend on the order of the
+ * nodes. The content of each node is hashed with the hash function of its
+ * interface if it provides one, or from its textual form otherwise.
+ * \param[in] x The generic list to hash (possibly NULL).
+ * \return The hash of the generic list.
+ */
+uint64_t osl_generic_hash(const osl_generic_t* x) {
+  uint64_t node, sum = 0;
+  int nb_generics = 0;
+  char* string;
+
+  for (; x != NULL; x = x->next) {
+    nb_generics++;
+    if (x->interface == NULL) {
+      sum += osl_util_hash_combine(0, 0);
+      continue;
+    }
+
+    node = osl_util_hash_string(0, x->interface->URI);
+    if (x->interface->hash != NULL) {
+      node = osl_util_hash_combine(node, x->interface->hash(x->data));
+    } else {
+      string = x->interface->sprint(x->data);
+      node = osl_util_hash_string(node, string);
+      OSL_free(string);
+    }
+    // Summing the per-node hashes makes the result order-independent.
+    sum += node;
+  }
+
+  return osl_util_hash_combine((uint64_t)nb_generics, sum);
+}
+
 /**
  * osl_generic_has_URI function:
  * this function returns 1 if the generic provided as parameter has
- * a given URI, 0 other wise.
+ * a given URI, 0 other wise. It starts with a pointer compare, hence it
+ * is faster with an atom as URI (see osl_interface_atom()), and two atoms
+ * are compared without looking at their characters.
  * \param[in] x   The generic structure to test.
  * \param[in] URI The URI value to test.
  * \return 1 if x has the provided URI, 0 otherwise.
  */
 int osl_generic_has_URI(const osl_generic_t* const x, char const* const URI) {
   if ((x == NULL) || (x->interface == NULL) || (x->interface->URI == NULL) ||
-      (strcmp(x->interface->URI, URI)))
+      (URI == NULL))
     return 0;
 
-  return 1;
+  // Atoms (see osl_interface_atom()) are compared as pointers, and the URI
+  // of a frozen interface is an atom.
+  if (x->interface->URI == URI)
+    return 1;
+  if (x->interface->frozen && osl_interface_is_atom(URI))
+    return 0;
+
+  return !strcmp(x->interface->URI, URI);
 }
 
 /**
  * osl_generic_lookup function:
  * this function returns the first generic with a given URI in the
  * generic list provided as parameter and NULL if it doesn't find such
- * a generic.
+ * a generic. It takes constant expected time if the list is indexed (see
+ * osl_generic_t).
  * \param[in] x   The generic list where to search a given generic URI.
  * \param[in] URI The URI of the generic we are looking for.
  * \return The first generic of the requested URI in the list.
  */
 void* osl_generic_lookup(const osl_generic_t* x, char const* const URI) {
+  if ((x != NULL) && (x->index != NULL)) {
+    x = osl_generic_index_find(x->index, URI);
+    return (x != NULL) ? x->data : NULL;
+  }
+
   while (x != NULL) {
     if (osl_generic_has_URI(x, URI))
       return x->data;
@@ -681,3 +830,132 @@ osl_generic_t* osl_generic_shell(void* const data,
   generic->interface = interface;
   return generic;
 }
+
+/**
+ * osl_generic_index_hash internal function:
+ * this function returns the first slot where to look for a generic of a
+ * given URI in the hash table of a generic index.
+ * \param[in] index The generic index.
+ * \param[in] URI   The URI of the generic.
+ * \return The first slot of the URI.
+ */
+size_t osl_generic_index_hash(const osl_generic_index_t* index,
+                              const char* URI) {
+  return (size_t)osl_util_hash_string(0, URI) & (index->nb_slots - 1);
+}
+
+/**
+ * osl_generic_index_find internal function:
+ * this function returns the generic of a given URI in a generic index, in
+ * constant expected time, and NULL if there is no such generic.
+ * \param[in] index The generic index.
+ * \param[in] URI   The URI of the generic we are looking for.
+ * \return The generic of the requested URI, NULL if none.
+ */
+osl_generic_t* osl_generic_index_find(const osl_generic_index_t* index,
+                                      const char* URI) {
+  size_t k;
+
+  if (URI == NULL)
+    return NULL;
+
+  k = osl_generic_index_hash(index, URI);
+  while (index->slot[k] != NULL) {
+    if (osl_generic_has_URI(index->slot[k], URI))
+      return index->slot[k];
+    k = (k + 1) & (index->nb_slots - 1);
+  }
+  return NULL;
+}
+
+/**
+ * osl_generic_index_insert internal function:
+ * this function inserts a generic in the hash table of a generic index,
+ * which is doubled first if it would become more than half full.
+ * \param[in,out] index   The generic index.
+ * \param[in]     generic The generic to insert.
+ */
+void osl_generic_index_insert(osl_generic_index_t* index,
+                              osl_generic_t* generic) {
+  osl_generic_p* slot = index->slot;
+  size_t k, nb_slots = index->nb_slots;
+
+  if (2 * (size_t)(index->nb_generics + 1) > nb_slots) {
+    index->nb_slots = (nb_slots == 0) ? 8 : 2 * nb_slots;
+    OSL_malloc(index->slot, osl_generic_p*,
+               index->nb_slots * sizeof(osl_generic_p));
+    for (k = 0; k < index->nb_slots; k++)
+      index->slot[k] = NULL;
+    index->nb_generics = 0;
+    for (k = 0; k < nb_slots; k++)
+      if (slot[k] != NULL)
+        osl_generic_index_insert(index, slot[k]);
+    OSL_free(slot);
+  }
+
+  // Linear probing.
+  k = osl_generic_index_hash(index, generic->interface->URI);
+  while (index->slot[k] != NULL)
+    k = (k + 1) & (index->nb_slots - 1);
+  index->slot[k] = generic;
+  index->nb_generics++;
+}
+
+/**
+ * osl_generic_index_erase internal function:
+ * this function removes a generic from the hash table of a generic index,
+ * if it is there, and moves back the generics of the same probe sequence.
+ * \param[in,out] index   The generic index.
+ * \param[in]     generic The generic to remove.
+ */
+void osl_generic_index_erase(osl_generic_index_t* index,
+                             osl_generic_t* generic) {
+  size_t i, j, k, mask = index->nb_slots - 1;
+
+  i = osl_generic_index_hash(index, generic->interface->URI);
+  while ((index->slot[i] != NULL) && (index->slot[i] != generic))
+    i = (i + 1) & mask;
+  if (index->slot[i] == NULL)
+    return;
+
+  index->slot[i] = NULL;
+  index->nb_generics--;
+  for (j = (i + 1) & mask; index->slot[j] != NULL; j = (j + 1) & mask) {
+    // A generic is moved to the hole if its home slot k is not in (i, j].
+    k = osl_generic_index_hash(index, index->slot[j]->interface->URI);
+    if ((i < j) ? ((k <= i) || (k > j)) : ((k <= i) && (k > j))) {
+      index->slot[i] = index->slot[j];
+      index->slot[j] = NULL;
+      i = j;
+    }
+  }
+}
+
+/**
+ * osl_generic_index_sync function:
+ * this function builds again the index owned by the head of a generic list
+ * (see osl_generic_t), after nodes have been linked or unlinked directly
+ * instead of through osl_generic_add() and osl_generic_remove(). The
+ * indexes of the other nodes, if any, are freed.
+ * \param[in,out] list The generic list to index (possibly NULL).
+ */
+void osl_generic_index_sync(osl_generic_t* list) {
+  osl_generic_p generic;
+
+  if (list == NULL)
+    return;
+
+  for (generic = list; generic != NULL; generic = generic->next) {
+    if ((generic->interface == NULL) || (generic->interface->URI == NULL))
+      OSL_error("no interface or URI in a generic to index");
+    osl_generic_index_free(generic->index);
+    generic->index = NULL;
+  }
+
+  OSL_malloc(list->index, osl_generic_index_p, sizeof(osl_generic_index_t));
+  list->index->nb_generics = 0;
+  list->index->nb_slots = 0;
+  list->index->slot = NULL;
+  for (generic = list; generic != NULL; generic = generic->next)
+    osl_generic_index_insert(list->index, generic);
+}
@@ -61,15 +61,40 @@
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef OSL_GMP_IS_HERE
 #include <gmp.h>
 #endif
 
+#include <osl/attributes.h>
 #include <osl/int.h>
 #include <osl/macros.h>
+#include <osl/util.h>
 
 static long long int llgcd(long long int, long long int);
+static void osl_int_oppose_sp(long int*, size_t) OSL_TARGET_CLONES;
+static void osl_int_oppose_dp(long long int*, size_t) OSL_TARGET_CLONES;
+static void osl_int_addmul_sp(long int*, const long int*, size_t,
+                              long int) OSL_TARGET_CLONES;
+static void osl_int_addmul_dp(long long int*, const long long int*, size_t,
+                              long long int) OSL_TARGET_CLONES;
+static unsigned long int osl_int_max_abs_sp(const long int*, size_t)
+    OSL_TARGET_CLONES;
+static unsigned long long int osl_int_max_abs_dp(const long long int*, size_t)
+    OSL_TARGET_CLONES;
+static void osl_int_div_exact_sp(long int*, size_t, long int) OSL_TARGET_CLONES;
+static void osl_int_div_exact_dp(long long int*, size_t,
+                                 long long int) OSL_TARGET_CLONES;
+static unsigned long int osl_int_gcd_sp(const long int*, size_t)
+    OSL_TARGET_CLONES;
+static unsigned long long int osl_int_gcd_dp(const long long int*, size_t)
+    OSL_TARGET_CLONES;
+static unsigned long long int osl_int_inverse(unsigned long long int);
+static int osl_int_addmul_fits(unsigned long long int, unsigned long long int,
+                               unsigned long long int, unsigned long long int);
+static int osl_int_addmul_array_fits(int, const osl_int_t*, const osl_int_t*,
+                                     size_t, osl_int_t);
 static size_t lllog2(long long int);
 static size_t lllog10(long long int);
 
@@ -571,7 +596,7 @@ void osl_int_clear(const int precision, osl_int_t* const variable) {
 #ifdef OSL_GMP_IS_HERE
     case OSL_PRECISION_MP:
       mpz_clear(*variable->mp);
-      free(variable->mp);
+      OSL_free(variable->mp);
       break;
 #endif
 
@@ -587,7 +612,7 @@ void osl_int_clear(const int precision, osl_int_t* const variable) {
  */
 void osl_int_free(const int precision, osl_int_t* const variable) {
   osl_int_clear(precision, variable);
-  free(variable);
+  OSL_free(variable);
 }
 
 /**
@@ -629,7 +654,7 @@ void osl_int_sprint(char* const string, const int precision,
       char* str;
       str = mpz_get_str(0, 10, *value.mp);  // TODO: 10 -> #define
       sprintf(string, OSL_FMT_MP, str);
-      free(str);
+      OSL_free(str);
       break;
     }
 #endif
@@ -661,7 +686,7 @@ void osl_int_sprint_txt(char* const string, const int precision,
       char* str;
       str = mpz_get_str(0, 10, *value.mp);  // TODO: 10 -> #define
       sprintf(string, OSL_FMT_TXT_MP, str);
-      free(str);
+      OSL_free(str);
       break;
     }
 #endif
@@ -1327,6 +1352,440 @@ size_t osl_int_size_in_base_10(const int precision, const osl_int_t value) {
   }
 }
 
+/******************************************************************************
+ *                              Array Operations                              *
+ ******************************************************************************/
+
+// The SP/DP kernels are plain loops over arrays of machine integers the
+// compiler vectorizes, one clone per instruction set (see OSL_TARGET_CLONES).
+// They are used on osl int arrays whose elements fill the osl_int_t union.
+#define OSL_INT_SP_PACKED (sizeof(long int) == sizeof(osl_int_t))
+#define OSL_INT_DP_PACKED (sizeof(long long int) == sizeof(osl_int_t))
+
+void osl_int_oppose_sp(long int* array, size_t size) {
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    array[i] = -array[i];
+}
+
+void osl_int_oppose_dp(long long int* array, size_t size) {
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    array[i] = -array[i];
+}
+
+void osl_int_addmul_sp(long int* restrict array1,
+                       const long int* restrict array2, size_t size,
+                       long int factor) {
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    array1[i] += factor * array2[i];
+}
+
+void osl_int_addmul_dp(long long int* restrict array1,
+                       const long long int* restrict array2, size_t size,
+                       long long int factor) {
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    array1[i] += factor * array2[i];
+}
+
+// Absolute values are computed on unsigned integers, so that the absolute
+// value of the smallest integer does not overflow.
+unsigned long int osl_int_max_abs_sp(const long int* array, size_t size) {
+  unsigned long int a, max = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0UL - (unsigned long int)array[i]
+                       : (unsigned long int)array[i];
+    max = (a > max) ? a : max;
+  }
+  return max;
+}
+
+unsigned long long int osl_int_max_abs_dp(const long long int* array,
+                                          size_t size) {
+  unsigned long long int a, max = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0ULL - (unsigned long long int)array[i]
+                       : (unsigned long long int)array[i];
+    max = (a > max) ? a : max;
+  }
+  return max;
+}
+
+// Exact divisions shift out the powers of 2 of the divisor, then multiply
+// by the inverse of its odd part modulo the word size, which vectorizes
+// where divisions do not.
+void osl_int_div_exact_sp(long int* array, size_t size, long int divisor) {
+  unsigned long int d, inverse;
+  int shift = 0;
+  size_t i;
+
+  d = (divisor < 0) ? 0UL - (unsigned long int)divisor
+                    : (unsigned long int)divisor;
+  for (; (d & 1) == 0; d >>= 1)
+    shift++;
+  inverse = (unsigned long int)osl_int_inverse(d);
+  if (divisor < 0)
+    inverse = 0UL - inverse;
+
+  for (i = 0; i < size; i++)
+    array[i] = (long int)((unsigned long int)(array[i] >> shift) * inverse);
+}
+
+void osl_int_div_exact_dp(long long int* array, size_t size,
+                          long long int divisor) {
+  unsigned long long int d, inverse;
+  int shift = 0;
+  size_t i;
+
+  d = (divisor < 0) ? 0ULL - (unsigned long long int)divisor
+                    : (unsigned long long int)divisor;
+  for (; (d & 1) == 0; d >>= 1)
+    shift++;
+  inverse = osl_int_inverse(d);
+  if (divisor < 0)
+    inverse = 0ULL - inverse;
+
+  for (i = 0; i < size; i++)
+    array[i] =
+        (long long int)((unsigned long long int)(array[i] >> shift) * inverse);
+}
+
+// The gcd is first guessed as the smallest non-zero absolute value, and
+// checked in one vector pass that divides every element by the same method
+// (x is a multiple of an odd d iff x * inverse(d) <= max / d modulo the word
+// size). Euclid's algorithm only runs when the guess is wrong.
+unsigned long int osl_int_gcd_sp(const long int* array, size_t size) {
+  unsigned long int a, d, gcd = ULONG_MAX, mask, inverse, limit;
+  int shift = 0, fail = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0UL - (unsigned long int)array[i]
+                       : (unsigned long int)array[i];
+    gcd = ((a != 0) && (a < gcd)) ? a : gcd;
+  }
+  if ((gcd == ULONG_MAX) || (gcd == 1))
+    return (gcd == 1) ? 1 : 0;
+
+  for (d = gcd; (d & 1) == 0; d >>= 1)
+    shift++;
+  mask = (1UL << shift) - 1;
+  inverse = (unsigned long int)osl_int_inverse(d);
+  limit = ULONG_MAX / d;
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0UL - (unsigned long int)array[i]
+                       : (unsigned long int)array[i];
+    fail |= ((a & mask) != 0) | (((a >> shift) * inverse) > limit);
+  }
+  if (!fail)
+    return gcd;
+
+  for (i = 0; (i < size) && (gcd != 1); i++)
+    if (array[i] != 0)
+      gcd = (unsigned long int)llabs(llgcd((long long int)gcd, array[i]));
+  return gcd;
+}
+
+unsigned long long int osl_int_gcd_dp(const long long int* array,
+                                      size_t size) {
+  unsigned long long int a, d, gcd = ULLONG_MAX, mask, inverse, limit;
+  int shift = 0, fail = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0ULL - (unsigned long long int)array[i]
+                       : (unsigned long long int)array[i];
+    gcd = ((a != 0) && (a < gcd)) ? a : gcd;
+  }
+  if ((gcd == ULLONG_MAX) || (gcd == 1))
+    return (gcd == 1) ? 1 : 0;
+
+  for (d = gcd; (d & 1) == 0; d >>= 1)
+    shift++;
+  mask = (1ULL << shift) - 1;
+  inverse = osl_int_inverse(d);
+  limit = ULLONG_MAX / d;
+  for (i = 0; i < size; i++) {
+    a = (array[i] < 0) ? 0ULL - (unsigned long long int)array[i]
+                       : (unsigned long long int)array[i];
+    fail |= ((a & mask) != 0) | (((a >> shift) * inverse) > limit);
+  }
+  if (!fail)
+    return gcd;
+
+  for (i = 0; (i < size) && (gcd != 1); i++)
+    if (array[i] != 0)
+      gcd = (unsigned long long int)llabs(llgcd((long long int)gcd, array[i]));
+  return gcd;
+}
+
+// Inverse of an odd integer modulo 2^64 (hence modulo any smaller power of
+// 2) by Newton's iteration: each step doubles the number of exact bits,
+// starting from the 3 bits of d * d = 1 (mod 8).
+unsigned long long int osl_int_inverse(unsigned long long int d) {
+  unsigned long long int inverse = d;
+  int i;
+
+  for (i = 0; i < 5; i++)
+    inverse *= 2 - d * inverse;
+  return inverse;
+}
+
+// Returns 1 if |array1[i] + factor * array2[i]| <= max for any elements
+// bounded by max1 and max2 in absolute value, 0 if it may overflow.
+int osl_int_addmul_fits(unsigned long long int max1,
+                        unsigned long long int max2,
+                        unsigned long long int factor,
+                        unsigned long long int max) {
+  if ((factor == 0) || (max2 == 0))
+    return max1 <= max;
+
+  return (max2 <= max / factor) && (max1 <= max - factor * max2);
+}
+
+/**
+ * \brief array[i] = -array[i] for 0 <= i < size
+ * \param[in]     precision Precision of the osl ints
+ * \param[in,out] array     Array of osl ints to oppose
+ * \param[in]     size      Number of elements of the array
+ */
+void osl_int_oppose_array(const int precision, osl_int_t* const array,
+                          const size_t size) {
+  size_t i;
+
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      if (OSL_INT_SP_PACKED) {
+        osl_int_oppose_sp(&array->sp, size);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array[i].sp = -array[i].sp;
+      break;
+
+    case OSL_PRECISION_DP:
+      if (OSL_INT_DP_PACKED) {
+        osl_int_oppose_dp(&array->dp, size);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array[i].dp = -array[i].dp;
+      break;
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP:
+      for (i = 0; i < size; i++)
+        mpz_neg(*array[i].mp, *array[i].mp);
+      break;
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
+/**
+ * osl_int_addmul_array_fits internal function:
+ * this function returns 1 if array1[i] + factor * array2[i] cannot overflow
+ * for any 0 <= i < size, computed on the bounds of the operands with the
+ * vector kernels, and 0 if it may overflow or if the osl ints are not
+ * packed (see OSL_INT_SP_PACKED).
+ * \param[in] precision Precision of the osl ints (SP or DP)
+ * \param[in] array1    Array of osl ints to update
+ * \param[in] array2    Array of osl ints to add
+ * \param[in] size      Number of elements of the arrays
+ * \param[in] factor    Factor of the elements of array2
+ * \return 1 if no element may overflow, 0 otherwise.
+ */
+int osl_int_addmul_array_fits(const int precision,
+                              const osl_int_t* const array1,
+                              const osl_int_t* const array2, const size_t size,
+                              const osl_int_t factor) {
+  if ((precision == OSL_PRECISION_SP) && OSL_INT_SP_PACKED)
+    return osl_int_addmul_fits(osl_int_max_abs_sp(&array1->sp, size),
+                               osl_int_max_abs_sp(&array2->sp, size),
+                               osl_int_max_abs_sp(&factor.sp, 1), LONG_MAX);
+
+  if ((precision == OSL_PRECISION_DP) && OSL_INT_DP_PACKED)
+    return osl_int_addmul_fits(osl_int_max_abs_dp(&array1->dp, size),
+                               osl_int_max_abs_dp(&array2->dp, size),
+                               osl_int_max_abs_dp(&factor.dp, 1), LLONG_MAX);
+
+  return 0;
+}
+
+/**
+ * \brief array1[i] += factor * array2[i] for 0 <= i < size
+ *
+ * Overflows are checked only when NDEBUG is not defined, as for the scalar
+ * operations: on the bounds of the operands first, so that the vector
+ * kernels still run when no element may overflow, then element by element
+ * otherwise.
+ * \param[in]     precision Precision of the osl ints
+ * \param[in,out] array1    Array of osl ints to update
+ * \param[in]     array2    Array of osl ints to add (must not overlap array1)
+ * \param[in]     size      Number of elements of the arrays
+ * \param[in]     factor    Factor of the elements of array2
+ */
+void osl_int_addmul_array(const int precision, osl_int_t* const array1,
+                          const osl_int_t* const array2, const size_t size,
+                          const osl_int_t factor) {
+  size_t i;
+#ifndef NDEBUG
+  osl_int_t product;
+
+  if ((precision != OSL_PRECISION_MP) &&
+      !osl_int_addmul_array_fits(precision, array1, array2, size, factor)) {
+    osl_int_init(precision, &product);
+    for (i = 0; i < size; i++) {
+      osl_int_mul(precision, &product, factor, array2[i]);
+      osl_int_add(precision, &array1[i], array1[i], product);
+    }
+    osl_int_clear(precision, &product);
+    return;
+  }
+#endif
+
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      if (OSL_INT_SP_PACKED) {
+        osl_int_addmul_sp(&array1->sp, &array2->sp, size, factor.sp);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array1[i].sp += factor.sp * array2[i].sp;
+      break;
+
+    case OSL_PRECISION_DP:
+      if (OSL_INT_DP_PACKED) {
+        osl_int_addmul_dp(&array1->dp, &array2->dp, size, factor.dp);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array1[i].dp += factor.dp * array2[i].dp;
+      break;
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP:
+      for (i = 0; i < size; i++)
+        mpz_addmul(*array1[i].mp, *factor.mp, *array2[i].mp);
+      break;
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
+/**
+ * \brief array[i] = array[i] / divisor for 0 <= i < size
+ *
+ * Every element of the array must be divisible by the divisor (the results
+ * are undefined otherwise), which lets SP and DP divide by multiplying with
+ * an inverse, in vector passes.
+ * \param[in]     precision Precision of the osl ints
+ * \param[in,out] array     Array of osl ints to divide
+ * \param[in]     size      Number of elements of the array
+ * \param[in]     divisor   Value of the divisor (non-zero)
+ */
+void osl_int_div_exact_array(const int precision, osl_int_t* const array,
+                             const size_t size, const osl_int_t divisor) {
+  size_t i;
+
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      if (OSL_INT_SP_PACKED) {
+        osl_int_div_exact_sp(&array->sp, size, divisor.sp);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array[i].sp /= divisor.sp;
+      break;
+
+    case OSL_PRECISION_DP:
+      if (OSL_INT_DP_PACKED) {
+        osl_int_div_exact_dp(&array->dp, size, divisor.dp);
+        break;
+      }
+      for (i = 0; i < size; i++)
+        array[i].dp /= divisor.dp;
+      break;
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP:
+      for (i = 0; i < size; i++)
+        mpz_divexact(*array[i].mp, *array[i].mp, *divisor.mp);
+      break;
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
+/**
+ * \brief gcd = gcd(array[0], ..., array[size - 1])
+ *
+ * The gcd is non-negative, and it is 0 if every element is 0. In SP and DP,
+ * the smallest non-zero absolute value is tried first, in vector passes,
+ * and Euclid's algorithm only runs if it does not divide every element.
+ * The computation stops as soon as the gcd reaches 1.
+ * \param[in]  precision Precision of the osl ints
+ * \param[out] gcd       Greatest common divisor of the elements
+ * \param[in]  array     Array of osl ints
+ * \param[in]  size      Number of elements of the array
+ */
+void osl_int_gcd_array(const int precision, osl_int_t* const gcd,
+                       const osl_int_t* const array, const size_t size) {
+  size_t i;
+
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      if (OSL_INT_SP_PACKED) {
+        gcd->sp = (long int)osl_int_gcd_sp(&array->sp, size);
+        break;
+      }
+      gcd->sp = 0;
+      for (i = 0; (i < size) && (gcd->sp != 1); i++)
+        if (array[i].sp != 0)
+          gcd->sp = labs((long int)llgcd(gcd->sp, array[i].sp));
+      break;
+
+    case OSL_PRECISION_DP:
+      if (OSL_INT_DP_PACKED) {
+        gcd->dp = (long long int)osl_int_gcd_dp(&array->dp, size);
+        break;
+      }
+      gcd->dp = 0;
+      for (i = 0; (i < size) && (gcd->dp != 1); i++)
+        if (array[i].dp != 0)
+          gcd->dp = llabs(llgcd(gcd->dp, array[i].dp));
+      break;
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP:
+      mpz_set_ui(*gcd->mp, 0);
+      for (i = 0; (i < size) && (mpz_cmp_ui(*gcd->mp, 1) != 0); i++)
+        if (mpz_sgn(*array[i].mp) != 0)
+          mpz_gcd(*gcd->mp, *gcd->mp, *array[i].mp);
+      break;
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
 /******************************************************************************
  *                            Conditional Operations                          *
  ******************************************************************************/
@@ -1369,6 +1828,54 @@ int osl_int_ne(const int precision, const osl_int_t val1,
   return !osl_int_eq(precision, val1, val2);
 }
 
+/**
+ * \brief array1[i] == array2[i] for 0 <= i < size
+ *
+ * The precision is checked once for the whole arrays, and SP/DP arrays are
+ * compared with memcmp() when their elements fill the osl_int_t union.
+ * \param[in] precision Precision of the osl ints
+ * \param[in] array1    First array of osl ints
+ * \param[in] array2    Second array of osl ints
+ * \param[in] size      Number of elements to compare
+ * \return 1 if the arrays are equal element-wise, 0 otherwise
+ */
+int osl_int_eq_array(const int precision, const osl_int_t* const array1,
+                     const osl_int_t* const array2, const size_t size) {
+  size_t i;
+
+  if ((array1 == array2) || (size == 0))
+    return 1;
+
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      if (sizeof(long int) == sizeof(osl_int_t))
+        return !memcmp(array1, array2, size * sizeof(osl_int_t));
+      for (i = 0; i < size; i++)
+        if (array1[i].sp != array2[i].sp)
+          return 0;
+      return 1;
+
+    case OSL_PRECISION_DP:
+      if (sizeof(long long int) == sizeof(osl_int_t))
+        return !memcmp(array1, array2, size * sizeof(osl_int_t));
+      for (i = 0; i < size; i++)
+        if (array1[i].dp != array2[i].dp)
+          return 0;
+      return 1;
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP:
+      for (i = 0; i < size; i++)
+        if (mpz_cmp(*array1[i].mp, *array2[i].mp) != 0)
+          return 0;
+      return 1;
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
 /**
  * \brief val1 < val2
  * \param[in] precision Precision of the osl int
@@ -1611,6 +2118,52 @@ int osl_int_divisible(const int precision, const osl_int_t val1,
   }
 }
 
+/**
+ * \brief Hash an osl int
+ *
+ * The hash only depends on the integer value, not on its precision: a value
+ * hashes the same in single, double and multiple precision.
+ * \param[in] precision Precision of the osl int
+ * \param[in] value     Value in a osl int
+ * \return the 64-bit hash of the value
+ */
+uint64_t osl_int_hash(const int precision, const osl_int_t value) {
+  switch (precision) {
+    case OSL_PRECISION_SP:
+      return osl_util_hash_combine(0, (uint64_t)(long long int)value.sp);
+
+    case OSL_PRECISION_DP:
+      return osl_util_hash_combine(0, (uint64_t)value.dp);
+
+#ifdef OSL_GMP_IS_HERE
+    case OSL_PRECISION_MP: {
+      uint64_t hash = 0;
+      mp_size_t i, size = (mp_size_t)mpz_size(*value.mp);
+
+      if (mpz_sizeinbase(*value.mp, 2) < 64) {
+        // Fits in a long long int: hash it the same way as SP/DP values.
+        uint64_t magnitude = 0;
+        for (i = 0; i < size; i++)
+          magnitude |= (uint64_t)mpz_getlimbn(*value.mp, i)
+                       << ((size_t)i * GMP_NUMB_BITS);
+        if (mpz_sgn(*value.mp) < 0)
+          magnitude = -magnitude;
+        return osl_util_hash_combine(0, magnitude);
+      }
+
+      hash = osl_util_hash_combine(hash, (uint64_t)mpz_sgn(*value.mp));
+      for (i = 0; i < size; i++)
+        hash = osl_util_hash_combine(hash,
+                                     (uint64_t)mpz_getlimbn(*value.mp, i));
+      return hash;
+    }
+#endif
+
+    default:
+      OSL_error("unknown precision");
+  }
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
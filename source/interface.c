@@ -58,6 +58,7 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -80,8 +81,30 @@
 #include <osl/extensions/symbols.h>
 #include <osl/extensions/textual.h>
 #include <osl/interface.h>
+#include <osl/macros.h>
 #include <osl/relation.h>
 #include <osl/strings.h>
+#include <osl/util.h>
+
+// Frozen registry: its nodes chained as a list, the same nodes standalone
+// (for the generics), a hash table of their ranks + 1 by URI and the buffer
+// of their URIs (the atoms). It is published once, atomically, see
+// osl_interface_get_frozen_registry().
+struct osl_interface_frozen {
+  osl_interface_p list;
+  osl_interface_p single;
+  size_t nb_slots;
+  int* slot;
+  char* atoms;
+  size_t atoms_size;
+};
+static _Atomic(struct osl_interface_frozen*) osl_interface_frozen = NULL;
+
+static osl_interface_t* osl_interface_copy(const osl_interface_t*, int);
+static int osl_interface_frozen_rank(const struct osl_interface_frozen*,
+                                     const char*);
+static struct osl_interface_frozen* osl_interface_freeze(void);
+static void osl_interface_unfreeze(struct osl_interface_frozen*);
 
 /******************************************************************************
  *                          Structure display function                        *
@@ -171,7 +194,8 @@ void osl_interface_dump(FILE* const file,
  * \param interface The interface to add to the list.
  */
 void osl_interface_add(osl_interface_t** list, osl_interface_t* interface) {
-  osl_interface_p tmp = *list, check_interface;
+  osl_interface_p tmp, check_interface;
+  osl_interface_p* location;
 
   if (interface != NULL) {
     // First, check that the interface list is OK.
@@ -185,6 +209,15 @@ void osl_interface_add(osl_interface_t** list, osl_interface_t* interface) {
       check_interface = check_interface->next;
     }
 
+    // Frozen interfaces are shared: copy them before modifying the list.
+    for (location = list; *location != NULL; location = &(*location)->next) {
+      if ((*location)->frozen) {
+        *location = osl_interface_copy(*location, -1);
+        break;
+      }
+    }
+
+    tmp = *list;
     if (*list != NULL) {
       while (tmp->next != NULL)
         tmp = tmp->next;
@@ -215,6 +248,8 @@ osl_interface_t* osl_interface_malloc(void) {
   interface->free = NULL;
   interface->clone = NULL;
   interface->equal = NULL;
+  interface->hash = NULL;
+  interface->frozen = 0;
   interface->next = NULL;
 
   return interface;
@@ -223,18 +258,19 @@ osl_interface_t* osl_interface_malloc(void) {
 /**
  * osl_interface_free function:
  * this function frees the allocated memory for an osl_interface_t
- * structure, and all the interfaces stored in the list.
+ * structure, and all the interfaces stored in the list. Frozen interfaces
+ * (and the rest of the list after them, which is frozen too) are ignored.
  * \param[in] interface The pointer to the interface we want to free.
  */
 void osl_interface_free(osl_interface_t* interface) {
   osl_interface_p tmp;
   int i = 0;
 
-  while (interface != NULL) {
+  while ((interface != NULL) && !interface->frozen) {
     tmp = interface->next;
     if (interface->URI != NULL)
-      free(interface->URI);
-    free(interface);
+      OSL_free(interface->URI);
+    OSL_free(interface);
     interface = tmp;
     i++;
   }
@@ -264,32 +300,27 @@ int osl_interface_number(const osl_interface_t* interface) {
 /**
  * osl_interface_nclone function:
  * This function builds and returns a "hard copy" (not a pointer copy) of the
- * n first elements of an osl_interface_t list.
+ * n first elements of an osl_interface_t list. Frozen interfaces are not
+ * copied: the frozen interface itself is returned when one node or the
+ * whole (frozen) rest of the list is requested.
  * \param interface The pointer to the interface structure we want to clone.
  * \param n         The number of nodes we want to copy (-1 for infinity).
  * \return The clone of the n first nodes of the interface list.
  */
 osl_interface_t* osl_interface_nclone(const osl_interface_t* interface, int n) {
-  osl_interface_p clone = NULL, new;
-  int i = 0;
-
-  while ((interface != NULL) && ((n == -1) || (i < n))) {
-    new = osl_interface_malloc();
-    OSL_strdup(new->URI, interface->URI);
-    new->idump = interface->idump;
-    new->sprint = interface->sprint;
-    new->sread = interface->sread;
-    new->malloc = interface->malloc;
-    new->free = interface->free;
-    new->clone = interface->clone;
-    new->equal = interface->equal;
-
-    osl_interface_add(&clone, new);
-    interface = interface->next;
-    i++;
+  struct osl_interface_frozen* frozen;
+  int k;
+
+  if ((interface != NULL) && interface->frozen && (n != 0)) {
+    frozen = atomic_load_explicit(&osl_interface_frozen, memory_order_acquire);
+    k = interface->frozen - 1;
+    if ((n == 1) || (interface->next == NULL))
+      return &frozen->single[k];
+    if (n == -1)
+      return &frozen->list[k];
   }
 
-  return clone;
+  return osl_interface_copy(interface, n);
 }
 
 /**
@@ -327,7 +358,8 @@ bool osl_interface_equal(const osl_interface_t* const interface1,
       (interface1->malloc != interface2->malloc) ||
       (interface1->free != interface2->free) ||
       (interface1->clone != interface2->clone) ||
-      (interface1->equal != interface2->equal))
+      (interface1->equal != interface2->equal) ||
+      (interface1->hash != interface2->hash))
     return 0;
 
   return 1;
@@ -337,16 +369,27 @@ bool osl_interface_equal(const osl_interface_t* const interface1,
  * osl_interface_lookup function:
  * this function returns the first interface with a given URI in the
  * interface list provided as parameter and NULL if it doesn't find such
- * an interface.
+ * an interface. The frozen part of the list, if any, is searched by hashing.
  * \param list The interface list where to search a given interface URI.
  * \param URI  The URI of the interface we are looking for.
  * \return The first interface of the requested URI in the list.
  */
 osl_interface_t* osl_interface_lookup(osl_interface_t* list, const char* URI) {
+  struct osl_interface_frozen* frozen;
+  int k;
+
   if (URI == NULL) {
     OSL_warning("lookup for a NULL URI");
   } else {
     while (list != NULL) {
+      if (list->frozen && (list->next != NULL)) {
+        frozen =
+            atomic_load_explicit(&osl_interface_frozen, memory_order_acquire);
+        k = osl_interface_frozen_rank(frozen, URI);
+        return (k >= list->frozen - 1) ? &frozen->list[k] : NULL;
+      }
+
+
       if ((list->URI != NULL) && (!strcmp(list->URI, URI)))
         return list;
 
@@ -391,3 +434,202 @@ osl_interface_t* osl_interface_get_default_registry(void) {
 
   return registry;
 }
+
+/**
+ * osl_interface_get_frozen_registry function:
+ * this function returns the process-wide frozen registry: a list of the
+ * default interfaces (see osl_interface_get_default_registry()) built once
+ * and shared by reference. Scops and generics read with it point to its
+ * interfaces instead of owning copies, and its URIs are looked up by
+ * hashing. It must not be modified (osl_interface_add() copies it first),
+ * and it lives until the end of the process: it is allocated with malloc(),
+ * out of any arena and allocator hooks, and osl_interface_free() ignores it.
+ * It may be requested concurrently from any threads: a thread that does not
+ * find it builds one and publishes it with an atomic compare-and-swap, and
+ * threads that lose the race free their own and use the published one.
+ * \return The frozen registry.
+ */
+osl_interface_t* osl_interface_get_frozen_registry(void) {
+  struct osl_interface_frozen *frozen, *built;
+
+  frozen = atomic_load_explicit(&osl_interface_frozen, memory_order_acquire);
+  if (frozen == NULL) {
+    built = osl_interface_freeze();
+    if (atomic_compare_exchange_strong_explicit(
+            &osl_interface_frozen, &frozen, built, memory_order_acq_rel,
+            memory_order_acquire))
+      frozen = built;
+    else
+      osl_interface_unfreeze(built);
+  }
+
+  return frozen->list;
+}
+
+/**
+ * osl_interface_atom function:
+ * this function returns the atom of a URI: the string of the frozen
+ * registry which is equal to it. Atoms are unique, hence two atoms are
+ * equal if and only if they are the same pointer, and the URI of a frozen
+ * interface is an atom (e.g., the URI of any generic read with the frozen
+ * registry), so comparing it with an atom is a pointer compare.
+ * \param[in] URI The URI whose atom is requested.
+ * \return The atom of the URI, NULL if it is not in the frozen registry.
+ */
+const char* osl_interface_atom(const char* URI) {
+  struct osl_interface_frozen* frozen;
+  int k;
+
+  if (URI == NULL)
+    return NULL;
+
+  osl_interface_get_frozen_registry();
+  frozen = atomic_load_explicit(&osl_interface_frozen, memory_order_acquire);
+  k = osl_interface_frozen_rank(frozen, URI);
+  return (k >= 0) ? frozen->list[k].URI : NULL;
+}
+
+/**
+ * osl_interface_is_atom function:
+ * this function returns 1 if a string is an atom (see osl_interface_atom()),
+ * i.e., a URI of the frozen registry itself and not only an equal string,
+ * and 0 otherwise. It only compares addresses, hence two atoms are compared
+ * in constant time.
+ * \param[in] URI The string to test.
+ * \return 1 if URI is an atom, 0 otherwise.
+ */
+int osl_interface_is_atom(const char* URI) {
+  struct osl_interface_frozen* frozen;
+  uintptr_t address = (uintptr_t)URI;
+
+  frozen = atomic_load_explicit(&osl_interface_frozen, memory_order_acquire);
+  if ((frozen == NULL) || (URI == NULL))
+    return 0;
+
+  return (address >= (uintptr_t)frozen->atoms) &&
+         (address < (uintptr_t)frozen->atoms + frozen->atoms_size);
+}
+
+/**
+ * osl_interface_copy internal function:
+ * this function builds and returns a "hard copy" of the n first elements of
+ * an osl_interface_t list, frozen interfaces included.
+ * \param interface The pointer to the interface structure we want to copy.
+ * \param n         The number of nodes we want to copy (-1 for infinity).
+ * \return The copy of the n first nodes of the interface list.
+ */
+osl_interface_t* osl_interface_copy(const osl_interface_t* interface, int n) {
+  osl_interface_p clone = NULL, new;
+  int i = 0;
+
+  while ((interface != NULL) && ((n == -1) || (i < n))) {
+    new = osl_interface_malloc();
+    OSL_strdup(new->URI, interface->URI);
+    new->idump = interface->idump;
+    new->sprint = interface->sprint;
+    new->sread = interface->sread;
+    new->malloc = interface->malloc;
+    new->free = interface->free;
+    new->clone = interface->clone;
+    new->equal = interface->equal;
+    new->hash = interface->hash;
+
+    osl_interface_add(&clone, new);
+    interface = interface->next;
+    i++;
+  }
+
+  return clone;
+}
+
+/**
+ * osl_interface_frozen_rank internal function:
+ * this function returns the rank of the interface of a given URI in the
+ * frozen registry.
+ * \param frozen The frozen registry.
+ * \param URI    The URI of the interface we are looking for.
+ * \return The rank of the interface, -1 if it is not in the registry.
+ */
+int osl_interface_frozen_rank(const struct osl_interface_frozen* frozen,
+                              const char* URI) {
+  size_t mask = frozen->nb_slots - 1;
+  size_t h = (size_t)osl_util_hash_string(0, URI) & mask;
+  int k;
+
+  for (; frozen->slot[h] != 0; h = (h + 1) & mask) {
+    k = frozen->slot[h] - 1;
+    if (!strcmp(frozen->list[k].URI, URI))
+      return k;
+  }
+  return -1;
+}
+
+/**
+ * osl_interface_freeze internal function:
+ * this function builds a frozen registry from the default registry, and
+ * returns it without publishing it.
+ * \return The new frozen registry.
+ */
+struct osl_interface_frozen* osl_interface_freeze(void) {
+  osl_interface_p registry = osl_interface_get_default_registry();
+  osl_interface_p interface;
+  osl_interface_p list, single;
+  int k, n = osl_interface_number(registry);
+  size_t h, mask, nb_slots = 16, atoms_size = 0;
+  int* slot;
+  char *atoms, *atom;
+  struct osl_interface_frozen* frozen;
+
+  while (nb_slots < 2 * (size_t)n)
+    nb_slots *= 2;
+  for (interface = registry; interface != NULL; interface = interface->next)
+    atoms_size += strlen(interface->URI) + 1;
+  frozen = (struct osl_interface_frozen*)malloc(sizeof(*frozen));
+  list = (osl_interface_p)malloc((size_t)n * sizeof(osl_interface_t));
+  single = (osl_interface_p)malloc((size_t)n * sizeof(osl_interface_t));
+  slot = (int*)calloc(nb_slots, sizeof(int));
+  atoms = (char*)malloc(atoms_size);
+  if ((frozen == NULL) || (list == NULL) || (single == NULL) ||
+      (slot == NULL) || (atoms == NULL))
+    OSL_error("memory overflow");
+
+  // The URIs are stored in a single buffer to recognize atoms by address.
+  mask = nb_slots - 1;
+  atom = atoms;
+  for (k = 0, interface = registry; k < n; k++, interface = interface->next) {
+    list[k] = *interface;
+    list[k].URI = strcpy(atom, interface->URI);
+    atom += strlen(atom) + 1;
+    list[k].frozen = k + 1;
+    list[k].next = (k + 1 < n) ? &list[k + 1] : NULL;
+    single[k] = list[k];
+    single[k].next = NULL;
+
+    h = (size_t)osl_util_hash_string(0, list[k].URI) & mask;
+    while (slot[h] != 0)
+      h = (h + 1) & mask;
+    slot[h] = k + 1;
+  }
+  osl_interface_free(registry);
+
+  frozen->nb_slots = nb_slots;
+  frozen->slot = slot;
+  frozen->atoms = atoms;
+  frozen->atoms_size = atoms_size;
+  frozen->single = single;
+  frozen->list = list;
+  return frozen;
+}
+
+/**
+ * osl_interface_unfreeze internal function:
+ * this function frees a frozen registry which has not been published.
+ * \param frozen The frozen registry to free.
+ */
+void osl_interface_unfreeze(struct osl_interface_frozen* frozen) {
+  free(frozen->atoms);
+  free(frozen->list);
+  free(frozen->single);
+  free(frozen->slot);
+  free(frozen);
+}
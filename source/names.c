@@ -168,7 +168,7 @@ void osl_names_free(osl_names_t* names) {
     osl_strings_free(names->local_dims);
     osl_strings_free(names->arrays);
 
-    free(names);
+    OSL_free(names);
   }
 }
 
@@ -63,14 +63,37 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <osl/arena.h>
 #include <osl/int.h>
 #include <osl/macros.h>
 #include <osl/names.h>
 #include <osl/relation.h>
+#include <osl/relation_array.h>
 #include <osl/strings.h>
 #include <osl/util.h>
 #include <osl/vector.h>
 
+// Projection job shared by the threads of osl_relation_project_out().
+struct osl_relation_projection {
+  int first;  /**< First column to project out */
+  int count;  /**< Number of columns to project out */
+  int* exact; /**< For each part, 1 if its projection is exact */
+};
+typedef struct osl_relation_projection osl_relation_projection_t;
+typedef struct osl_relation_projection* osl_relation_projection_p;
+
+// Simplex tableau of osl_relation_is_empty() (see osl_relation_tableau_malloc).
+struct osl_relation_tableau {
+  int precision;    /**< Precision of the elements */
+  int nb_rows;      /**< Number of constraint rows, the objective excluded */
+  int nb_vars;      /**< Number of variables */
+  int* basis;       /**< Basic variable of each row (-1 for the objective) */
+  osl_int_t* denom; /**< Positive denominator of each row */
+  osl_int_t** row;  /**< Constant then variable coefficients of each row */
+};
+typedef struct osl_relation_tableau osl_relation_tableau_t;
+typedef struct osl_relation_tableau* osl_relation_tableau_p;
+
 static char* osl_relation_sprint_type(const osl_relation_t*);
 static void osl_relation_print_type(FILE*, const osl_relation_t*);
 static char* osl_relation_expression_element(const osl_int_t, int, int*, int,
@@ -88,6 +111,54 @@ static osl_names_t* osl_relation_names(const osl_relation_t*);
 static int osl_relation_read_type(FILE*, char**);
 static int osl_relation_check_attribute(int*, int);
 static int osl_relation_check_nb_columns(const osl_relation_t*, int, int, int);
+static osl_relation_t* osl_relation_pread_storage(FILE*, int, int);
+static osl_relation_t* osl_relation_psread_polylib_storage(char**, int, int);
+static osl_relation_t* osl_relation_sparse_pmalloc(int, int, int, int);
+static osl_relation_t* osl_relation_sparse_nclone(const osl_relation_t*, int);
+static void osl_relation_sparse_append(osl_relation_t*, int, const osl_int_t);
+static int osl_relation_sparse_position(const osl_relation_sparse_t*, int,
+                                        int);
+static osl_relation_t* osl_relation_dense_nclone(const osl_relation_t*, int);
+static bool osl_relation_sparse_part_equal(const osl_relation_t*,
+                                           const osl_relation_t*);
+static osl_relation_t* osl_relation_storage_clone(const osl_relation_t*, int);
+static uint64_t osl_relation_storage_hash(const osl_relation_t*);
+static bool osl_relation_storage_equal(const osl_relation_t*,
+                                       const osl_relation_t*);
+static osl_relation_t* osl_relation_shared_clone(const osl_relation_t*);
+static osl_relation_t* osl_relation_copy(const osl_relation_t*, int, int);
+static void osl_relation_shared_make(osl_relation_t*);
+static void osl_relation_part_unshare(osl_relation_t*);
+static void osl_relation_part_to_dense(osl_relation_t*);
+static osl_relation_shared_t* osl_relation_table_lookup(
+    const osl_relation_table_t*, const osl_relation_t*, uint64_t);
+static void osl_relation_table_insert(osl_relation_table_t*,
+                                      osl_relation_shared_t*);
+static void osl_relation_table_remove(osl_relation_table_t*,
+                                      const osl_relation_shared_t*);
+static int osl_relation_row_compare(int, int, const osl_int_t*,
+                                    const osl_int_t*);
+static int osl_relation_row_reduce(int, int, osl_int_t*);
+static void osl_relation_part_canonicalize(osl_relation_t*);
+static void osl_relation_row_combine(int, int, int, osl_int_t*, const osl_int_t,
+                                     const osl_int_t*, const osl_int_t,
+                                     const osl_int_t*);
+static void osl_relation_part_tighten(osl_relation_t*);
+static int osl_relation_part_eliminate(osl_relation_t*, int);
+static long osl_relation_part_eliminate_nb_rows(const osl_relation_t*, int);
+static void osl_relation_project_part(osl_relation_t*, int, void*);
+static int osl_relation_part_is_infeasible(const osl_relation_t*);
+static int osl_relation_part_solve_equalities(osl_relation_t*);
+static osl_relation_tableau_t* osl_relation_tableau_malloc(
+    const osl_relation_t*);
+static void osl_relation_tableau_free(osl_relation_tableau_t*);
+static void osl_relation_tableau_normalize(osl_relation_tableau_t*, int);
+static void osl_relation_tableau_pivot(osl_relation_tableau_t*, int, int);
+static int osl_relation_tableau_is_feasible(osl_relation_tableau_t*);
+static int osl_relation_tableau_fractional(const osl_relation_tableau_t*, int,
+                                          osl_int_t*);
+static int osl_relation_part_is_integer_empty(osl_relation_t*, int*);
+static int osl_relation_part_array_id(const osl_relation_t*, int);
 
 /******************************************************************************
  *                          Structure display function                        *
@@ -158,7 +229,7 @@ char* osl_relation_sprint_type(const osl_relation_t* relation) {
 void osl_relation_print_type(FILE* const file, const osl_relation_t* relation) {
   char* string = osl_relation_sprint_type(relation);
   fprintf(file, "%s", string);
-  free(string);
+  OSL_free(string);
 }
 
 /**
@@ -174,6 +245,15 @@ void osl_relation_print_type(FILE* const file, const osl_relation_t* relation) {
 void osl_relation_idump(FILE* const file, const osl_relation_t* relation,
                         int level) {
   int i, j, first = 1;
+  osl_relation_p dense;
+
+  // Sparse relations are displayed through a dense copy.
+  if (osl_relation_is_sparse(relation)) {
+    dense = osl_relation_dense_nclone(relation, -1);
+    osl_relation_idump(file, dense, level);
+    osl_relation_free(dense);
+    return;
+  }
 
   // Go to the right level.
   for (j = 0; j < level; j++)
@@ -255,6 +335,61 @@ void osl_relation_dump(FILE* const file, const osl_relation_t* const relation) {
   osl_relation_idump(file, relation, 0);
 }
 
+/**
+ * osl_relation_table_idump function:
+ * this function displays an osl_relation_table_t structure (*table) into a
+ * file (file, possibly stdout) in a way that trends to be understandable. It
+ * includes an indentation level (level) in order to work with others idump
+ * functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] table The interning table whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_relation_table_idump(FILE* const file,
+                              const osl_relation_table_t* const table,
+                              int level) {
+  int j;
+  size_t i;
+  const osl_relation_shared_t* entry;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (table != NULL) {
+    fprintf(file, "+-- osl_relation_table_t: %zu matrix(es), %zu bucket(s)\n",
+            table->nb_entries, table->nb_buckets);
+    for (i = 0; i < table->nb_buckets; i++) {
+      for (entry = table->bucket[i]; entry != NULL; entry = entry->next) {
+        for (j = 0; j <= level; j++)
+          fprintf(file, "|\t");
+        fprintf(file, "%d x %d %s matrix, %d reference(s)\n", entry->nb_rows,
+                entry->nb_columns, (entry->sparse != NULL) ? "sparse" : "dense",
+                entry->refcount);
+      }
+    }
+  } else {
+    fprintf(file, "+-- NULL relation table\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_relation_table_dump function:
+ * this function prints the content of an osl_relation_table_t structure
+ * (*table) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] table The interning table whose information has to be printed.
+ */
+void osl_relation_table_dump(FILE* const file,
+                             const osl_relation_table_t* const table) {
+  osl_relation_table_idump(file, table, 0);
+}
+
 /**
  * osl_relation_expression_element function:
  * this function returns a string containing the printing of a value (e.g.,
@@ -323,8 +458,8 @@ char* osl_relation_expression_element(const osl_int_t val, int precision,
       }
     }
   }
-  free(temp);
-  free(body);
+  OSL_free(temp);
+  OSL_free(body);
 
   return (sval);
 }
@@ -442,7 +577,7 @@ char* osl_relation_subexpression(const osl_relation_t* relation, int row,
                      relation->m[row][i]);
     }
     strcat(sline, sval);
-    free(sval);
+    OSL_free(sval);
   }
 
   return sline;
@@ -459,6 +594,16 @@ char* osl_relation_subexpression(const osl_relation_t* relation, int row,
  */
 char* osl_relation_expression(const osl_relation_t* relation, int row,
                               char** strings) {
+  char* expression;
+  osl_relation_p dense;
+
+  if (relation->sparse != NULL) {
+    dense = osl_relation_dense_nclone(relation, 1);
+    expression = osl_relation_expression(dense, row, strings);
+    osl_relation_free(dense);
+    return expression;
+  }
+
   return osl_relation_subexpression(relation, row, 1, relation->nb_columns - 1,
                                     0, strings);
 }
@@ -547,7 +692,7 @@ char* osl_relation_sprint_comment(const osl_relation_t* relation, int row,
         relation, row, 1, relation->nb_output_dims, sign < 0, strings);
     snprintf(buffer, OSL_MAX_STRING, "   ## %s", expression);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
-    free(expression);
+    OSL_free(expression);
 
     // We don't print the right hand side if it's an array identifier.
     if (!osl_relation_is_access(relation) ||
@@ -557,7 +702,7 @@ char* osl_relation_sprint_comment(const osl_relation_t* relation, int row,
           sign > 0, strings);
       snprintf(buffer, OSL_MAX_STRING, " == %s", expression);
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      free(expression);
+      OSL_free(expression);
     } else {
       snprintf(buffer, OSL_MAX_STRING, " == %s",
                arrays[osl_relation_get_array_id(relation) - 1]);
@@ -569,7 +714,7 @@ char* osl_relation_sprint_comment(const osl_relation_t* relation, int row,
     expression = osl_relation_expression(relation, row, strings);
     snprintf(buffer, OSL_MAX_STRING, "   ## %s", expression);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
-    free(expression);
+    OSL_free(expression);
 
     if (osl_int_zero(relation->precision, relation->m[row][0]))
       snprintf(buffer, OSL_MAX_STRING, " == 0");
@@ -759,13 +904,19 @@ osl_names_t* osl_relation_names(const osl_relation_t* relation) {
 /**
  * osl_relation_nb_components function:
  * this function returns the number of component in the union of relations
- * provided as parameter.
+ * provided as parameter, in constant time when the union owns an up-to-date
+ * relation array (see osl_relation_array_get()).
  * \param[in] relation The input union of relations.
  * \return The number of components in the input union of relations.
  */
 int osl_relation_nb_components(const osl_relation_t* relation) {
   int nb_components = 0;
 
+  if ((relation != NULL) && (relation->next == NULL))
+    return 1;
+  if (osl_relation_array_is_current(relation))
+    return osl_relation_array_nb_parts(relation->parts);
+
   while (relation != NULL) {
     nb_components++;
     relation = relation->next;
@@ -795,10 +946,19 @@ char* osl_relation_spprint_polylib(const osl_relation_t* relation,
   char* scolumn;
   char* comment;
   osl_names_t* local_names = NULL;
+  osl_relation_p dense;
 
   if (relation == NULL)
     return osl_util_strdup("# NULL relation\n");
 
+  // Sparse relations are printed through a dense copy.
+  if (osl_relation_is_sparse(relation)) {
+    dense = osl_relation_dense_nclone(relation, -1);
+    string = osl_relation_spprint_polylib(dense, names);
+    osl_relation_free(dense);
+    return string;
+  }
+
   OSL_malloc(string, char*, high_water_mark * sizeof(char));
   string[0] = '\0';
 
@@ -837,7 +997,7 @@ char* osl_relation_spprint_polylib(const osl_relation_t* relation,
       scolumn = osl_relation_column_string(relation, name_array);
       snprintf(buffer, OSL_MAX_STRING, "%s", scolumn);
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      free(scolumn);
+      OSL_free(scolumn);
     }
 
     for (i = 0; i < relation->nb_rows; i++) {
@@ -852,7 +1012,7 @@ char* osl_relation_spprint_polylib(const osl_relation_t* relation,
         comment = osl_relation_sprint_comment(relation, i, name_array,
                                               names->arrays->string);
         osl_util_safe_strcat(&string, comment, &high_water_mark);
-        free(comment);
+        OSL_free(comment);
       }
       snprintf(buffer, OSL_MAX_STRING, "\n");
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
@@ -861,8 +1021,8 @@ char* osl_relation_spprint_polylib(const osl_relation_t* relation,
     // Free the array of strings.
     if (name_array != NULL) {
       for (i = 0; i < relation->nb_columns; i++)
-        free(name_array[i]);
-      free(name_array);
+        OSL_free(name_array[i]);
+      OSL_free(name_array);
     }
 
     relation = relation->next;
@@ -904,10 +1064,20 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation_t* relation,
   char* scolumn;
   char* comment;
   osl_names_t* local_names = NULL;
+  osl_relation_p dense;
 
   if (relation == NULL)
     return osl_util_strdup("# NULL relation\n");
 
+  // Sparse relations are printed through a dense copy.
+  if (osl_relation_is_sparse(relation)) {
+    dense = osl_relation_dense_nclone(relation, -1);
+    string = osl_relation_spprint_polylib_scoplib(dense, names, print_nth_part,
+                                                  add_fakeiter);
+    osl_relation_free(dense);
+    return string;
+  }
+
   OSL_malloc(string, char*, high_water_mark * sizeof(char));
   string[0] = '\0';
 
@@ -998,7 +1168,7 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation_t* relation,
         scolumn = osl_relation_column_string_scoplib(relation, name_array);
         snprintf(buffer, OSL_MAX_STRING, "%s", scolumn);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
-        free(scolumn);
+        OSL_free(scolumn);
       }
 
       start_row = 0;
@@ -1089,7 +1259,7 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation_t* relation,
         comment = osl_relation_sprint_comment(relation, i, name_array,
                                               names->arrays->string);
         osl_util_safe_strcat(&string, comment, &high_water_mark);
-        free(comment);
+        OSL_free(comment);
         snprintf(buffer, OSL_MAX_STRING, "\n");
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
       }
@@ -1114,8 +1284,8 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation_t* relation,
     // Free the array of strings.
     if (name_array != NULL) {
       for (i = 0; i < relation->nb_columns; i++)
-        free(name_array[i]);
-      free(name_array);
+        OSL_free(name_array[i]);
+      OSL_free(name_array);
     }
 
     relation = relation->next;
@@ -1144,17 +1314,17 @@ char* osl_relation_spprint(const osl_relation_t* relation,
   OSL_malloc(string, char*, high_water_mark * sizeof(char));
   string[0] = '\0';
 
-  if (osl_relation_nb_components(relation) > 0) {
+  if (relation != NULL) {
     temp = osl_relation_sprint_type(relation);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
 
     snprintf(buffer, OSL_MAX_STRING, "\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
 
     temp = osl_relation_spprint_polylib(relation, names);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
   }
 
   return string;
@@ -1183,7 +1353,7 @@ char* osl_relation_spprint_scoplib(const osl_relation_t* relation,
     temp = osl_relation_spprint_polylib_scoplib(relation, names, print_nth_part,
                                                 add_fakeiter);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    OSL_free(temp);
   }
 
   return string;
@@ -1201,7 +1371,7 @@ void osl_relation_pprint(FILE* const file, const osl_relation_t* const relation,
                          const osl_names_t* const names) {
   char* string = osl_relation_spprint(relation, names);
   fprintf(file, "%s", string);
-  free(string);
+  OSL_free(string);
 }
 
 /**
@@ -1221,7 +1391,7 @@ void osl_relation_pprint_scoplib(FILE* file,
   char* string = osl_relation_spprint_scoplib(relation, names, print_nth_part,
                                               add_fakeiter);
   fprintf(file, "%s", string);
-  free(string);
+  OSL_free(string);
 }
 
 /**
@@ -1331,6 +1501,32 @@ return_type:
  * \return A pointer to the relation structure that has been read.
  */
 osl_relation_t* osl_relation_pread(FILE* foo, int precision) {
+  return osl_relation_pread_storage(foo, precision, 0);
+}
+
+/**
+ * osl_relation_pread_sparse function ("precision read"):
+ * this function is equivalent to osl_relation_pread() except that the
+ * relation matrices are directly built in sparse form (only the non-zero
+ * elements are stored, see osl_relation_to_sparse()).
+ * \see{osl_relation_pread}
+ */
+osl_relation_t* osl_relation_pread_sparse(FILE* foo, int precision) {
+  return osl_relation_pread_storage(foo, precision, 1);
+}
+
+/**
+ * osl_relation_pread_storage internal function:
+ * this function reads a relation into a file (foo, posibly stdin) and
+ * returns a pointer this relation. The relation matrices are stored either
+ * densely or in sparse form.
+ * \param[in] foo       The input stream.
+ * \param[in] precision The precision of the relation elements.
+ * \param[in] sparse    1 to store the matrices in sparse form, 0 otherwise.
+ * \return A pointer to the relation structure that has been read.
+ */
+osl_relation_t* osl_relation_pread_storage(FILE* foo, int precision,
+                                           int sparse) {
   int i, j, k, n, read = 0;
   int nb_rows, nb_columns;
   int nb_output_dims, nb_input_dims, nb_local_dims, nb_parameters;
@@ -1341,8 +1537,10 @@ osl_relation_t* osl_relation_pread(FILE* foo, int precision) {
   int type;
   char *c, s[OSL_MAX_STRING], str[OSL_MAX_STRING], *tmp;
   osl_relation_p relation, relation_union = NULL, previous = NULL;
+  osl_int_t value;
 
   type = osl_relation_read_type(foo, NULL);
+  osl_int_init(precision, &value);
 
   // Read each part of the union (the number of parts may be updated inside)
   for (k = 0; k < nb_union_parts; k++) {
@@ -1374,7 +1572,10 @@ osl_relation_t* osl_relation_pread(FILE* foo, int precision) {
     }
 
     // Allocate the union part and fill its properties.
-    relation = osl_relation_pmalloc(precision, nb_rows, nb_columns);
+    if (sparse)
+      relation = osl_relation_sparse_pmalloc(precision, nb_rows, nb_columns, 0);
+    else
+      relation = osl_relation_pmalloc(precision, nb_rows, nb_columns);
     relation->type = type;
     relation->nb_output_dims = nb_output_dims;
     relation->nb_input_dims = nb_input_dims;
@@ -1395,9 +1596,18 @@ osl_relation_t* osl_relation_pread(FILE* foo, int precision) {
 
         // TODO: remove this tmp (sread updates the pointer).
         tmp = str;
-        osl_int_sread(&tmp, precision, &relation->m[i][j]);
+        if (sparse) {
+          osl_int_sread(&tmp, precision, &value);
+          if (!osl_int_zero(precision, value))
+            osl_relation_sparse_append(relation, j, value);
+        } else {
+          osl_int_sread(&tmp, precision, &relation->m[i][j]);
+        }
         c += n;
       }
+
+      if (sparse)
+        relation->sparse->row_start[i + 1] = relation->sparse->nb_nonzeros;
     }
 
     // Build the linked list of union parts.
@@ -1412,6 +1622,10 @@ osl_relation_t* osl_relation_pread(FILE* foo, int precision) {
     read_attributes = 1;
   }
 
+  if ((relation_union != NULL) && (relation_union->next != NULL))
+    osl_relation_array_sync(relation_union);
+
+  osl_int_clear(precision, &value);
   return relation_union;
 }
 
@@ -1433,6 +1647,24 @@ osl_relation_t* osl_relation_psread(char** input, int precision) {
   return relation;
 }
 
+/**
+ * osl_relation_psread_sparse function ("precision read"):
+ * this function is equivalent to osl_relation_psread() except that the
+ * relation matrices are directly built in sparse form (only the non-zero
+ * elements are stored, see osl_relation_to_sparse()).
+ * \see{osl_relation_psread}
+ */
+osl_relation_t* osl_relation_psread_sparse(char** input, int precision) {
+  int type;
+  osl_relation_p relation;
+
+  type = osl_relation_read_type(NULL, input);
+  relation = osl_relation_psread_polylib_storage(input, precision, 1);
+  relation->type = type;
+
+  return relation;
+}
+
 /**
  * osl_relation_psread_polylib function ("precision read"):
  * this function reads a relation from a string complying to the Extended
@@ -1445,6 +1677,24 @@ osl_relation_t* osl_relation_psread(char** input, int precision) {
  * \return A pointer to the relation structure that has been read.
  */
 osl_relation_t* osl_relation_psread_polylib(char** input, int precision) {
+  return osl_relation_psread_polylib_storage(input, precision, 0);
+}
+
+/**
+ * osl_relation_psread_polylib_storage internal function:
+ * this function reads a relation from a string complying to the Extended
+ * PolyLib textual format and returns a pointer this relation. The relation
+ * matrices are stored either densely or in sparse form. The input parameter
+ * is updated to the position in the input string this function reach right
+ * after reading the generic structure.
+ * \param[in,out] input     The input string where to find a relation.
+ *                          Updated to the position after what has been read.
+ * \param[in]     precision The precision of the relation elements.
+ * \param[in]     sparse    1 to store the matrices in sparse form, 0 else.
+ * \return A pointer to the relation structure that has been read.
+ */
+osl_relation_t* osl_relation_psread_polylib_storage(char** input,
+                                                    int precision, int sparse) {
   int i, j, k, n, read = 0;
   int nb_rows, nb_columns;
   int nb_output_dims, nb_input_dims, nb_local_dims, nb_parameters;
@@ -1454,6 +1704,9 @@ osl_relation_t* osl_relation_psread_polylib(char** input, int precision) {
   int first = 1;
   char str[OSL_MAX_STRING], *tmp;
   osl_relation_p relation, relation_union = NULL, previous = NULL;
+  osl_int_t value;
+
+  osl_int_init(precision, &value);
 
   // Read each part of the union (the number of parts may be updated inside)
   for (k = 0; k < nb_union_parts; k++) {
@@ -1495,7 +1748,10 @@ osl_relation_t* osl_relation_psread_polylib(char** input, int precision) {
     }
 
     // Allocate the union part and fill its properties.
-    relation = osl_relation_pmalloc(precision, nb_rows, nb_columns);
+    if (sparse)
+      relation = osl_relation_sparse_pmalloc(precision, nb_rows, nb_columns, 0);
+    else
+      relation = osl_relation_pmalloc(precision, nb_rows, nb_columns);
     relation->nb_output_dims = nb_output_dims;
     relation->nb_input_dims = nb_input_dims;
     relation->nb_local_dims = nb_local_dims;
@@ -1515,9 +1771,18 @@ osl_relation_t* osl_relation_psread_polylib(char** input, int precision) {
 
         // TODO: remove this tmp (sread updates the pointer).
         tmp = str;
-        osl_int_sread(&tmp, precision, &relation->m[i][j]);
+        if (sparse) {
+          osl_int_sread(&tmp, precision, &value);
+          if (!osl_int_zero(precision, value))
+            osl_relation_sparse_append(relation, j, value);
+        } else {
+          osl_int_sread(&tmp, precision, &relation->m[i][j]);
+        }
         *input += n;
       }
+
+      if (sparse)
+        relation->sparse->row_start[i + 1] = relation->sparse->nb_nonzeros;
     }
 
     // Build the linked list of union parts.
@@ -1532,6 +1797,10 @@ osl_relation_t* osl_relation_psread_polylib(char** input, int precision) {
     read_attributes = 1;
   }
 
+  if ((relation_union != NULL) && (relation_union->next != NULL))
+    osl_relation_array_sync(relation_union);
+
+  osl_int_clear(precision, &value);
   return relation_union;
 }
 
@@ -1624,11 +1893,58 @@ osl_relation_t* osl_relation_pmalloc(int precision, int nb_rows,
     }
   }
 
+  relation->sparse = NULL;
+  relation->shared = NULL;
+  relation->array_id = 0;
+  relation->parts = NULL;
   relation->next = NULL;
 
   return relation;
 }
 
+/**
+ * osl_relation_sparse_pmalloc internal function:
+ * this function allocates the memory space for an osl_relation_t structure
+ * with a sparse matrix of nb_rows rows and nb_columns columns, with room
+ * for size non-zero elements. The matrix is initially empty (all the rows
+ * are full of zeros). The relation attributes are set as by
+ * osl_relation_pmalloc().
+ * \param[in] precision  The precision of the relation.
+ * \param[in] nb_rows    The number of row of the relation to allocate.
+ * \param[in] nb_columns The number of columns of the relation to allocate.
+ * \param[in] size       The number of non-zero elements to make room for.
+ * \return A pointer to an allocated relation with an empty sparse matrix.
+ */
+osl_relation_t* osl_relation_sparse_pmalloc(int precision, int nb_rows,
+                                            int nb_columns, int size) {
+  osl_relation_p relation;
+  osl_relation_sparse_p sparse;
+  int i;
+
+  if ((nb_rows < 0) || (nb_columns < 0) || (size < 0))
+    OSL_error("negative sizes");
+
+  relation = osl_relation_pmalloc(precision, 0, 0);
+  relation->nb_rows = nb_rows;
+  relation->nb_columns = nb_columns;
+
+  OSL_malloc(sparse, osl_relation_sparse_p, sizeof(osl_relation_sparse_t));
+  OSL_malloc(sparse->row_start, int*, (size_t)(nb_rows + 1) * sizeof(int));
+  for (i = 0; i <= nb_rows; i++)
+    sparse->row_start[i] = 0;
+  sparse->nb_nonzeros = 0;
+  sparse->size = size;
+  sparse->column = NULL;
+  sparse->value = NULL;
+  if (size > 0) {
+    OSL_malloc(sparse->column, int*, (size_t)size * sizeof(int));
+    OSL_malloc(sparse->value, osl_int_t*, (size_t)size * sizeof(osl_int_t));
+  }
+  relation->sparse = sparse;
+
+  return relation;
+}
+
 /**
  * osl_relation_malloc function:
  * this function is equivalent to osl_relation_pmalloc() except that
@@ -1648,15 +1964,45 @@ osl_relation_t* osl_relation_interface_malloc(void) {
 /**
  * osl_relation_free_inside function:
  * this function frees the allocated memory for the inside of a
- * osl_relation_t structure, i.e. only m.
+ * osl_relation_t structure, i.e. only m (or the sparse matrix).
  * \param[in] relation The pointer to the relation we want to free internals.
  */
 void osl_relation_free_inside(osl_relation_t* relation) {
   int i, nb_elements;
+  osl_relation_sparse_p sparse;
+  osl_relation_shared_p shared;
 
   if (relation == NULL)
     return;
 
+  relation->array_id = 0;
+
+  // A shared matrix is only released with its last reference.
+  if (relation->shared != NULL) {
+    shared = relation->shared;
+    relation->shared = NULL;
+    if (--shared->refcount > 0) {
+      relation->m = NULL;
+      relation->sparse = NULL;
+      return;
+    }
+    if (shared->table != NULL)
+      osl_relation_table_remove(shared->table, shared);
+    OSL_free(shared);
+  }
+
+  if (relation->sparse != NULL) {
+    sparse = relation->sparse;
+    for (i = 0; i < sparse->nb_nonzeros; i++)
+      osl_int_clear(relation->precision, &sparse->value[i]);
+    OSL_free(sparse->row_start);
+    OSL_free(sparse->column);
+    OSL_free(sparse->value);
+    OSL_free(sparse);
+    relation->sparse = NULL;
+    return;
+  }
+
   nb_elements = relation->nb_rows * relation->nb_columns;
 
   for (i = 0; i < nb_elements; i++)
@@ -1664,8 +2010,9 @@ void osl_relation_free_inside(osl_relation_t* relation) {
 
   if (relation->m != NULL) {
     if (nb_elements > 0)
-      free(relation->m[0]);
-    free(relation->m);
+      OSL_free(relation->m[0]);
+    OSL_free(relation->m);
+    relation->m = NULL;
   }
 }
 
@@ -1681,11 +2028,58 @@ void osl_relation_free(osl_relation_t* relation) {
   while (relation != NULL) {
     tmp = relation->next;
     osl_relation_free_inside(relation);
-    free(relation);
+    osl_relation_array_free(relation->parts);
+    OSL_free(relation);
     relation = tmp;
   }
 }
 
+/**
+ * osl_relation_table_malloc function:
+ * this function allocates the memory space for an empty interning table of
+ * relation matrices (see osl_relation_intern()).
+ * \return A pointer to an empty interning table.
+ */
+osl_relation_table_t* osl_relation_table_malloc(void) {
+  osl_relation_table_p table;
+  size_t i;
+
+  OSL_malloc(table, osl_relation_table_p, sizeof(osl_relation_table_t));
+  table->nb_buckets = OSL_RELATION_TABLE_SIZE;
+  table->nb_entries = 0;
+  OSL_malloc(table->bucket, osl_relation_shared_p*,
+             table->nb_buckets * sizeof(osl_relation_shared_p));
+  for (i = 0; i < table->nb_buckets; i++)
+    table->bucket[i] = NULL;
+
+  return table;
+}
+
+/**
+ * osl_relation_table_free function:
+ * this function frees the allocated memory for an interning table. The
+ * interned matrices are not freed: they stay shared by the relation parts
+ * using them, and are released with the last of these parts.
+ * \param[in] table The interning table to free.
+ */
+void osl_relation_table_free(osl_relation_table_t* table) {
+  osl_relation_shared_p entry, next;
+  size_t i;
+
+  if (table == NULL)
+    return;
+
+  for (i = 0; i < table->nb_buckets; i++) {
+    for (entry = table->bucket[i]; entry != NULL; entry = next) {
+      next = entry->next;
+      entry->table = NULL;
+      entry->next = NULL;
+    }
+  }
+  OSL_free(table->bucket);
+  OSL_free(table);
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -1701,41 +2095,7 @@ void osl_relation_free(osl_relation_t* relation) {
  *         first n parts of the relation union.
  */
 osl_relation_t* osl_relation_nclone(const osl_relation_t* relation, int n) {
-  int i, j, k;
-  int first = 1, nb_components, nb_parts;
-  osl_relation_p clone = NULL, node, previous = NULL;
-
-  nb_components = osl_relation_nb_components(relation);
-  nb_parts = (n == -1) ? nb_components : n;
-  if (nb_components < nb_parts)
-    OSL_error("not enough union parts to clone");
-
-  for (k = 0; k < nb_parts; k++) {
-    node = osl_relation_pmalloc(relation->precision, relation->nb_rows,
-                                relation->nb_columns);
-    node->type = relation->type;
-    node->nb_output_dims = relation->nb_output_dims;
-    node->nb_input_dims = relation->nb_input_dims;
-    node->nb_local_dims = relation->nb_local_dims;
-    node->nb_parameters = relation->nb_parameters;
-
-    for (i = 0; i < relation->nb_rows; i++)
-      for (j = 0; j < relation->nb_columns; j++)
-        osl_int_assign(relation->precision, &node->m[i][j], relation->m[i][j]);
-
-    if (first) {
-      first = 0;
-      clone = node;
-      previous = node;
-    } else {
-      previous->next = node;
-      previous = previous->next;
-    }
-
-    relation = relation->next;
-  }
-
-  return clone;
+  return osl_relation_copy(relation, n, 0);
 }
 
 /**
@@ -1752,7 +2112,6 @@ osl_relation_t* osl_relation_nclone(const osl_relation_t* relation, int n) {
  */
 osl_relation_t* osl_relation_clone_nconstraints(const osl_relation_t* relation,
                                                 int n) {
-  int i, j;
   int first = 1, all_rows = 0;
   osl_relation_p clone = NULL, node, previous = NULL;
 
@@ -1766,17 +2125,13 @@ osl_relation_t* osl_relation_clone_nconstraints(const osl_relation_t* relation,
     if (n > relation->nb_rows)
       OSL_error("not enough rows to clone in the relation");
 
-    node = osl_relation_pmalloc(relation->precision, n, relation->nb_columns);
+    node = osl_relation_storage_clone(relation, n);
     node->type = relation->type;
     node->nb_output_dims = relation->nb_output_dims;
     node->nb_input_dims = relation->nb_input_dims;
     node->nb_local_dims = relation->nb_local_dims;
     node->nb_parameters = relation->nb_parameters;
 
-    for (i = 0; i < n; i++)
-      for (j = 0; j < relation->nb_columns; j++)
-        osl_int_assign(relation->precision, &node->m[i][j], relation->m[i][j]);
-
     if (first) {
       first = 0;
       clone = node;
@@ -1789,6 +2144,9 @@ osl_relation_t* osl_relation_clone_nconstraints(const osl_relation_t* relation,
     relation = relation->next;
   }
 
+  if ((clone != NULL) && (clone->next != NULL))
+    osl_relation_array_sync(clone);
+
   return clone;
 }
 
@@ -1807,136 +2165,458 @@ osl_relation_t* osl_relation_clone(const osl_relation_t* relation) {
 }
 
 /**
- * osl_relation_add function:
- * this function adds a relation (union) at the end of the relation (union)
- * pointed by r1. No new relation is created: this functions links the two
- * input unions. If the first relation is NULL, it is set to the
- * second relation.
- * \param[in,out] r1  Pointer to the first relation (union).
- * \param[in]     r2  The second relation (union).
+ * osl_relation_clone_cow function:
+ * this function builds and returns a copy-on-write clone of a relation
+ * union: the matrices of the relation are shared (see osl_relation_share())
+ * and the clone uses them until one of them is modified, which makes the
+ * clone as cheap as allocating the union part headers. The clone is used
+ * and released as a "hard copy", except that its matrices must only be
+ * modified through the library functions (which unshare them first), not by
+ * writing its m field directly.
+ * \param[in,out] relation The relation to clone (its matrices get shared).
+ * \return A copy-on-write clone of the relation.
  */
-void osl_relation_add(osl_relation_t** r1, osl_relation_t* r2) {
-  while (*r1 != NULL)
-    r1 = &((*r1)->next);
-
-  *r1 = r2;
+osl_relation_t* osl_relation_clone_cow(osl_relation_t* relation) {
+  osl_relation_share(relation);
+  return osl_relation_copy(relation, -1, 1);
 }
 
 /**
- * osl_relation_union function:
- * this function builds a new relation from two relations provided
- * as parameters. The new relation is built as an union of the
- * two relations: the list of constraint sets are linked together.
- * \param[in] r1 The first relation.
- * \param[in] r2 The second relation.
- * \return A new relation corresponding to the union of r1 and r2.
+ * osl_relation_sparse_nclone internal function:
+ * this function builds and returns a sparse copy of the first n rows of the
+ * sparse matrix of a relation union part. Only the sizes of the relation are
+ * set, not its other attributes.
+ * \param[in] relation The relation part (with a sparse matrix) to copy.
+ * \param[in] n        The number of rows to copy.
+ * \return A new relation part with a copy of the first n rows.
  */
-osl_relation_t* osl_relation_union(osl_relation_t* r1, osl_relation_t* r2) {
-  osl_relation_p copy1, copy2;
-
-  if ((r1 == NULL) && (r2 == NULL))
-    return NULL;
-
-  copy1 = osl_relation_clone(r1);
-  copy2 = osl_relation_clone(r2);
-  osl_relation_add(&copy1, copy2);
+osl_relation_t* osl_relation_sparse_nclone(const osl_relation_t* relation,
+                                           int n) {
+  int k;
+  int precision = relation->precision;
+  int nb_nonzeros = relation->sparse->row_start[n];
+  osl_relation_p clone;
+
+  clone = osl_relation_sparse_pmalloc(precision, n, relation->nb_columns,
+                                      nb_nonzeros);
+  memcpy(clone->sparse->row_start, relation->sparse->row_start,
+         (size_t)(n + 1) * sizeof(int));
+  if (nb_nonzeros > 0)
+    memcpy(clone->sparse->column, relation->sparse->column,
+           (size_t)nb_nonzeros * sizeof(int));
+  for (k = 0; k < nb_nonzeros; k++)
+    osl_int_init_set(precision, &clone->sparse->value[k],
+                     relation->sparse->value[k]);
+  clone->sparse->nb_nonzeros = nb_nonzeros;
 
-  return copy1;
+  return clone;
 }
 
 /**
- * osl_relation_replace_vector function:
- * this function replaces the "row"^th row of a relation "relation" with the
- * vector "vector". It directly updates the relation union part pointed
- * by "relation" and this part only.
- * \param[in,out] relation The relation we want to replace a row.
- * \param[in]     vector   The vector that will replace a row of the relation.
- * \param[in]     row      The row of the relation to be replaced.
+ * osl_relation_dense_nclone internal function:
+ * this function builds and returns a copy of the first n parts of a
+ * relation union (all the parts if n is -1) where every matrix is stored
+ * densely. It allows functions that read the matrices directly to process
+ * sparse relations.
+ * \param[in] relation The relation to copy.
+ * \param[in] n        The number of union parts to copy (-1 for all).
+ * \return A dense copy of the first n parts of the relation union.
  */
-void osl_relation_replace_vector(osl_relation_t* const relation,
-                                 const osl_vector_t* const vector, int row) {
-  int i;
-
-  if ((relation == NULL) || (vector == NULL) ||
-      (relation->precision != vector->precision) ||
-      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
-      (row < 0))
-    OSL_error("vector cannot replace relation row");
+osl_relation_t* osl_relation_dense_nclone(const osl_relation_t* relation,
+                                          int n) {
+  osl_relation_p clone = osl_relation_nclone(relation, n);
 
-  for (i = 0; i < vector->size; i++)
-    osl_int_assign(relation->precision, &relation->m[row][i], vector->v[i]);
+  osl_relation_to_dense(clone);
+  return clone;
 }
 
 /**
- * osl_relation_add_vector function:
- * this function adds (meaning, +) a vector to the "row"^th row of a
- * relation "relation". It directly updates the relation union part pointed
- * by "relation" and this part only.
- * \param[in,out] relation The relation we want to add a vector to a row.
- * \param[in]     vector   The vector that will replace a row of the relation.
- * \param[in]     row      The row of the relation to add the vector.
+ * osl_relation_storage_clone internal function:
+ * this function builds and returns a relation with a private copy of the
+ * n first rows of the matrix of a relation union part, in the same layout
+ * (dense or sparse). The attributes of the copy are set as by
+ * osl_relation_pmalloc().
+ * \param[in] relation The relation part to copy.
+ * \param[in] n        The number of rows to copy.
+ * \return A relation with a private copy of the n first rows of the matrix.
  */
-void osl_relation_add_vector(osl_relation_t* relation,
-                             const osl_vector_t* vector, int row) {
-  int i;
+osl_relation_t* osl_relation_storage_clone(const osl_relation_t* relation,
+                                           int n) {
+  int i, j;
+  osl_relation_p node;
 
-  if ((relation == NULL) || (vector == NULL) ||
-      (relation->precision != vector->precision) ||
-      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
-      (row < 0))
-    OSL_error("vector cannot be added to relation");
+  if (relation->sparse != NULL)
+    return osl_relation_sparse_nclone(relation, n);
 
-  if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
-    osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
+  node = osl_relation_pmalloc(relation->precision, n, relation->nb_columns);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < relation->nb_columns; j++)
+      osl_int_assign(relation->precision, &node->m[i][j], relation->m[i][j]);
 
-  for (i = 1; i < vector->size; i++)
-    osl_int_add(relation->precision, &relation->m[row][i], relation->m[row][i],
-                vector->v[i]);
+  return node;
 }
 
 /**
- * osl_relation_sub_vector function:
- * this function subtracts the vector "vector" to the "row"^th row of
- * a relation "relation. It directly updates the relation union part pointed
- * by "relation" and this part only.
- * \param[in,out] relation The relation where to subtract a vector to a row.
- * \param[in]     vector   The vector to subtract to a relation row.
- * \param[in]     row      The row of the relation to subtract the vector.
+ * osl_relation_shared_clone internal function:
+ * this function builds and returns a relation sharing the (shared) matrix
+ * of a relation union part. The attributes of the new relation are set as
+ * by osl_relation_pmalloc().
+ * \param[in] relation The relation part with a shared matrix.
+ * \return A relation sharing the matrix of the relation part.
  */
-void osl_relation_sub_vector(osl_relation_t* relation,
-                             const osl_vector_t* const vector, int row) {
-  int i;
-
-  if ((relation == NULL) || (vector == NULL) ||
-      (relation->precision != vector->precision) ||
-      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
-      (row < 0))
-    OSL_error("vector cannot be subtracted to row");
+osl_relation_t* osl_relation_shared_clone(const osl_relation_t* relation) {
+  osl_relation_p node = osl_relation_pmalloc(relation->precision, 0, 0);
 
-  if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
-    osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
+  node->nb_rows = relation->nb_rows;
+  node->nb_columns = relation->nb_columns;
+  node->m = relation->m;
+  node->sparse = relation->sparse;
+  node->shared = relation->shared;
+  node->shared->refcount++;
 
-  for (i = 1; i < vector->size; i++)
-    osl_int_sub(relation->precision, &relation->m[row][i], relation->m[row][i],
-                vector->v[i]);
+  return node;
 }
 
 /**
- * osl_relation_insert_vector function:
- * this function inserts a new row corresponding to the vector "vector" to
- * the relation "relation" by inserting it at the "row"^th row of
- * "relation" (-1 is a shortcut to insert the vector after the constraints
- * of the relation). It directly updates the relation union part pointed
- * by "relation" and this part only. If "vector" (or "relation") is NULL,
- * the relation is left unmodified.
- * \param[in,out] relation The relation we want to extend.
- * \param[in]     vector   The vector that will be added relation.
- * \param[in]     row      The row where to insert the vector (-1 to
- *                         insert it after the relation constraints).
+ * osl_relation_copy internal function:
+ * this function builds and returns a copy of the first n parts of a
+ * relation union. Each part gets a private copy of its matrix, unless
+ * share is set and the matrix is shared (see osl_relation_share()): the
+ * copy then shares it too, except in an arena (it has to be self-contained).
+ * \param[in] relation The pointer to the relation we want to copy.
+ * \param[in] n        The number of union parts of the relation we want to
+ *                     copy (the special value -1 means "all the parts").
+ * \param[in] share    1 to share the shared matrices, 0 to copy them.
+ * \return A pointer to the copy of the first n parts of the relation union.
  */
-void osl_relation_insert_vector(osl_relation_t* relation,
-                                const osl_vector_t* vector, int row) {
-  osl_relation_p temp;
+osl_relation_t* osl_relation_copy(const osl_relation_t* relation, int n,
+                                  int share) {
+  int k;
+  int first = 1;
+  osl_relation_p clone = NULL, node, previous = NULL;
+
+  // The parts are counted while copying, to visit the union only once.
+  for (k = 0; (n == -1) ? (relation != NULL) : (k < n); k++) {
+    if (relation == NULL)
+      OSL_error("not enough union parts to clone");
+
+    if (share && (relation->shared != NULL) &&
+        (osl_arena_get_current() == NULL))
+      node = osl_relation_shared_clone(relation);
+    else
+      node = osl_relation_storage_clone(relation, relation->nb_rows);
+    node->type = relation->type;
+    node->nb_output_dims = relation->nb_output_dims;
+    node->nb_input_dims = relation->nb_input_dims;
+    node->nb_local_dims = relation->nb_local_dims;
+    node->nb_parameters = relation->nb_parameters;
+    node->array_id = relation->array_id;
+
+    if (first) {
+      first = 0;
+      clone = node;
+      previous = node;
+    } else {
+      previous->next = node;
+      previous = previous->next;
+    }
+
+    relation = relation->next;
+  }
+
+  if ((clone != NULL) && (clone->next != NULL))
+    osl_relation_array_sync(clone);
+
+  return clone;
+}
+
+/**
+ * osl_relation_shared_make internal function:
+ * this function turns the private matrix of a relation union part into a
+ * shared matrix with a single reference, which is not interned yet.
+ * \param[in,out] relation The relation part owning its matrix.
+ */
+void osl_relation_shared_make(osl_relation_t* relation) {
+  osl_relation_shared_p shared;
+  osl_arena_p arena;
+
+  // The record lives with the (heap) matrix, not in the current arena.
+  arena = osl_arena_set_current(NULL);
+  OSL_malloc(shared, osl_relation_shared_p, sizeof(osl_relation_shared_t));
+  osl_arena_set_current(arena);
+  shared->refcount = 1;
+  shared->hash = osl_relation_storage_hash(relation);
+  shared->precision = relation->precision;
+  shared->nb_rows = relation->nb_rows;
+  shared->nb_columns = relation->nb_columns;
+  shared->m = relation->m;
+  shared->sparse = relation->sparse;
+  shared->table = NULL;
+  shared->next = NULL;
+  relation->shared = shared;
+}
+
+/**
+ * osl_relation_part_unshare internal function:
+ * this function makes sure that the matrix of a relation union part is
+ * owned by this part only, by duplicating it if it is shared with other
+ * parts. It has to be called before modifying the matrix in place.
+ * \param[in,out] relation The relation part to modify.
+ */
+void osl_relation_part_unshare(osl_relation_t* relation) {
+  osl_relation_p copy;
+  osl_relation_shared_p shared = relation->shared;
+
+  // The matrix is about to be modified in place.
+  relation->array_id = 0;
+
+  if (shared == NULL)
+    return;
+
+  // Last reference: simply take the ownership back.
+  if (shared->refcount == 1) {
+    if (shared->table != NULL)
+      osl_relation_table_remove(shared->table, shared);
+    OSL_free(shared);
+    relation->shared = NULL;
+    return;
+  }
+
+  copy = osl_relation_storage_clone(relation, relation->nb_rows);
+  osl_relation_free_inside(relation);
+  relation->m = copy->m;
+  relation->sparse = copy->sparse;
+  OSL_free(copy);
+}
+
+/**
+ * osl_relation_part_to_dense internal function:
+ * this function converts the matrix of a relation union part from the
+ * sparse form back to the dense form (m), if it is sparse. Only this part
+ * is affected, so that the functions that modify one part of a union do
+ * not change the layout of the next ones.
+ * \param[in,out] relation The relation part to convert.
+ */
+void osl_relation_part_to_dense(osl_relation_t* relation) {
+  int i, k;
+  osl_relation_p temp;
+  osl_relation_sparse_p sparse = relation->sparse;
+
+  if (sparse == NULL)
+    return;
+
+  temp = osl_relation_pmalloc(relation->precision, relation->nb_rows,
+                              relation->nb_columns);
+  for (i = 0; i < relation->nb_rows; i++)
+    for (k = sparse->row_start[i]; k < sparse->row_start[i + 1]; k++)
+      osl_int_assign(relation->precision, &temp->m[i][sparse->column[k]],
+                     sparse->value[k]);
+
+  osl_relation_free_inside(relation);
+
+  // Replace the inside of relation.
+  relation->m = temp->m;
+
+  // Free the temp "shell".
+  OSL_free(temp);
+}
+
+/**
+ * osl_relation_sparse_append internal function:
+ * this function appends a non-zero element at the end of the sparse matrix
+ * of a relation union part, making room for it if necessary. The caller is
+ * responsible for keeping the rows ordered, i.e., for calling this function
+ * row by row in increasing column order and for updating row_start.
+ * \param[in,out] relation The relation part where to append an element.
+ * \param[in]     column   The column of the element.
+ * \param[in]     value    The (non-zero) value of the element.
+ */
+void osl_relation_sparse_append(osl_relation_t* relation, int column,
+                                const osl_int_t value) {
+  osl_relation_sparse_p sparse = relation->sparse;
+
+  if (sparse->nb_nonzeros == sparse->size) {
+    sparse->size = OSL_max(2 * sparse->size, relation->nb_columns);
+    sparse->size = OSL_max(sparse->size, 1);
+    OSL_realloc(sparse->column, int*, (size_t)sparse->size * sizeof(int));
+    OSL_realloc(sparse->value, osl_int_t*,
+                (size_t)sparse->size * sizeof(osl_int_t));
+  }
+
+  sparse->column[sparse->nb_nonzeros] = column;
+  osl_int_init_set(relation->precision, &sparse->value[sparse->nb_nonzeros],
+                   value);
+  sparse->nb_nonzeros++;
+}
+
+/**
+ * osl_relation_sparse_position internal function:
+ * this function returns the position, in the column and value arrays of a
+ * sparse matrix, of the first element of a given row with a column greater
+ * or equal to a given column (row_start[row + 1] if there is none).
+ * \param[in] sparse The sparse matrix.
+ * \param[in] row    The row of the element.
+ * \param[in] column The column of the element.
+ * \return The position of the element, or of the place to insert it.
+ */
+int osl_relation_sparse_position(const osl_relation_sparse_t* sparse, int row,
+                                 int column) {
+  int low = sparse->row_start[row];
+  int high = sparse->row_start[row + 1];
+  int middle;
+
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    if (sparse->column[middle] < column)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  return low;
+}
+
+/**
+ * osl_relation_add function:
+ * this function adds a relation (union) at the end of the relation (union)
+ * pointed by r1. No new relation is created: this functions links the two
+ * input unions. If the first relation is NULL, it is set to the
+ * second relation. The end of the first union is found in constant time
+ * through its relation array, which is built otherwise.
+ * \param[in,out] r1  Pointer to the first relation (union).
+ * \param[in]     r2  The second relation (union).
+ */
+void osl_relation_add(osl_relation_t** r1, osl_relation_t* r2) {
+  if ((*r1 == NULL) || (r2 == NULL)) {
+    if (*r1 == NULL)
+      *r1 = r2;
+    return;
+  }
+
+  osl_relation_array_add(osl_relation_array_get(*r1), r2);
+}
+
+/**
+ * osl_relation_union function:
+ * this function builds a new relation from two relations provided
+ * as parameters. The new relation is built as an union of the
+ * two relations: the list of constraint sets are linked together.
+ * \param[in] r1 The first relation.
+ * \param[in] r2 The second relation.
+ * \return A new relation corresponding to the union of r1 and r2.
+ */
+osl_relation_t* osl_relation_union(osl_relation_t* r1, osl_relation_t* r2) {
+  osl_relation_p copy1, copy2;
+
+  if ((r1 == NULL) && (r2 == NULL))
+    return NULL;
+
+  copy1 = osl_relation_clone(r1);
+  copy2 = osl_relation_clone(r2);
+  osl_relation_add(&copy1, copy2);
+
+  return copy1;
+}
+
+/**
+ * osl_relation_replace_vector function:
+ * this function replaces the "row"^th row of a relation "relation" with the
+ * vector "vector". It directly updates the relation union part pointed
+ * by "relation" and this part only.
+ * \param[in,out] relation The relation we want to replace a row.
+ * \param[in]     vector   The vector that will replace a row of the relation.
+ * \param[in]     row      The row of the relation to be replaced.
+ */
+void osl_relation_replace_vector(osl_relation_t* const relation,
+                                 const osl_vector_t* const vector, int row) {
+  int i;
+
+  if ((relation == NULL) || (vector == NULL) ||
+      (relation->precision != vector->precision) ||
+      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
+      (row < 0))
+    OSL_error("vector cannot replace relation row");
+
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
+  for (i = 0; i < vector->size; i++)
+    osl_int_assign(relation->precision, &relation->m[row][i], vector->v[i]);
+}
+
+/**
+ * osl_relation_add_vector function:
+ * this function adds (meaning, +) a vector to the "row"^th row of a
+ * relation "relation". It directly updates the relation union part pointed
+ * by "relation" and this part only.
+ * \param[in,out] relation The relation we want to add a vector to a row.
+ * \param[in]     vector   The vector that will replace a row of the relation.
+ * \param[in]     row      The row of the relation to add the vector.
+ */
+void osl_relation_add_vector(osl_relation_t* relation,
+                             const osl_vector_t* vector, int row) {
+  int i;
+
+  if ((relation == NULL) || (vector == NULL) ||
+      (relation->precision != vector->precision) ||
+      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
+      (row < 0))
+    OSL_error("vector cannot be added to relation");
+
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
+  if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
+    osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
+
+  for (i = 1; i < vector->size; i++)
+    osl_int_add(relation->precision, &relation->m[row][i], relation->m[row][i],
+                vector->v[i]);
+}
+
+/**
+ * osl_relation_sub_vector function:
+ * this function subtracts the vector "vector" to the "row"^th row of
+ * a relation "relation. It directly updates the relation union part pointed
+ * by "relation" and this part only.
+ * \param[in,out] relation The relation where to subtract a vector to a row.
+ * \param[in]     vector   The vector to subtract to a relation row.
+ * \param[in]     row      The row of the relation to subtract the vector.
+ */
+void osl_relation_sub_vector(osl_relation_t* relation,
+                             const osl_vector_t* const vector, int row) {
+  int i;
+
+  if ((relation == NULL) || (vector == NULL) ||
+      (relation->precision != vector->precision) ||
+      (relation->nb_columns != vector->size) || (row >= relation->nb_rows) ||
+      (row < 0))
+    OSL_error("vector cannot be subtracted to row");
+
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
+  if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
+    osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
+
+  for (i = 1; i < vector->size; i++)
+    osl_int_sub(relation->precision, &relation->m[row][i], relation->m[row][i],
+                vector->v[i]);
+}
+
+/**
+ * osl_relation_insert_vector function:
+ * this function inserts a new row corresponding to the vector "vector" to
+ * the relation "relation" by inserting it at the "row"^th row of
+ * "relation" (-1 is a shortcut to insert the vector after the constraints
+ * of the relation). It directly updates the relation union part pointed
+ * by "relation" and this part only. If "vector" (or "relation") is NULL,
+ * the relation is left unmodified.
+ * \param[in,out] relation The relation we want to extend.
+ * \param[in]     vector   The vector that will be added relation.
+ * \param[in]     row      The row where to insert the vector (-1 to
+ *                         insert it after the relation constraints).
+ */
+void osl_relation_insert_vector(osl_relation_t* relation,
+                                const osl_vector_t* vector, int row) {
+  osl_relation_p temp;
 
   temp = osl_relation_from_vector(vector);
   osl_relation_insert_constraints(relation, temp, row);
@@ -2000,6 +2680,8 @@ void osl_relation_insert_blank_column(osl_relation_t* const relation,
   if ((column < 0) || (column > relation->nb_columns))
     OSL_error("bad column number");
 
+  osl_relation_part_to_dense(relation);
+
   // We use a temporary relation just to reuse existing functions. Cleaner.
   temp = osl_relation_pmalloc(relation->precision, relation->nb_rows,
                               relation->nb_columns + 1);
@@ -2020,7 +2702,7 @@ void osl_relation_insert_blank_column(osl_relation_t* const relation,
   relation->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  OSL_free(temp);
 }
 
 /**
@@ -2052,13 +2734,26 @@ osl_relation_t* osl_relation_from_vector(const osl_vector_t* vector) {
  */
 void osl_relation_replace_constraints(osl_relation_t* r1,
                                       const osl_relation_t* r2, int row) {
-  int i, j;
+  int i, j, k;
 
   if ((r1 == NULL) || (r2 == NULL) || (r1->precision != r2->precision) ||
       (r1->nb_columns != r2->nb_columns) ||
       ((row + r2->nb_rows) > r1->nb_rows) || (row < 0))
     OSL_error("relation rows could not be replaced");
 
+  osl_relation_part_to_dense(r1);
+  osl_relation_part_unshare(r1);
+  if (r2->sparse != NULL) {
+    for (i = 0; i < r2->nb_rows; i++) {
+      for (j = 0; j < r2->nb_columns; j++)
+        osl_int_set_si(r1->precision, &r1->m[i + row][j], 0);
+      for (k = r2->sparse->row_start[i]; k < r2->sparse->row_start[i + 1]; k++)
+        osl_int_assign(r1->precision, &r1->m[i + row][r2->sparse->column[k]],
+                       r2->sparse->value[k]);
+    }
+    return;
+  }
+
   for (i = 0; i < r2->nb_rows; i++)
     for (j = 0; j < r2->nb_columns; j++)
       osl_int_assign(r1->precision, &r1->m[i + row][j], r2->m[i][j]);
@@ -2091,6 +2786,8 @@ void osl_relation_insert_constraints(osl_relation_t* r1,
       (row > r1->nb_rows) || (row < 0))
     OSL_error("constraints cannot be inserted");
 
+  osl_relation_part_to_dense(r1);
+
   // We use a temporary relation just to reuse existing functions. Cleaner.
   temp = osl_relation_pmalloc(r1->precision, r1->nb_rows + r2->nb_rows,
                               r1->nb_columns);
@@ -2112,7 +2809,7 @@ void osl_relation_insert_constraints(osl_relation_t* r1,
   r1->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  OSL_free(temp);
 }
 
 /**
@@ -2133,10 +2830,120 @@ void osl_relation_swap_constraints(osl_relation_t* relation, int c1, int c2) {
       (c2 < 0))
     OSL_error("bad constraint rows");
 
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
   for (i = 0; i < relation->nb_columns; i++)
     osl_int_swap(relation->precision, &relation->m[c1][i], &relation->m[c2][i]);
 }
 
+/**
+ * osl_relation_row_gcd function:
+ * this function sets gcd to the (non-negative) greatest common divisor of
+ * the coefficients of a given row of the relation "relation" (the
+ * equality/inequality column excepted), 0 if they are all 0. It only
+ * affects the first union part. The gcd must have been initialized with
+ * the precision of the relation (e.g., with osl_int_init()).
+ * \param[in]  relation The relation to read.
+ * \param[in]  row      The row number.
+ * \param[out] gcd      The gcd of the coefficients of the row.
+ */
+void osl_relation_row_gcd(const osl_relation_t* relation, int row,
+                          osl_int_t* gcd) {
+  int k;
+  osl_relation_sparse_p sparse = relation->sparse;
+
+  if ((row < 0) || (row >= relation->nb_rows))
+    OSL_error("bad constraint row");
+
+  if (sparse == NULL) {
+    osl_int_gcd_array(relation->precision, gcd, relation->m[row] + 1,
+                      (size_t)(relation->nb_columns - 1));
+    return;
+  }
+
+  // Only the non-zero values of the row are considered.
+  k = sparse->row_start[row];
+  if ((k < sparse->row_start[row + 1]) && (sparse->column[k] == 0))
+    k++;
+  osl_int_gcd_array(relation->precision, gcd, sparse->value + k,
+                    (size_t)(sparse->row_start[row + 1] - k));
+}
+
+/**
+ * osl_relation_row_normalize function:
+ * this function divides the coefficients of a given row of the relation
+ * "relation" (the equality/inequality column excepted) by their gcd. It
+ * directly updates the relation union part pointed by "relation" and this
+ * part only.
+ * \param[in,out] relation The relation to modify.
+ * \param[in]     row      The row number.
+ */
+void osl_relation_row_normalize(osl_relation_t* relation, int row) {
+  osl_int_t gcd;
+
+  if (relation == NULL)
+    return;
+
+  osl_int_init(relation->precision, &gcd);
+  osl_relation_row_gcd(relation, row, &gcd);
+  if (!osl_int_zero(relation->precision, gcd) &&
+      !osl_int_one(relation->precision, gcd)) {
+    osl_relation_part_to_dense(relation);
+    osl_relation_part_unshare(relation);
+    osl_int_div_exact_array(relation->precision, relation->m[row] + 1,
+                            (size_t)(relation->nb_columns - 1), gcd);
+  }
+  osl_int_clear(relation->precision, &gcd);
+}
+
+/**
+ * osl_relation_row_oppose function:
+ * this function negates the coefficients of a given row of the relation
+ * "relation" (the equality/inequality column excepted). It directly
+ * updates the relation union part pointed by "relation" and this part only.
+ * \param[in,out] relation The relation to modify.
+ * \param[in]     row      The row number.
+ */
+void osl_relation_row_oppose(osl_relation_t* relation, int row) {
+  if (relation == NULL)
+    return;
+
+  if ((row < 0) || (row >= relation->nb_rows))
+    OSL_error("bad constraint row");
+
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
+  osl_int_oppose_array(relation->precision, relation->m[row] + 1,
+                       (size_t)(relation->nb_columns - 1));
+}
+
+/**
+ * osl_relation_row_addmul function:
+ * this function adds "factor" times the row "row2" to the row "row1" of
+ * the relation "relation" (the equality/inequality column excepted), as
+ * done when eliminating a variable. It directly updates the relation union
+ * part pointed by "relation" and this part only.
+ * \param[in,out] relation The relation to modify.
+ * \param[in]     row1     The row number of the row to update.
+ * \param[in]     row2     The row number of the row to add (not row1).
+ * \param[in]     factor   The factor of row2.
+ */
+void osl_relation_row_addmul(osl_relation_t* relation, int row1, int row2,
+                             const osl_int_t factor) {
+  if (relation == NULL)
+    return;
+
+  if ((row1 < 0) || (row1 >= relation->nb_rows) || (row2 < 0) ||
+      (row2 >= relation->nb_rows) || (row1 == row2))
+    OSL_error("bad constraint rows");
+
+  osl_relation_part_to_dense(relation);
+  osl_relation_part_unshare(relation);
+  osl_int_addmul_array(relation->precision, relation->m[row1] + 1,
+                       relation->m[row2] + 1,
+                       (size_t)(relation->nb_columns - 1), factor);
+}
+
 /**
  * osl_relation_remove_row function:
  * this function removes a given row to the relation "r". It directly
@@ -2154,6 +2961,8 @@ void osl_relation_remove_row(osl_relation_t* r, int row) {
   if ((row < 0) || (row >= r->nb_rows))
     OSL_error("bad row number");
 
+  osl_relation_part_to_dense(r);
+
   // We use a temporary relation just to reuse existing functions. Cleaner.
   temp = osl_relation_pmalloc(r->precision, r->nb_rows - 1, r->nb_columns);
 
@@ -2172,7 +2981,7 @@ void osl_relation_remove_row(osl_relation_t* r, int row) {
   r->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  OSL_free(temp);
 }
 
 /**
@@ -2192,6 +3001,8 @@ void osl_relation_remove_column(osl_relation_t* r, int column) {
   if ((column < 0) || (column >= r->nb_columns))
     OSL_error("bad column number");
 
+  osl_relation_part_to_dense(r);
+
   // We use a temporary relation just to reuse existing functions. Cleaner.
   temp = osl_relation_pmalloc(r->precision, r->nb_rows, r->nb_columns - 1);
 
@@ -2210,7 +3021,932 @@ void osl_relation_remove_column(osl_relation_t* r, int column) {
   r->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  OSL_free(temp);
+}
+
+/**
+ * osl_relation_specialize_parameters function:
+ * this function replaces some parameters of every part of a relation union
+ * with known values: the parameter columns are folded into the constant
+ * column and then removed, and the number of parameters is updated.
+ * \param[in,out] relation The relation to specialize.
+ * \param[in]     values   The values of the parameters (one per parameter).
+ * \param[in]     mask     For each parameter, non-zero to specialize it, 0
+ *                         to keep it (NULL to specialize every parameter).
+ */
+void osl_relation_specialize_parameters(osl_relation_t* relation,
+                                        const long* values, const int* mask) {
+  int i, j, k, first, nb_removed;
+  int constant;
+  osl_int_t value, product;
+  osl_relation_p temp;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->nb_parameters <= 0)
+      continue;
+
+    nb_removed = 0;
+    for (k = 0; k < relation->nb_parameters; k++)
+      if ((mask == NULL) || mask[k])
+        nb_removed++;
+    if (nb_removed == 0)
+      continue;
+
+    osl_relation_part_to_dense(relation);
+    constant = relation->nb_columns - 1;
+    first = constant - relation->nb_parameters;
+    temp = osl_relation_pmalloc(relation->precision, relation->nb_rows,
+                                relation->nb_columns - nb_removed);
+    osl_int_init(relation->precision, &value);
+    osl_int_init(relation->precision, &product);
+    for (i = 0; i < relation->nb_rows; i++) {
+      osl_int_assign(relation->precision, &temp->m[i][temp->nb_columns - 1],
+                     relation->m[i][constant]);
+      for (j = 0, k = 0; j < constant; j++) {
+        if ((j < first) || ((mask != NULL) && !mask[j - first])) {
+          osl_int_assign(relation->precision, &temp->m[i][k++],
+                         relation->m[i][j]);
+          continue;
+        }
+        osl_int_set_long(relation->precision, &value, values[j - first]);
+        osl_int_mul(relation->precision, &product, value, relation->m[i][j]);
+        osl_int_add(relation->precision, &temp->m[i][temp->nb_columns - 1],
+                    temp->m[i][temp->nb_columns - 1], product);
+      }
+    }
+    osl_int_clear(relation->precision, &value);
+    osl_int_clear(relation->precision, &product);
+
+    osl_relation_free_inside(relation);
+
+    // Replace the inside of relation.
+    relation->nb_columns = temp->nb_columns;
+    relation->nb_parameters -= nb_removed;
+    relation->m = temp->m;
+
+    // Free the temp "shell".
+    OSL_free(temp);
+  }
+}
+
+/**
+ * osl_relation_eliminate_equalities function:
+ * this function removes, from every part of a relation union, the local
+ * dimensions defined by an equality where their coefficient is 1 or -1
+ * (e.g., the local dimensions introduced by tiling): the definition is
+ * substituted in the other constraints by exact Gaussian elimination, then
+ * the equality and the local dimension column are removed and the number of
+ * local dimensions is updated. Other dimensions belong to the space of the
+ * relation and are kept, as are local dimensions with non-unit definitions
+ * which also carry a divisibility constraint.
+ * \param[in,out] relation The relation to simplify.
+ */
+void osl_relation_eliminate_equalities(osl_relation_t* relation) {
+  int i, row, column, first;
+  osl_int_t factor;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->nb_local_dims <= 0)
+      continue;
+
+    osl_relation_part_to_dense(relation);
+    osl_int_init(relation->precision, &factor);
+    first = 1 + relation->nb_output_dims + relation->nb_input_dims;
+    column = first + relation->nb_local_dims - 1;
+    while (column >= first) {
+      for (row = 0; row < relation->nb_rows; row++)
+        if (osl_int_zero(relation->precision, relation->m[row][0]) &&
+            (osl_int_one(relation->precision, relation->m[row][column]) ||
+             osl_int_mone(relation->precision, relation->m[row][column])))
+          break;
+
+      if (row == relation->nb_rows) {
+        column--;
+        continue;
+      }
+
+      // With a unit pivot p, row i -= (b_i / p) row, i.e., += -b_i * p row.
+      for (i = 0; i < relation->nb_rows; i++) {
+        if ((i == row) ||
+            osl_int_zero(relation->precision, relation->m[i][column]))
+          continue;
+        osl_int_mul(relation->precision, &factor, relation->m[i][column],
+                    relation->m[row][column]);
+        osl_int_oppose(relation->precision, &factor, factor);
+        osl_relation_row_addmul(relation, i, row, factor);
+      }
+
+      osl_relation_remove_row(relation, row);
+      osl_relation_remove_column(relation, column);
+      relation->nb_local_dims--;
+      column--;
+    }
+    osl_int_clear(relation->precision, &factor);
+  }
+}
+
+/**
+ * osl_relation_row_combine internal function:
+ * this function sets the row dst of a dense matrix to f1 * r1 + f2 * r2
+ * where a given column is removed (the equality/inequality column is not
+ * computed). The matrix of dst has one column less than those of r1 and r2.
+ * \param[in]  precision  The precision of the matrix elements.
+ * \param[in]  nb_columns The number of columns of r1 and r2.
+ * \param[in]  column     The column to remove.
+ * \param[out] dst        The row to compute.
+ * \param[in]  f1         The factor of the first row.
+ * \param[in]  r1         The first row.
+ * \param[in]  f2         The factor of the second row.
+ * \param[in]  r2         The second row.
+ */
+void osl_relation_row_combine(int precision, int nb_columns, int column,
+                              osl_int_t* dst, const osl_int_t f1,
+                              const osl_int_t* r1, const osl_int_t f2,
+                              const osl_int_t* r2) {
+  int j, k;
+  osl_int_t product;
+
+  osl_int_init(precision, &product);
+  for (j = 1, k = 1; j < nb_columns; j++) {
+    if (j == column)
+      continue;
+    osl_int_mul(precision, &dst[k], f1, r1[j]);
+    osl_int_mul(precision, &product, f2, r2[j]);
+    osl_int_add(precision, &dst[k], dst[k], product);
+    k++;
+  }
+  osl_int_clear(precision, &product);
+}
+
+/**
+ * osl_relation_part_tighten internal function:
+ * this function divides the coefficients of every inequality of a dense
+ * relation union part by their gcd, rounding the constant down. This keeps
+ * the same integer points and removes non-integer parts of the polyhedron.
+ * \param[in,out] relation The (private) dense relation part to tighten.
+ */
+void osl_relation_part_tighten(osl_relation_t* relation) {
+  int i;
+  int precision = relation->precision;
+  int constant = relation->nb_columns - 1;
+  osl_int_t gcd;
+
+  osl_int_init(precision, &gcd);
+  for (i = 0; i < relation->nb_rows; i++) {
+    osl_int_t* row = relation->m[i];
+
+    if (osl_int_zero(precision, row[0]))
+      continue;
+    osl_int_gcd_array(precision, &gcd, row + 1, (size_t)(constant - 1));
+    if (osl_int_zero(precision, gcd) || osl_int_one(precision, gcd))
+      continue;
+    osl_int_div_exact_array(precision, row + 1, (size_t)(constant - 1), gcd);
+    osl_int_floor_div_q(precision, &row[constant], row[constant], gcd);
+  }
+  osl_int_clear(precision, &gcd);
+}
+
+/**
+ * osl_relation_part_eliminate internal function:
+ * this function projects a given column out of a (private) dense relation
+ * union part. If an equality involves the column, it is used to substitute
+ * the column in the other rows (Gaussian elimination), otherwise every
+ * lower bound is combined with every upper bound (Fourier-Motzkin). The
+ * result is then tightened and pruned of redundant rows (see
+ * osl_relation_canonicalize()), and the relation attributes are updated.
+ * \param[in,out] relation The relation part to project.
+ * \param[in]     column   The column to project out.
+ * \return 1 if the projection is exact on integer points, 0 if it may
+ *         contain integer points with no preimage.
+ */
+int osl_relation_part_eliminate(osl_relation_t* relation, int column) {
+  int i, j, pivot = -1, exact = 1;
+  int precision = relation->precision;
+  int nb_rows = 0;
+  int bound;
+  osl_int_t** m = relation->m;
+  osl_int_t f1, f2;
+  osl_relation_p temp;
+
+  osl_int_init(precision, &f1);
+  osl_int_init(precision, &f2);
+
+  // The equality with the smallest coefficient is the best pivot.
+  for (i = 0; i < relation->nb_rows; i++) {
+    if (!osl_int_zero(precision, m[i][0]) ||
+        osl_int_zero(precision, m[i][column]))
+      continue;
+    osl_int_abs(precision, &f2, m[i][column]);
+    if ((pivot == -1) || osl_int_lt(precision, f2, f1)) {
+      pivot = i;
+      osl_int_assign(precision, &f1, f2);
+    }
+  }
+
+  if (pivot != -1) {
+    exact = osl_int_one(precision, f1);
+    temp = osl_relation_pmalloc(precision, relation->nb_rows - 1,
+                                relation->nb_columns - 1);
+    for (i = 0; i < relation->nb_rows; i++) {
+      if (i == pivot)
+        continue;
+      // Row i * |p| - sign(p) * b_i * pivot row keeps the sense of row i.
+      osl_int_abs(precision, &f1, m[pivot][column]);
+      if (osl_int_pos(precision, m[pivot][column]))
+        osl_int_oppose(precision, &f2, m[i][column]);
+      else
+        osl_int_assign(precision, &f2, m[i][column]);
+      osl_int_assign(precision, &temp->m[nb_rows][0], m[i][0]);
+      osl_relation_row_combine(precision, relation->nb_columns, column,
+                               temp->m[nb_rows], f1, m[i], f2, m[pivot]);
+      nb_rows++;
+    }
+  } else {
+    int nb_lower = 0, nb_upper = 0;
+
+    for (i = 0; i < relation->nb_rows; i++) {
+      if (osl_int_pos(precision, m[i][column]))
+        nb_lower++;
+      else if (osl_int_neg(precision, m[i][column]))
+        nb_upper++;
+    }
+    nb_rows = relation->nb_rows - nb_lower - nb_upper + nb_lower * nb_upper;
+    temp = osl_relation_pmalloc(precision, nb_rows, relation->nb_columns - 1);
+    nb_rows = 0;
+
+    osl_int_set_si(precision, &f1, 1);
+    osl_int_set_si(precision, &f2, 0);
+    for (i = 0; i < relation->nb_rows; i++) {
+      if (!osl_int_zero(precision, m[i][column]))
+        continue;
+      osl_int_assign(precision, &temp->m[nb_rows][0], m[i][0]);
+      osl_relation_row_combine(precision, relation->nb_columns, column,
+                               temp->m[nb_rows], f1, m[i], f2, m[i]);
+      nb_rows++;
+    }
+
+    // Lower bound a x + e >= 0 and upper bound -b x + f >= 0 give
+    // b e + a f >= 0, exact on integers if a or b is 1.
+    for (i = 0; i < relation->nb_rows; i++) {
+      if (!osl_int_pos(precision, m[i][column]))
+        continue;
+      for (j = 0; j < relation->nb_rows; j++) {
+        if (!osl_int_neg(precision, m[j][column]))
+          continue;
+        osl_int_oppose(precision, &f1, m[j][column]);
+        if (!osl_int_one(precision, f1) &&
+            !osl_int_one(precision, m[i][column]))
+          exact = 0;
+        osl_int_set_si(precision, &temp->m[nb_rows][0], 1);
+        osl_relation_row_combine(precision, relation->nb_columns, column,
+                                 temp->m[nb_rows], f1, m[i], m[i][column],
+                                 m[j]);
+        nb_rows++;
+      }
+    }
+  }
+  osl_int_clear(precision, &f1);
+  osl_int_clear(precision, &f2);
+
+  osl_relation_free_inside(relation);
+
+  // Replace the inside of relation and free the temp "shell".
+  relation->nb_rows = temp->nb_rows;
+  relation->nb_columns = temp->nb_columns;
+  relation->m = temp->m;
+  OSL_free(temp);
+
+  // Update the attributes, when they are defined.
+  if ((relation->nb_output_dims >= 0) && (relation->nb_input_dims >= 0) &&
+      (relation->nb_local_dims >= 0) && (relation->nb_parameters >= 0)) {
+    bound = 1 + relation->nb_output_dims;
+    if (column < bound) {
+      relation->nb_output_dims--;
+    } else if (column < (bound += relation->nb_input_dims)) {
+      relation->nb_input_dims--;
+    } else if (column < (bound += relation->nb_local_dims)) {
+      relation->nb_local_dims--;
+    } else {
+      relation->nb_parameters--;
+    }
+  }
+  osl_relation_part_tighten(relation);
+  osl_relation_part_canonicalize(relation);
+  return exact;
+}
+
+/**
+ * osl_relation_part_eliminate_nb_rows internal function:
+ * this function returns the number of rows osl_relation_part_eliminate()
+ * would build when projecting a given column out of a dense relation union
+ * part, before redundant rows are pruned, without building them.
+ * \param[in] relation The relation part to project.
+ * \param[in] column   The column to project out.
+ * \return The number of rows of the projection before pruning.
+ */
+long osl_relation_part_eliminate_nb_rows(const osl_relation_t* relation,
+                                         int column) {
+  int i;
+  int precision = relation->precision;
+  long nb_lower = 0, nb_upper = 0;
+
+  for (i = 0; i < relation->nb_rows; i++) {
+    if (osl_int_zero(precision, relation->m[i][column]))
+      continue;
+    if (osl_int_zero(precision, relation->m[i][0]))
+      return relation->nb_rows - 1;
+    if (osl_int_pos(precision, relation->m[i][column]))
+      nb_lower++;
+    else
+      nb_upper++;
+  }
+
+  return relation->nb_rows - nb_lower - nb_upper + nb_lower * nb_upper;
+}
+
+/**
+ * osl_relation_project_part internal function:
+ * this function is the loop body of osl_relation_project_out(): it projects
+ * the columns of the projection job out of one relation union part.
+ * \param[in,out] part The union part to project.
+ * \param[in]     i    The number of the union part to project.
+ * \param[in,out] data The projection job (osl_relation_projection_t).
+ */
+void osl_relation_project_part(osl_relation_t* part, int i, void* data) {
+  int column;
+  osl_relation_projection_p job = data;
+
+  job->exact[i] = 1;
+  for (column = job->first + job->count - 1; column >= job->first; column--)
+    if (!osl_relation_part_eliminate(part, column))
+      job->exact[i] = 0;
+}
+
+/**
+ * osl_relation_project_out function:
+ * this function projects "count" consecutive columns, starting from column
+ * "first_col" (the equality/inequality column is column 0), out of every
+ * part of a relation union. Each column is eliminated by substitution when
+ * an equality involves it and by Fourier-Motzkin elimination otherwise;
+ * between two eliminations the inequalities are tightened on integers and
+ * redundant rows are pruned to limit the row growth. The relation
+ * attributes are updated accordingly. Union parts are projected in
+ * parallel (see osl_relation_array_parallel_for()).
+ * \param[in,out] relation  The relation to project.
+ * \param[in]     first_col The first column to project out.
+ * \param[in]     count     The number of columns to project out.
+ * \return 1 if the projection is exact on integer points, 0 if the result
+ *         may contain integer points with no preimage.
+ */
+int osl_relation_project_out(osl_relation_t* relation, int first_col,
+                             int count) {
+  int i, nb_parts, exact = 1;
+  osl_relation_p part;
+  osl_relation_array_p array;
+  osl_relation_projection_t job;
+
+  for (part = relation; part != NULL; part = part->next) {
+    if ((first_col < 1) || (count < 0) ||
+        (first_col + count > part->nb_columns - 1))
+      OSL_error("bad column range");
+  }
+  if ((relation == NULL) || (count == 0))
+    return 1;
+
+  // Parts must be private: the threads do not update sharing counters.
+  osl_relation_to_dense(relation);
+  osl_relation_unshare(relation);
+
+  array = osl_relation_array_get(relation);
+  nb_parts = osl_relation_array_nb_parts(array);
+  OSL_malloc(job.exact, int*, (size_t)nb_parts * sizeof(int));
+  job.first = first_col;
+  job.count = count;
+  osl_relation_array_parallel_for(array, osl_relation_project_part, &job);
+
+  for (i = 0; i < nb_parts; i++)
+    exact = exact && job.exact[i];
+  OSL_free(job.exact);
+  return exact;
+}
+
+/**
+ * osl_relation_part_is_infeasible internal function:
+ * this function returns 1 if a row of a dense relation union part has no
+ * integer solution on its own: 0 == c or 0 >= c with a non-zero (resp.
+ * negative) constant c, or an equality whose constant is not a multiple of
+ * the gcd of its coefficients. It returns 0 otherwise.
+ * \param[in] relation The relation part to check.
+ * \return 1 if a row of the relation part is infeasible, 0 otherwise.
+ */
+int osl_relation_part_is_infeasible(const osl_relation_t* relation) {
+  int i, infeasible = 0;
+  int precision = relation->precision;
+  int constant = relation->nb_columns - 1;
+  osl_int_t gcd;
+
+  if (relation->nb_columns < 2)
+    return 0;
+
+  osl_int_init(precision, &gcd);
+  for (i = 0; (i < relation->nb_rows) && !infeasible; i++) {
+    const osl_int_t* row = relation->m[i];
+
+    osl_int_gcd_array(precision, &gcd, row + 1, (size_t)(constant - 1));
+    if (osl_int_zero(precision, gcd))
+      infeasible = osl_int_zero(precision, row[0])
+                       ? !osl_int_zero(precision, row[constant])
+                       : osl_int_neg(precision, row[constant]);
+    else if (osl_int_zero(precision, row[0]))
+      infeasible = !osl_int_divisible(precision, row[constant], gcd);
+  }
+  osl_int_clear(precision, &gcd);
+
+  return infeasible;
+}
+
+/**
+ * osl_relation_is_trivially_empty function:
+ * this function returns 1 if a relation (a union of polyhedra where every
+ * column, parameters included, is an integer variable) is found to contain
+ * no integer point by a conservative test, 0 otherwise. This is NOT an exact
+ * decision procedure: 0 means "not proven empty", not "non-empty". Each
+ * union part is checked by eliminating its columns one by one (see
+ * osl_relation_project_out()): a contradiction proves the part empty on
+ * rationals, or on integers thanks to the gcd test on equalities and to the
+ * tightening of inequalities. Integer-empty parts with a non-empty rational
+ * shadow may be missed, and the test gives up (returns 0) as soon as an
+ * elimination would produce more than OSL_RELATION_EMPTY_MAX_ROWS rows.
+ * A NULL relation is not proven empty. See osl_relation_is_empty() for an
+ * exact test.
+ * \param[in] relation The relation to check.
+ * \return 1 if the relation is proven empty, 0 if it is not proven empty.
+ */
+int osl_relation_is_trivially_empty(const osl_relation_t* relation) {
+  int column, empty = (relation != NULL);
+  osl_relation_p part;
+
+  for (; (relation != NULL) && empty; relation = relation->next) {
+    part = osl_relation_nclone(relation, 1);
+    osl_relation_part_to_dense(part);
+    osl_relation_part_unshare(part);
+    osl_relation_part_tighten(part);
+    empty = osl_relation_part_is_infeasible(part);
+    for (column = part->nb_columns - 2; (column > 0) && !empty; column--) {
+      if (osl_relation_part_eliminate_nb_rows(part, column) >
+          OSL_RELATION_EMPTY_MAX_ROWS)
+        break;
+      osl_relation_part_eliminate(part, column);
+      empty = osl_relation_part_is_infeasible(part);
+    }
+    osl_relation_free(part);
+  }
+
+  return empty;
+}
+
+/**
+ * osl_relation_part_solve_equalities internal function:
+ * this function removes the equalities of a (private) dense relation union
+ * part while keeping its integer points, all columns being integer
+ * variables. Each equality is reduced by unimodular column operations (the
+ * extended Euclid algorithm on its coefficients) until a single variable
+ * is left, which then has a fixed integer value or none (gcd test). The
+ * value is substituted in the other rows and the equality becomes a zero
+ * row. The part is left with inequalities only.
+ * \param[in,out] relation The (private) dense relation part to solve.
+ * \return 1 if an equality has no integer solution, 0 otherwise.
+ */
+int osl_relation_part_solve_equalities(osl_relation_t* relation) {
+  int i, j, k, r, reduced, empty = 0;
+  int precision = relation->precision;
+  int constant = relation->nb_columns - 1;
+  osl_int_t q, tmp;
+
+  osl_int_init(precision, &q);
+  osl_int_init(precision, &tmp);
+  for (i = 0; (i < relation->nb_rows) && !empty; i++) {
+    osl_int_t* row = relation->m[i];
+
+    if (!osl_int_zero(precision, row[0]))
+      continue;
+
+    for (;;) {
+      // Pivot on the smallest coefficient in absolute value.
+      k = 0;
+      for (j = 1; j < constant; j++) {
+        if (osl_int_zero(precision, row[j]))
+          continue;
+        osl_int_abs(precision, &q, row[j]);
+        if ((k == 0) || osl_int_lt(precision, q, tmp)) {
+          k = j;
+          osl_int_assign(precision, &tmp, q);
+        }
+      }
+      if (k == 0) {
+        empty = !osl_int_zero(precision, row[constant]);
+        break;
+      }
+
+      // Reduce the other coefficients modulo the pivot: column j -= q k.
+      reduced = 0;
+      for (j = 1; j < constant; j++) {
+        if ((j == k) || osl_int_zero(precision, row[j]))
+          continue;
+        osl_int_floor_div_q(precision, &q, row[j], row[k]);
+        for (r = 0; r < relation->nb_rows; r++) {
+          osl_int_mul(precision, &tmp, q, relation->m[r][k]);
+          osl_int_sub(precision, &relation->m[r][j], relation->m[r][j], tmp);
+        }
+        reduced = 1;
+      }
+      if (reduced)
+        continue;
+
+      // Single variable left: substitute its value, if it is an integer.
+      if (!osl_int_divisible(precision, row[constant], row[k])) {
+        empty = 1;
+        break;
+      }
+      osl_int_div_exact(precision, &q, row[constant], row[k]);
+      osl_int_oppose(precision, &q, q);
+      for (r = 0; r < relation->nb_rows; r++) {
+        osl_int_mul(precision, &tmp, q, relation->m[r][k]);
+        osl_int_add(precision, &relation->m[r][constant],
+                    relation->m[r][constant], tmp);
+        osl_int_set_si(precision, &relation->m[r][k], 0);
+      }
+      break;
+    }
+  }
+  osl_int_clear(precision, &q);
+  osl_int_clear(precision, &tmp);
+
+  return empty;
+}
+
+/**
+ * osl_relation_tableau_malloc internal function:
+ * this function builds the simplex tableau of the inequalities of a dense
+ * relation union part whose equalities are zero rows (see
+ * osl_relation_part_solve_equalities()). Each of the n variables x_j of
+ * the part (all columns but the first and the last ones) is split into
+ * p_j - q_j with p_j, q_j >= 0, and each inequality gets a slack variable
+ * r_i >= 0, basic in its row: r_i = b_i + sum_j a_ij (p_j - q_j) + s, where
+ * s >= 0 is the artificial variable of the feasibility problem. Variable 0
+ * is s, variables 1 to n are the p_j, n + 1 to 2n the q_j and the next ones
+ * the r_i. The last row is the objective -s.
+ * \param[in] relation The dense relation part.
+ * \return The simplex tableau of the relation part.
+ */
+osl_relation_tableau_t* osl_relation_tableau_malloc(
+    const osl_relation_t* relation) {
+  int i, j, k, n = relation->nb_columns - 2;
+  int precision = relation->precision;
+  osl_relation_tableau_p tableau;
+
+  OSL_malloc(tableau, osl_relation_tableau_p, sizeof(osl_relation_tableau_t));
+  tableau->precision = precision;
+  tableau->nb_rows = 0;
+  for (i = 0; i < relation->nb_rows; i++)
+    if (!osl_int_zero(precision, relation->m[i][0]))
+      tableau->nb_rows++;
+  tableau->nb_vars = 1 + 2 * n + tableau->nb_rows;
+
+  OSL_malloc(tableau->basis, int*,
+             (size_t)(tableau->nb_rows + 1) * sizeof(int));
+  OSL_malloc(tableau->denom, osl_int_t*,
+             (size_t)(tableau->nb_rows + 1) * sizeof(osl_int_t));
+  OSL_malloc(tableau->row, osl_int_t**,
+             (size_t)(tableau->nb_rows + 1) * sizeof(osl_int_t*));
+  for (k = 0; k <= tableau->nb_rows; k++) {
+    osl_int_init_set_si(precision, &tableau->denom[k], 1);
+    OSL_malloc(tableau->row[k], osl_int_t*,
+               (size_t)(tableau->nb_vars + 1) * sizeof(osl_int_t));
+    for (j = 0; j <= tableau->nb_vars; j++)
+      osl_int_init(precision, &tableau->row[k][j]);
+  }
+
+  for (i = 0, k = 0; i < relation->nb_rows; i++) {
+    if (osl_int_zero(precision, relation->m[i][0]))
+      continue;
+    tableau->basis[k] = 1 + 2 * n + k;
+    osl_int_assign(precision, &tableau->row[k][0], relation->m[i][n + 1]);
+    osl_int_set_si(precision, &tableau->row[k][1], 1);
+    for (j = 1; j <= n; j++) {
+      osl_int_assign(precision, &tableau->row[k][1 + j], relation->m[i][j]);
+      osl_int_oppose(precision, &tableau->row[k][1 + n + j],
+                     relation->m[i][j]);
+    }
+    k++;
+  }
+  tableau->basis[k] = -1;
+  osl_int_set_si(precision, &tableau->row[k][1], -1);
+
+  return tableau;
+}
+
+/**
+ * osl_relation_tableau_free internal function:
+ * this function frees the allocated memory for a simplex tableau.
+ * \param[in,out] tableau The simplex tableau to free.
+ */
+void osl_relation_tableau_free(osl_relation_tableau_t* tableau) {
+  int j, k;
+
+  for (k = 0; k <= tableau->nb_rows; k++) {
+    for (j = 0; j <= tableau->nb_vars; j++)
+      osl_int_clear(tableau->precision, &tableau->row[k][j]);
+    OSL_free(tableau->row[k]);
+    osl_int_clear(tableau->precision, &tableau->denom[k]);
+  }
+  OSL_free(tableau->row);
+  OSL_free(tableau->denom);
+  OSL_free(tableau->basis);
+  OSL_free(tableau);
+}
+
+/**
+ * osl_relation_tableau_normalize internal function:
+ * this function divides a row of a simplex tableau, denominator included,
+ * by the gcd of its elements.
+ * \param[in,out] tableau The simplex tableau.
+ * \param[in]     k       The row to normalize.
+ */
+void osl_relation_tableau_normalize(osl_relation_tableau_t* tableau, int k) {
+  int precision = tableau->precision;
+  size_t size = (size_t)tableau->nb_vars + 1;
+  osl_int_t gcd;
+
+  osl_int_init(precision, &gcd);
+  osl_int_gcd_array(precision, &gcd, tableau->row[k], size);
+  osl_int_gcd(precision, &gcd, gcd, tableau->denom[k]);
+  if (!osl_int_zero(precision, gcd) && !osl_int_one(precision, gcd)) {
+    osl_int_div_exact_array(precision, tableau->row[k], size, gcd);
+    osl_int_div_exact(precision, &tableau->denom[k], tableau->denom[k], gcd);
+  }
+  osl_int_clear(precision, &gcd);
+}
+
+/**
+ * osl_relation_tableau_pivot internal function:
+ * this function makes a non-basic variable basic in a given row of a
+ * simplex tableau, the basic variable of that row becoming non-basic. A row
+ * k stores denom[k] * basic = row[k][0] + sum_v row[k][1 + v] * v, for the
+ * non-basic variables v, with integers only.
+ * \param[in,out] tableau  The simplex tableau.
+ * \param[in]     pivot    The row of the pivot.
+ * \param[in]     variable The entering variable.
+ */
+void osl_relation_tableau_pivot(osl_relation_tableau_t* tableau, int pivot,
+                                int variable) {
+  int j, k;
+  int precision = tableau->precision;
+  size_t size = (size_t)tableau->nb_vars + 1;
+  osl_int_t* row = tableau->row[pivot];
+  osl_int_t coef;
+
+  // 0 = row + coef * variable - denom * basic, solved for the variable.
+  osl_int_init(precision, &coef);
+  osl_int_assign(precision, &coef, row[1 + variable]);
+  osl_int_set_si(precision, &row[1 + variable], 0);
+  osl_int_oppose(precision, &row[1 + tableau->basis[pivot]],
+                 tableau->denom[pivot]);
+  if (osl_int_pos(precision, coef))
+    osl_int_oppose_array(precision, row, size);
+  osl_int_abs(precision, &tableau->denom[pivot], coef);
+  tableau->basis[pivot] = variable;
+  osl_relation_tableau_normalize(tableau, pivot);
+
+  // Substitute the variable in the other rows.
+  for (k = 0; k <= tableau->nb_rows; k++) {
+    if ((k == pivot) || osl_int_zero(precision, tableau->row[k][1 + variable]))
+      continue;
+    osl_int_assign(precision, &coef, tableau->row[k][1 + variable]);
+    osl_int_set_si(precision, &tableau->row[k][1 + variable], 0);
+    for (j = 0; j < (int)size; j++)
+      osl_int_mul(precision, &tableau->row[k][j], tableau->row[k][j],
+                  tableau->denom[pivot]);
+    osl_int_addmul_array(precision, tableau->row[k], row, size, coef);
+    osl_int_mul(precision, &tableau->denom[k], tableau->denom[k],
+                tableau->denom[pivot]);
+    osl_relation_tableau_normalize(tableau, k);
+  }
+  osl_int_clear(precision, &coef);
+}
+
+/**
+ * osl_relation_tableau_is_feasible internal function:
+ * this function solves the feasibility problem of a simplex tableau (see
+ * osl_relation_tableau_malloc()) exactly on rationals: the artificial
+ * variable enters the basis in the most violated row, which makes the
+ * basic solution feasible, then the objective -s is maximized by the
+ * primal simplex with Bland's rule, which cannot cycle. The inequalities
+ * are feasible if and only if the maximum is 0.
+ * \param[in,out] tableau The simplex tableau.
+ * \return 1 if the inequalities have a rational solution, 0 otherwise.
+ */
+int osl_relation_tableau_is_feasible(osl_relation_tableau_t* tableau) {
+  int k, v, pivot, variable;
+  int precision = tableau->precision;
+  int objective = tableau->nb_rows;
+  osl_int_t a, b;
+
+  // Rows have a denominator of 1 at this point.
+  pivot = -1;
+  for (k = 0; k < tableau->nb_rows; k++)
+    if (osl_int_neg(precision, tableau->row[k][0]) &&
+        ((pivot < 0) ||
+         osl_int_lt(precision, tableau->row[k][0], tableau->row[pivot][0])))
+      pivot = k;
+  if (pivot < 0)
+    return 1;
+  osl_relation_tableau_pivot(tableau, pivot, 0);
+
+  osl_int_init(precision, &a);
+  osl_int_init(precision, &b);
+  for (;;) {
+    variable = -1;
+    for (v = 0; (v < tableau->nb_vars) && (variable < 0); v++)
+      if (osl_int_pos(precision, tableau->row[objective][1 + v]))
+        variable = v;
+    if (variable < 0)
+      break;
+
+    // Ratio test: row k bounds the variable by row[k][0] / -row[k][v], the
+    // bound of k is lower than the one of the pivot iff a > b.
+    pivot = -1;
+    for (k = 0; k < tableau->nb_rows; k++) {
+      if (!osl_int_neg(precision, tableau->row[k][1 + variable]))
+        continue;
+      if (pivot >= 0) {
+        osl_int_mul(precision, &a, tableau->row[k][0],
+                    tableau->row[pivot][1 + variable]);
+        osl_int_mul(precision, &b, tableau->row[pivot][0],
+                    tableau->row[k][1 + variable]);
+        if (osl_int_lt(precision, a, b) ||
+            (osl_int_eq(precision, a, b) &&
+             (tableau->basis[k] > tableau->basis[pivot])))
+          continue;
+      }
+      pivot = k;
+    }
+    if (pivot < 0)
+      break;
+    osl_relation_tableau_pivot(tableau, pivot, variable);
+  }
+  osl_int_clear(precision, &a);
+  osl_int_clear(precision, &b);
+
+  return osl_int_zero(precision, tableau->row[objective][0]);
+}
+
+/**
+ * osl_relation_tableau_fractional internal function:
+ * this function looks for a variable x_j = p_j - q_j of a feasible simplex
+ * tableau whose value in the basic solution is not an integer.
+ * \param[in]  tableau The simplex tableau.
+ * \param[in]  n       The number of variables x_j.
+ * \param[out] value   The floor of the value of the variable found.
+ * \return The number j of the variable found (from 1), 0 if none.
+ */
+int osl_relation_tableau_fractional(const osl_relation_tableau_t* tableau,
+                                    int n, osl_int_t* value) {
+  int j, k, found = 0;
+  int precision = tableau->precision;
+  osl_int_t num, den, tmp;
+
+  osl_int_init(precision, &num);
+  osl_int_init(precision, &den);
+  osl_int_init(precision, &tmp);
+  for (j = 1; (j <= n) && !found; j++) {
+    // x_j = num / den, from the basic values of p_j and q_j (0 otherwise).
+    osl_int_set_si(precision, &num, 0);
+    osl_int_set_si(precision, &den, 1);
+    for (k = 0; k < tableau->nb_rows; k++) {
+      if (tableau->basis[k] == j) {
+        osl_int_mul(precision, &num, num, tableau->denom[k]);
+        osl_int_mul(precision, &tmp, tableau->row[k][0], den);
+        osl_int_add(precision, &num, num, tmp);
+        osl_int_mul(precision, &den, den, tableau->denom[k]);
+      } else if (tableau->basis[k] == n + j) {
+        osl_int_mul(precision, &num, num, tableau->denom[k]);
+        osl_int_mul(precision, &tmp, tableau->row[k][0], den);
+        osl_int_sub(precision, &num, num, tmp);
+        osl_int_mul(precision, &den, den, tableau->denom[k]);
+      }
+    }
+    if (!osl_int_divisible(precision, num, den)) {
+      osl_int_floor_div_q(precision, value, num, den);
+      found = j;
+    }
+  }
+  osl_int_clear(precision, &num);
+  osl_int_clear(precision, &den);
+  osl_int_clear(precision, &tmp);
+
+  return found;
+}
+
+/**
+ * osl_relation_part_is_integer_empty internal function:
+ * this function decides whether a (private) dense relation union part with
+ * inequalities only has an integer point, by branch and bound: the
+ * rational simplex gives a solution, and if a variable x_j has a
+ * fractional value v, both x_j <= floor(v) and x_j >= floor(v) + 1 are
+ * explored. The search gives up after OSL_RELATION_EMPTY_MAX_NODES nodes.
+ * \param[in,out] relation The relation part (modified).
+ * \param[in,out] nb_nodes Number of nodes explored so far.
+ * \return 1 if the part has no integer point, 0 if it has one or if the
+ *         search gave up.
+ */
+int osl_relation_part_is_integer_empty(osl_relation_t* relation,
+                                       int* nb_nodes) {
+  int j, k, row, empty;
+  int precision = relation->precision;
+  int constant = relation->nb_columns - 1;
+  osl_int_t value;
+  osl_relation_p branch;
+  osl_relation_tableau_p tableau;
+
+  if (++(*nb_nodes) > OSL_RELATION_EMPTY_MAX_NODES)
+    return 0;
+
+  osl_relation_part_tighten(relation);
+  if (osl_relation_part_is_infeasible(relation))
+    return 1;
+
+  osl_int_init(precision, &value);
+  tableau = osl_relation_tableau_malloc(relation);
+  empty = !osl_relation_tableau_is_feasible(tableau);
+  j = 0;
+  if (!empty)
+    j = osl_relation_tableau_fractional(tableau, constant - 1, &value);
+  osl_relation_tableau_free(tableau);
+
+  // Branch on x_j <= floor(v), then on x_j >= floor(v) + 1.
+  if (j > 0)
+    empty = 1;
+  for (k = 0; (k < 2) && (j > 0) && empty; k++) {
+    branch = osl_relation_nclone(relation, 1);
+    row = branch->nb_rows;
+    osl_relation_insert_blank_row(branch, row);
+    osl_int_set_si(precision, &branch->m[row][0], 1);
+    if (k == 0) {
+      osl_int_set_si(precision, &branch->m[row][j], -1);
+      osl_int_assign(precision, &branch->m[row][constant], value);
+    } else {
+      osl_int_set_si(precision, &branch->m[row][j], 1);
+      osl_int_add_si(precision, &value, value, 1);
+      osl_int_oppose(precision, &branch->m[row][constant], value);
+    }
+    empty = osl_relation_part_is_integer_empty(branch, nb_nodes);
+    osl_relation_free(branch);
+  }
+  osl_int_clear(precision, &value);
+
+  return empty;
+}
+
+/**
+ * osl_relation_is_empty function:
+ * this function returns 1 if a relation (a union of polyhedra where every
+ * column, parameters included, is an integer variable) contains no integer
+ * point, 0 otherwise. Each union part is decided exactly, in multiple
+ * precision if available: its equalities are solved on integers (see
+ * osl_relation_part_solve_equalities()), then an exact rational simplex
+ * checks its inequalities and branch and bound refines it on integers.
+ * The search on a part gives up after OSL_RELATION_EMPTY_MAX_NODES nodes,
+ * which may only happen for parts with many or unbounded integer points,
+ * and the part is then considered non-empty: 1 always means empty. A NULL
+ * relation is not considered empty.
+ * \param[in] relation The relation to check.
+ * \return 1 if the relation is empty, 0 otherwise.
+ */
+int osl_relation_is_empty(const osl_relation_t* relation) {
+  int nb_nodes, empty = (relation != NULL);
+  int precision = OSL_PRECISION_DP;
+  osl_relation_p part;
+
+  if (osl_int_is_precision_supported(OSL_PRECISION_MP))
+    precision = OSL_PRECISION_MP;
+
+  for (; (relation != NULL) && empty; relation = relation->next) {
+    if (relation->nb_columns < 2) {
+      empty = 0;
+      break;
+    }
+    part = osl_relation_nclone(relation, 1);
+    osl_relation_part_to_dense(part);
+    osl_relation_part_unshare(part);
+    osl_relation_set_precision(precision, part);
+    nb_nodes = 0;
+    empty = osl_relation_part_solve_equalities(part) ||
+            osl_relation_part_is_integer_empty(part, &nb_nodes);
+    osl_relation_free(part);
+  }
+
+  return empty;
 }
 
 /**
@@ -2228,7 +3964,7 @@ void osl_relation_insert_columns(osl_relation_t* const relation,
                                  const osl_relation_t* const insert,
                                  int column) {
   int i, j;
-  osl_relation_p temp;
+  osl_relation_p temp, dense;
 
   if ((relation == NULL) || (insert == NULL))
     return;
@@ -2238,6 +3974,15 @@ void osl_relation_insert_columns(osl_relation_t* const relation,
       (column > relation->nb_columns))
     OSL_error("columns cannot be inserted");
 
+  if (insert->sparse != NULL) {
+    dense = osl_relation_dense_nclone(insert, 1);
+    osl_relation_insert_columns(relation, dense, column);
+    osl_relation_free(dense);
+    return;
+  }
+
+  osl_relation_part_to_dense(relation);
+
   // We use a temporary relation just to reuse existing functions. Cleaner.
   temp = osl_relation_pmalloc(relation->precision, relation->nb_rows,
                               relation->nb_columns + insert->nb_columns);
@@ -2263,7 +4008,7 @@ void osl_relation_insert_columns(osl_relation_t* const relation,
   relation->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  OSL_free(temp);
 }
 
 /**
@@ -2314,8 +4059,6 @@ osl_relation_p osl_relation_concat_constraints(const osl_relation_t* const r1,
  */
 bool osl_relation_part_equal(const osl_relation_t* const r1,
                              const osl_relation_t* const r2) {
-  int i, j;
-
   if (r1 == r2)
     return 1;
 
@@ -2330,10 +4073,87 @@ bool osl_relation_part_equal(const osl_relation_t* const r1,
       (r1->nb_parameters != r2->nb_parameters))
     return 0;
 
-  for (i = 0; i < r1->nb_rows; ++i)
-    for (j = 0; j < r1->nb_columns; ++j)
-      if (osl_int_ne(r1->precision, r1->m[i][j], r2->m[i][j]))
+  return osl_relation_storage_equal(r1, r2);
+}
+
+/**
+ * osl_relation_storage_equal internal function:
+ * this function returns true if the matrices of two relation union parts
+ * with the same sizes and precision are the same, false otherwise.
+ * \param[in] r1 The first relation part.
+ * \param[in] r2 The second relation part.
+ * \return 1 if the matrices of r1 and r2 are the same, 0 otherwise.
+ */
+bool osl_relation_storage_equal(const osl_relation_t* r1,
+                                const osl_relation_t* r2) {
+  if ((r1->shared != NULL) && (r2->shared != NULL)) {
+    if (r1->shared == r2->shared)
+      return 1;
+    // Shared matrices have a cached hash: different hashes, different data.
+    if (r1->shared->hash != r2->shared->hash)
+      return 0;
+  }
+
+  if ((r1->sparse != NULL) || (r2->sparse != NULL))
+    return osl_relation_sparse_part_equal(r1, r2);
+
+  // Dense matrices are stored in one contiguous block (see pmalloc).
+  if ((r1->nb_rows == 0) || (r1->nb_columns == 0))
+    return 1;
+  return osl_int_eq_array(r1->precision, r1->m[0], r2->m[0],
+                          (size_t)r1->nb_rows * (size_t)r1->nb_columns);
+}
+
+/**
+ * osl_relation_sparse_part_equal internal function:
+ * this function returns true if the matrices of two relation union parts
+ * with the same sizes and precision are the same, false otherwise, when at
+ * least one of them is stored in sparse form.
+ * \param[in] r1 The first relation part.
+ * \param[in] r2 The second relation part.
+ * \return 1 if the matrices of r1 and r2 are the same, 0 otherwise.
+ */
+bool osl_relation_sparse_part_equal(const osl_relation_t* r1,
+                                    const osl_relation_t* r2) {
+  int i, j, k, end;
+  const osl_relation_sparse_t* sparse;
+
+  // Both sparse: the representation is canonical.
+  if ((r1->sparse != NULL) && (r2->sparse != NULL)) {
+    if (r1->sparse->nb_nonzeros != r2->sparse->nb_nonzeros)
+      return 0;
+    if (memcmp(r1->sparse->row_start, r2->sparse->row_start,
+               (size_t)(r1->nb_rows + 1) * sizeof(int)))
+      return 0;
+    if ((r1->sparse->nb_nonzeros > 0) &&
+        memcmp(r1->sparse->column, r2->sparse->column,
+               (size_t)r1->sparse->nb_nonzeros * sizeof(int)))
+      return 0;
+    return osl_int_eq_array(r1->precision, r1->sparse->value,
+                            r2->sparse->value,
+                            (size_t)r1->sparse->nb_nonzeros);
+  }
+
+  // One sparse, one dense: walk the sparse rows along the dense ones.
+  if (r1->sparse == NULL) {
+    const osl_relation_t* swap = r1;
+    r1 = r2;
+    r2 = swap;
+  }
+  sparse = r1->sparse;
+  for (i = 0; i < r1->nb_rows; i++) {
+    k = sparse->row_start[i];
+    end = sparse->row_start[i + 1];
+    for (j = 0; j < r1->nb_columns; j++) {
+      if ((k < end) && (sparse->column[k] == j)) {
+        if (osl_int_ne(r1->precision, sparse->value[k], r2->m[i][j]))
+          return 0;
+        k++;
+      } else if (!osl_int_zero(r1->precision, r2->m[i][j])) {
         return 0;
+      }
+    }
+  }
 
   return 1;
 }
@@ -2358,7 +4178,96 @@ bool osl_relation_equal(const osl_relation_t* r1, const osl_relation_t* r2) {
   if (((r1 == NULL) && (r2 != NULL)) || ((r1 != NULL) && (r2 == NULL)))
     return 0;
 
-  return 1;
+  return 1;
+}
+
+/**
+ * osl_relation_part_hash function:
+ * this function returns a 64-bit hash of the content of a relation union
+ * part (the next parts are ignored). The hash does not depend on the
+ * precision nor on the storage (dense or sparse) of the relation: two parts
+ * with the same type, sizes and values have the same hash.
+ * \param[in] relation The relation part to hash (possibly NULL).
+ * \return The hash of the relation part.
+ */
+uint64_t osl_relation_part_hash(const osl_relation_t* const relation) {
+  uint64_t hash = 0;
+
+  if (relation == NULL)
+    return osl_util_hash_combine(hash, 0);
+
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->type);
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_output_dims);
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_input_dims);
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_local_dims);
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_parameters);
+
+  // Shared matrices are immutable: their hash is computed once.
+  if (relation->shared != NULL)
+    return osl_util_hash_combine(hash, relation->shared->hash);
+  return osl_util_hash_combine(hash, osl_relation_storage_hash(relation));
+}
+
+/**
+ * osl_relation_storage_hash internal function:
+ * this function returns a 64-bit hash of the matrix of a relation union
+ * part. Only the sizes and the non-zero (column, value) pairs of each row
+ * are hashed, so that the hash depends neither on the precision nor on the
+ * layout (dense or sparse) of the matrix.
+ * \param[in] relation The relation part whose matrix is hashed.
+ * \return The hash of the matrix of the relation part.
+ */
+uint64_t osl_relation_storage_hash(const osl_relation_t* relation) {
+  uint64_t hash = 0;
+  int i, j, k;
+  const osl_relation_sparse_t* sparse = relation->sparse;
+
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_rows);
+  hash = osl_util_hash_combine(hash, (uint64_t)relation->nb_columns);
+  for (i = 0; i < relation->nb_rows; i++) {
+    if (sparse != NULL) {
+      for (k = sparse->row_start[i]; k < sparse->row_start[i + 1]; k++) {
+        if (osl_int_zero(relation->precision, sparse->value[k]))
+          continue;
+        hash = osl_util_hash_combine(hash, (uint64_t)sparse->column[k]);
+        hash = osl_util_hash_combine(
+            hash, osl_int_hash(relation->precision, sparse->value[k]));
+      }
+    } else {
+      for (j = 0; j < relation->nb_columns; j++) {
+        if (osl_int_zero(relation->precision, relation->m[i][j]))
+          continue;
+        hash = osl_util_hash_combine(hash, (uint64_t)j);
+        hash = osl_util_hash_combine(
+            hash, osl_int_hash(relation->precision, relation->m[i][j]));
+      }
+    }
+    // End of row marker (columns are non-negative).
+    hash = osl_util_hash_combine(hash, UINT64_MAX);
+  }
+
+  return hash;
+}
+
+/**
+ * osl_relation_hash function:
+ * this function returns a 64-bit hash of the content of a relation (union).
+ * Two relations that are equal according to osl_relation_equal() have the
+ * same hash, and the hash is the same in every precision (see
+ * osl_relation_part_hash()).
+ * \param[in] relation The relation to hash (possibly NULL).
+ * \return The hash of the relation.
+ */
+uint64_t osl_relation_hash(const osl_relation_t* relation) {
+  uint64_t hash = 0;
+  int nb_parts = 0;
+
+  for (; relation != NULL; relation = relation->next) {
+    hash = osl_util_hash_combine(hash, osl_relation_part_hash(relation));
+    nb_parts++;
+  }
+
+  return osl_util_hash_combine(hash, (uint64_t)nb_parts);
 }
 
 /**
@@ -2445,6 +4354,7 @@ int osl_relation_integrity_check(const osl_relation_t* relation,
                                  int expected_nb_input_dims,
                                  int expected_nb_parameters) {
   int i;
+  osl_int_t tag;
 
   // Check the NULL case.
   if (relation == NULL) {
@@ -2528,16 +4438,20 @@ int osl_relation_integrity_check(const osl_relation_t* relation,
     // Check the first column. The first column of a relation part should be
     // made of 0 or 1 only.
     if ((relation->nb_rows > 0) && (relation->nb_columns > 0)) {
+      osl_int_init(relation->precision, &tag);
       for (i = 0; i < relation->nb_rows; i++) {
-        if (!osl_int_zero(relation->precision, relation->m[i][0]) &&
-            !osl_int_one(relation->precision, relation->m[i][0])) {
+        osl_relation_get_value(relation, i, 0, &tag);
+        if (!osl_int_zero(relation->precision, tag) &&
+            !osl_int_one(relation->precision, tag)) {
           OSL_warning(
               "first column of a relation is not "
               "strictly made of 0 or 1");
           osl_relation_dump(stderr, relation);
+          osl_int_clear(relation->precision, &tag);
           return 0;
         }
       }
+      osl_int_clear(relation->precision, &tag);
     }
 
     // Array accesses must provide the array identifier.
@@ -2608,22 +4522,123 @@ void osl_relation_set_type(osl_relation_t* relation, int type) {
   }
 }
 
+/**
+ * osl_relation_part_array_id internal function:
+ * this function computes the array identifier of an access relation union
+ * part, without looking at the cached value nor at the other parts.
+ * \param[in] relation The access relation part where to find the identifier.
+ * \param[in] warn     1 to warn about irregularities, 0 to stay silent.
+ * \return The array identifier of the part or OSL_UNDEFINED.
+ */
+int osl_relation_part_array_id(const osl_relation_t* relation, int warn) {
+  int i, array_id;
+  int nb_array_id = 0;
+  int row_id = 0;
+  int precision = relation->precision;
+  osl_relation_p dense;
+
+  if (osl_relation_is_sparse(relation)) {
+    dense = osl_relation_dense_nclone(relation, 1);
+    array_id = osl_relation_part_array_id(dense, warn);
+    osl_relation_free(dense);
+    return array_id;
+  }
+
+  // There should be room to store the array identifier.
+  if ((relation->nb_rows < 1) || (relation->nb_columns < 3)) {
+    if (warn)
+      OSL_warning("no array identifier in an access function");
+    return OSL_UNDEFINED;
+  }
+
+  // Array identifiers are m[i][#columns -1] / m[i][1], with i the only row
+  // where m[i][1] is not 0.
+  // - check there is exactly one row such that m[i][1] is not 0,
+  // - check the whole ith row if full of 0 except m[i][1] and the id,
+  // - check that (m[i][#columns -1] % m[i][1]) == 0,
+  // - check that (-m[i][#columns -1] / m[i][1]) > 0.
+  for (i = 0; i < relation->nb_rows; i++) {
+    if (!osl_int_zero(precision, relation->m[i][1])) {
+      nb_array_id++;
+      row_id = i;
+    }
+  }
+  if (nb_array_id == 0) {
+    if (warn)
+      OSL_warning("no array identifier in an access function");
+    return OSL_UNDEFINED;
+  }
+  if (nb_array_id > 1) {
+    if (warn)
+      OSL_warning("several array identifiers in one access function");
+    return OSL_UNDEFINED;
+  }
+  for (i = 0; i < relation->nb_columns - 1; i++) {
+    if ((i != 1) && !osl_int_zero(precision, relation->m[row_id][i])) {
+      if (warn)
+        OSL_warning("non integer array identifier");
+      return OSL_UNDEFINED;
+    }
+  }
+  if (!osl_int_divisible(precision,
+                         relation->m[row_id][relation->nb_columns - 1],
+                         relation->m[row_id][1])) {
+    if (warn)
+      OSL_warning("rational array identifier");
+    return OSL_UNDEFINED;
+  }
+  array_id = -osl_int_get_si(precision,
+                             relation->m[row_id][relation->nb_columns - 1]);
+  array_id /= osl_int_get_si(precision, relation->m[row_id][1]);
+  if (array_id <= 0) {
+    if (warn)
+      OSL_warning("negative or 0 identifier in access function");
+    return OSL_UNDEFINED;
+  }
+
+  return array_id;
+}
+
+/**
+ * osl_relation_cache_array_id function:
+ * this function computes and caches the array identifier of every part of
+ * an access relation union (see osl_relation_get_array_id()), silently
+ * leaving the cache empty for the parts where it cannot be found. It does
+ * nothing for other relations. Nothing is cached implicitly: this function
+ * is meant to be called before querying identifiers repeatedly, e.g. by
+ * osl_access_index_generate(). Parts with a cached identifier are trusted
+ * and kept as they are.
+ * \param[in,out] relation The relation where to cache array identifiers.
+ */
+void osl_relation_cache_array_id(osl_relation_t* relation) {
+  int array_id;
+
+  if ((relation == NULL) || !osl_relation_is_access(relation))
+    return;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->array_id == 0) {
+      array_id = osl_relation_part_array_id(relation, 0);
+      if (array_id != OSL_UNDEFINED)
+        relation->array_id = array_id;
+    }
+  }
+}
+
 /**
  * osl_relation_get_array_id function:
  * this function returns the array identifier in a relation with access type
  * It returns OSL_UNDEFINED if it is not able to find it (in particular
- * if there are irregularities in the relation).
+ * if there are irregularities in the relation). The cached identifier of a
+ * part (see osl_relation_cache_array_id()) is trusted and returned in
+ * constant time: library functions modifying the matrix reset it, and so
+ * does osl_relation_unshare(), to call before writing in m directly.
  * \param[in] relation The relation where to find an array identifier.
  * \return The array identifier in the relation or OSL_UNDEFINED.
  */
 int osl_relation_get_array_id(const osl_relation_t* relation) {
-  int i;
-  int first = 1;
   int array_id = OSL_UNDEFINED;
   int reference_array_id = OSL_UNDEFINED;
-  int nb_array_id;
-  int row_id = 0;
-  int precision;
 
   if (relation == NULL)
     return OSL_UNDEFINED;
@@ -2634,66 +4649,21 @@ int osl_relation_get_array_id(const osl_relation_t* relation) {
   }
 
   while (relation != NULL) {
-    precision = relation->precision;
-
-    // There should be room to store the array identifier.
-    if ((relation->nb_rows < 1) || (relation->nb_columns < 3)) {
-      OSL_warning("no array identifier in an access function");
-      return OSL_UNDEFINED;
-    }
-
-    // Array identifiers are m[i][#columns -1] / m[i][1], with i the only row
-    // where m[i][1] is not 0.
-    // - check there is exactly one row such that m[i][1] is not 0,
-    // - check the whole ith row if full of 0 except m[i][1] and the id,
-    // - check that (m[i][#columns -1] % m[i][1]) == 0,
-    // - check that (-m[i][#columns -1] / m[i][1]) > 0.
-    nb_array_id = 0;
-    for (i = 0; i < relation->nb_rows; i++) {
-      if (!osl_int_zero(precision, relation->m[i][1])) {
-        nb_array_id++;
-        row_id = i;
-      }
-    }
-    if (nb_array_id == 0) {
-      OSL_warning("no array identifier in an access function");
-      return OSL_UNDEFINED;
-    }
-    if (nb_array_id > 1) {
-      OSL_warning("several array identifiers in one access function");
-      return OSL_UNDEFINED;
-    }
-    for (i = 0; i < relation->nb_columns - 1; i++) {
-      if ((i != 1) && !osl_int_zero(precision, relation->m[row_id][i])) {
-        OSL_warning("non integer array identifier");
+    array_id = relation->array_id;
+    if (array_id == 0) {
+      array_id = osl_relation_part_array_id(relation, 1);
+      if (array_id == OSL_UNDEFINED)
         return OSL_UNDEFINED;
-      }
-    }
-    if (!osl_int_divisible(precision,
-                           relation->m[row_id][relation->nb_columns - 1],
-                           relation->m[row_id][1])) {
-      OSL_warning("rational array identifier");
-      return OSL_UNDEFINED;
-    }
-    array_id = -osl_int_get_si(precision,
-                               relation->m[row_id][relation->nb_columns - 1]);
-    array_id /= osl_int_get_si(precision, relation->m[row_id][1]);
-    if (array_id <= 0) {
-      OSL_warning("negative or 0 identifier in access function");
-      return OSL_UNDEFINED;
     }
 
     // Unions of accesses are allowed, but they should refer at the same array.
-    if (first) {
+    if (reference_array_id == OSL_UNDEFINED) {
       reference_array_id = array_id;
-      first = 0;
-    } else {
-      if (reference_array_id != array_id) {
-        OSL_warning(
-            "inconsistency of array identifiers in an "
-            "union of access relations");
-        return OSL_UNDEFINED;
-      }
+    } else if (reference_array_id != array_id) {
+      OSL_warning(
+          "inconsistency of array identifiers in an "
+          "union of access relations");
+      return OSL_UNDEFINED;
     }
 
     relation = relation->next;
@@ -2826,7 +4796,14 @@ osl_relation_t* osl_relation_extend_output(const osl_relation_t* relation,
   int first = 1;
   int offset;
   int precision = relation->precision;
-  osl_relation_p extended = NULL, node, previous = NULL;
+  osl_relation_p extended = NULL, node, previous = NULL, dense;
+
+  if (osl_relation_is_sparse(relation)) {
+    dense = osl_relation_dense_nclone(relation, -1);
+    extended = osl_relation_extend_output(dense, dim);
+    osl_relation_free(dense);
+    return extended;
+  }
 
   while (relation != NULL) {
     if (relation->nb_output_dims > dim)
@@ -2873,9 +4850,83 @@ osl_relation_t* osl_relation_extend_output(const osl_relation_t* relation,
     relation = relation->next;
   }
 
+  if ((extended != NULL) && (extended->next != NULL))
+    osl_relation_array_sync(extended);
+
   return extended;
 }
 
+/**
+ * osl_relation_extend_output_inplace function:
+ * this function is equivalent to osl_relation_extend_output() except that it
+ * directly updates the relation instead of returning an extended copy. The
+ * union parts that already have "dim" output dimensions are left untouched,
+ * and the others are remapped in a single pass that moves their elements to
+ * their new place (sparse parts become dense, as with the copying version).
+ * \param[in,out] relation The relation to extend.
+ * \param[in]     dim      The number of output dimension to reach.
+ */
+void osl_relation_extend_output_inplace(osl_relation_t* relation, int dim) {
+  int i, j, k, offset, precision, move;
+  osl_relation_p temp;
+  osl_relation_sparse_p sparse;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->nb_output_dims > dim)
+      OSL_error("Number of output dims is greater than required extension");
+    if ((offset = dim - relation->nb_output_dims) == 0)
+      continue;
+
+    precision = relation->precision;
+    temp = osl_relation_pmalloc(precision, relation->nb_rows + offset,
+                                relation->nb_columns + offset);
+
+    // Elements of a matrix owned by this part only are moved, not copied.
+    move = (relation->shared == NULL);
+    if (relation->sparse != NULL) {
+      sparse = relation->sparse;
+      for (i = 0; i < relation->nb_rows; i++) {
+        for (k = sparse->row_start[i]; k < sparse->row_start[i + 1]; k++) {
+          j = sparse->column[k];
+          if (j > relation->nb_output_dims)
+            j += offset;
+          if (move)
+            osl_int_swap(precision, &temp->m[i][j], &sparse->value[k]);
+          else
+            osl_int_assign(precision, &temp->m[i][j], sparse->value[k]);
+        }
+      }
+    } else {
+      for (i = 0; i < relation->nb_rows; i++) {
+        for (j = 0; j < relation->nb_columns; j++) {
+          k = (j > relation->nb_output_dims) ? j + offset : j;
+          if (move)
+            osl_int_swap(precision, &temp->m[i][k], &relation->m[i][j]);
+          else
+            osl_int_assign(precision, &temp->m[i][k], relation->m[i][j]);
+        }
+      }
+    }
+
+    // New rows dedicated to the new dimensions.
+    for (i = 0; i < offset; i++) {
+      j = relation->nb_output_dims + 1 + i;
+      osl_int_set_si(precision, &temp->m[relation->nb_rows + i][j], -1);
+    }
+
+    osl_relation_free_inside(relation);
+
+    // Replace the inside of relation.
+    relation->nb_rows = temp->nb_rows;
+    relation->nb_columns = temp->nb_columns;
+    relation->nb_output_dims = dim;
+    relation->m = temp->m;
+
+    // Free the temp "shell".
+    OSL_free(temp);
+  }
+}
+
 /**
  * osl_relation_interface function:
  * this function creates an interface structure corresponding to the relation
@@ -2906,11 +4957,19 @@ osl_interface_t* osl_relation_interface(void) {
 void osl_relation_set_precision(int const precision, osl_relation_t* r) {
   while (r != NULL) {
     if (precision != r->precision) {
-      size_t i;
-      size_t j;
-      for (i = 0; i < (size_t)r->nb_rows; ++i) {
-        for (j = 0; j < (size_t)r->nb_columns; ++j) {
-          osl_int_set_precision(r->precision, precision, &r->m[i][j]);
+      osl_relation_part_unshare(r);
+      if (r->sparse != NULL) {
+        int k;
+        for (k = 0; k < r->sparse->nb_nonzeros; ++k) {
+          osl_int_set_precision(r->precision, precision, &r->sparse->value[k]);
+        }
+      } else {
+        size_t i;
+        size_t j;
+        for (i = 0; i < (size_t)r->nb_rows; ++i) {
+          for (j = 0; j < (size_t)r->nb_columns; ++j) {
+            osl_int_set_precision(r->precision, precision, &r->m[i][j]);
+          }
         }
       }
       r->precision = precision;
@@ -2950,12 +5009,33 @@ void osl_relation_set_same_precision(osl_relation_t* const a,
  */
 void osl_relation_remove_part(osl_relation_t** relation_list,
                               osl_relation_t* part) {
+  int k;
   osl_relation_p relation, previous;
+  osl_relation_array_p array;
 
   if (relation_list == NULL || *relation_list == NULL || part == NULL) {
     return;
   }
 
+  if (osl_relation_array_is_current(*relation_list)) {
+    array = (*relation_list)->parts;
+    for (k = 0; k < array->nb_parts; k++) {
+      if (array->part[k] == part) {
+        if (k == 0)
+          *relation_list = part->next;
+        relation = osl_relation_array_remove(array, k);
+        if (k > 0)
+          osl_relation_free(relation);
+        return;
+      }
+    }
+    return;
+  }
+
+  // A stale relation array may reference the removed part.
+  osl_relation_array_free((*relation_list)->parts);
+  (*relation_list)->parts = NULL;
+
   if (*relation_list == part) {
     *relation_list = (*relation_list)->next;
     return;
@@ -2973,3 +5053,547 @@ void osl_relation_remove_part(osl_relation_t** relation_list,
     previous = relation;
   }
 }
+
+/**
+ * osl_relation_is_sparse function:
+ * this function returns 1 if at least one part of a relation union stores
+ * its matrix in sparse form, 0 otherwise.
+ * \param[in] relation The relation to check.
+ * \return 1 if a part of the relation is sparse, 0 otherwise.
+ */
+int osl_relation_is_sparse(const osl_relation_t* relation) {
+  while (relation != NULL) {
+    if (relation->sparse != NULL)
+      return 1;
+    relation = relation->next;
+  }
+
+  return 0;
+}
+
+/**
+ * osl_relation_to_sparse function:
+ * this function converts the matrix of every part of a relation union to
+ * the compressed sparse row form: only the non-zero elements are stored
+ * (see osl_relation_sparse_t) and the m field is set to NULL. It is worth
+ * it for wide relations with few non-zero elements per row, e.g.,
+ * dependence polyhedra. The relation is updated directly.
+ * \param[in,out] relation The relation to convert.
+ */
+void osl_relation_to_sparse(osl_relation_t* relation) {
+  int i, j, nb_nonzeros;
+  osl_relation_p temp;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->sparse != NULL)
+      continue;
+
+    nb_nonzeros = 0;
+    for (i = 0; i < relation->nb_rows; i++)
+      for (j = 0; j < relation->nb_columns; j++)
+        if (!osl_int_zero(relation->precision, relation->m[i][j]))
+          nb_nonzeros++;
+
+    temp = osl_relation_sparse_pmalloc(relation->precision, relation->nb_rows,
+                                       relation->nb_columns, nb_nonzeros);
+    for (i = 0; i < relation->nb_rows; i++) {
+      for (j = 0; j < relation->nb_columns; j++)
+        if (!osl_int_zero(relation->precision, relation->m[i][j]))
+          osl_relation_sparse_append(temp, j, relation->m[i][j]);
+      temp->sparse->row_start[i + 1] = temp->sparse->nb_nonzeros;
+    }
+
+    osl_relation_free_inside(relation);
+
+    // Replace the inside of relation.
+    relation->m = NULL;
+    relation->sparse = temp->sparse;
+
+    // Free the temp "shell".
+    OSL_free(temp);
+  }
+}
+
+/**
+ * osl_relation_to_dense function:
+ * this function converts the matrix of every part of a relation union that
+ * is stored in sparse form back to the dense form (m). The relation is
+ * updated directly.
+ * \param[in,out] relation The relation to convert.
+ */
+void osl_relation_to_dense(osl_relation_t* relation) {
+  for (; relation != NULL; relation = relation->next)
+    osl_relation_part_to_dense(relation);
+}
+
+/**
+ * osl_relation_get_value function:
+ * this function sets value to the element of a relation matrix at a given
+ * row and column, whatever the matrix layout (dense or sparse). It only
+ * affects the first union part. The value must have been initialized with
+ * the precision of the relation (e.g., with osl_int_init()).
+ * \param[in]  relation The relation to read.
+ * \param[in]  row      The row of the element.
+ * \param[in]  column   The column of the element.
+ * \param[out] value    The value of the element.
+ */
+void osl_relation_get_value(const osl_relation_t* relation, int row,
+                            int column, osl_int_t* value) {
+  int k;
+  osl_relation_sparse_p sparse = relation->sparse;
+
+  if ((row < 0) || (row >= relation->nb_rows) || (column < 0) ||
+      (column >= relation->nb_columns))
+    OSL_error("bad element position");
+
+  if (sparse == NULL) {
+    osl_int_assign(relation->precision, value, relation->m[row][column]);
+    return;
+  }
+
+  k = osl_relation_sparse_position(sparse, row, column);
+  if ((k < sparse->row_start[row + 1]) && (sparse->column[k] == column))
+    osl_int_assign(relation->precision, value, sparse->value[k]);
+  else
+    osl_int_set_si(relation->precision, value, 0);
+}
+
+/**
+ * osl_relation_set_value function:
+ * this function sets the element of a relation matrix at a given row and
+ * column to a given value, whatever the matrix layout (dense or sparse). It
+ * only affects the first union part. Setting an element of a sparse matrix
+ * costs up to the number of non-zero elements of the matrix.
+ * \param[in,out] relation The relation to modify.
+ * \param[in]     row      The row of the element.
+ * \param[in]     column   The column of the element.
+ * \param[in]     value    The new value of the element.
+ */
+void osl_relation_set_value(osl_relation_t* relation, int row, int column,
+                            const osl_int_t value) {
+  int i, k, found;
+  int precision = relation->precision;
+  osl_relation_sparse_p sparse = relation->sparse;
+
+  if ((row < 0) || (row >= relation->nb_rows) || (column < 0) ||
+      (column >= relation->nb_columns))
+    OSL_error("bad element position");
+
+  osl_relation_part_unshare(relation);
+  sparse = relation->sparse;
+  if (sparse == NULL) {
+    osl_int_assign(precision, &relation->m[row][column], value);
+    return;
+  }
+
+  k = osl_relation_sparse_position(sparse, row, column);
+  found = (k < sparse->row_start[row + 1]) && (sparse->column[k] == column);
+
+  if (found && !osl_int_zero(precision, value)) {
+    osl_int_assign(precision, &sparse->value[k], value);
+  } else if (found) {
+    // Zero elements are not stored: remove the element.
+    osl_int_clear(precision, &sparse->value[k]);
+    memmove(&sparse->column[k], &sparse->column[k + 1],
+            (size_t)(sparse->nb_nonzeros - k - 1) * sizeof(int));
+    memmove(&sparse->value[k], &sparse->value[k + 1],
+            (size_t)(sparse->nb_nonzeros - k - 1) * sizeof(osl_int_t));
+    sparse->nb_nonzeros--;
+    for (i = row + 1; i <= relation->nb_rows; i++)
+      sparse->row_start[i]--;
+  } else if (!osl_int_zero(precision, value)) {
+    // Insert the new element at its place in the row.
+    if (sparse->nb_nonzeros == sparse->size) {
+      sparse->size = OSL_max(2 * sparse->size, relation->nb_columns);
+      OSL_realloc(sparse->column, int*, (size_t)sparse->size * sizeof(int));
+      OSL_realloc(sparse->value, osl_int_t*,
+                  (size_t)sparse->size * sizeof(osl_int_t));
+    }
+    memmove(&sparse->column[k + 1], &sparse->column[k],
+            (size_t)(sparse->nb_nonzeros - k) * sizeof(int));
+    memmove(&sparse->value[k + 1], &sparse->value[k],
+            (size_t)(sparse->nb_nonzeros - k) * sizeof(osl_int_t));
+    sparse->column[k] = column;
+    osl_int_init_set(precision, &sparse->value[k], value);
+    sparse->nb_nonzeros++;
+    for (i = row + 1; i <= relation->nb_rows; i++)
+      sparse->row_start[i]++;
+  }
+}
+
+/**
+ * osl_relation_table_lookup internal function:
+ * this function returns the entry of an interning table storing the same
+ * matrix as a relation union part (same precision, sizes, layout and
+ * content), or NULL if there is no such entry.
+ * \param[in] table    The interning table.
+ * \param[in] relation The relation part to look for.
+ * \param[in] hash     The hash of the matrix of the relation part.
+ * \return The entry storing the same matrix as relation, or NULL.
+ */
+osl_relation_shared_t* osl_relation_table_lookup(
+    const osl_relation_table_t* table, const osl_relation_t* relation,
+    uint64_t hash) {
+  osl_relation_shared_p entry;
+  osl_relation_t view;
+
+  entry = table->bucket[hash & (table->nb_buckets - 1)];
+  for (; entry != NULL; entry = entry->next) {
+    if ((entry->hash != hash) || (entry->precision != relation->precision) ||
+        (entry->nb_rows != relation->nb_rows) ||
+        (entry->nb_columns != relation->nb_columns) ||
+        ((entry->sparse != NULL) != (relation->sparse != NULL)))
+      continue;
+
+    // Compare the matrices through a relation "view" of the entry.
+    view = *relation;
+    view.m = entry->m;
+    view.sparse = entry->sparse;
+    view.shared = entry;
+    if (osl_relation_storage_equal(&view, relation))
+      return entry;
+  }
+
+  return NULL;
+}
+
+/**
+ * osl_relation_table_insert internal function:
+ * this function inserts a shared matrix in an interning table, growing the
+ * table when it becomes too loaded.
+ * \param[in,out] table The interning table.
+ * \param[in,out] entry The shared matrix to insert (not interned yet).
+ */
+void osl_relation_table_insert(osl_relation_table_t* table,
+                               osl_relation_shared_t* entry) {
+  size_t i, index, nb_buckets;
+  osl_relation_shared_p* bucket;
+  osl_relation_shared_p current, next;
+
+  if (table->nb_entries >= table->nb_buckets) {
+    nb_buckets = 2 * table->nb_buckets;
+    OSL_malloc(bucket, osl_relation_shared_p*,
+               nb_buckets * sizeof(osl_relation_shared_p));
+    for (i = 0; i < nb_buckets; i++)
+      bucket[i] = NULL;
+    for (i = 0; i < table->nb_buckets; i++) {
+      for (current = table->bucket[i]; current != NULL; current = next) {
+        next = current->next;
+        index = current->hash & (nb_buckets - 1);
+        current->next = bucket[index];
+        bucket[index] = current;
+      }
+    }
+    OSL_free(table->bucket);
+    table->bucket = bucket;
+    table->nb_buckets = nb_buckets;
+  }
+
+  index = entry->hash & (table->nb_buckets - 1);
+  entry->next = table->bucket[index];
+  entry->table = table;
+  table->bucket[index] = entry;
+  table->nb_entries++;
+}
+
+/**
+ * osl_relation_table_remove internal function:
+ * this function removes a shared matrix from the interning table where it
+ * is interned.
+ * \param[in,out] table The interning table.
+ * \param[in]     entry The shared matrix to remove.
+ */
+void osl_relation_table_remove(osl_relation_table_t* table,
+                               const osl_relation_shared_t* entry) {
+  osl_relation_shared_p* link;
+
+  link = &table->bucket[entry->hash & (table->nb_buckets - 1)];
+  while (*link != NULL) {
+    if (*link == entry) {
+      *link = entry->next;
+      table->nb_entries--;
+      return;
+    }
+    link = &(*link)->next;
+  }
+}
+
+/**
+ * osl_relation_intern function:
+ * this function interns the matrices of every part of a relation union in
+ * an interning table: a part whose matrix is already in the table releases
+ * its own matrix and shares the interned one, otherwise its matrix is added
+ * to the table. Interned matrices are reference-counted and copied on write:
+ * copy-on-write clones share them (see osl_relation_clone_cow() and the
+ * osl_*_clone_cow() functions of statements and scops), hence cloning
+ * interned relations that way is cheap, while plain clones (see
+ * osl_relation_nclone()) still copy them. Parts with an empty matrix, parts
+ * allocated in an arena and parts already interned in another table are
+ * left as is.
+ * \param[in,out] table    The interning table.
+ * \param[in,out] relation The relation to intern.
+ */
+void osl_relation_intern(osl_relation_table_t* table,
+                         osl_relation_t* relation) {
+  uint64_t hash;
+  osl_relation_shared_p entry;
+
+  for (; relation != NULL; relation = relation->next) {
+    if ((relation->m == NULL) && (relation->sparse == NULL))
+      continue;
+    if ((relation->shared != NULL) && (relation->shared->table != NULL))
+      continue;
+    if (osl_arena_lookup((relation->m != NULL) ? (void*)relation->m
+                                               : (void*)relation->sparse))
+      continue;
+
+    if (relation->shared != NULL)
+      hash = relation->shared->hash;
+    else
+      hash = osl_relation_storage_hash(relation);
+
+    entry = osl_relation_table_lookup(table, relation, hash);
+    if (entry != NULL) {
+      // Use the interned matrix instead of our own copy.
+      osl_relation_free_inside(relation);
+      relation->m = entry->m;
+      relation->sparse = entry->sparse;
+      relation->shared = entry;
+      entry->refcount++;
+    } else {
+      if (relation->shared == NULL)
+        osl_relation_shared_make(relation);
+      osl_relation_table_insert(table, relation->shared);
+    }
+  }
+}
+
+/**
+ * osl_relation_share function:
+ * this function makes the matrix of every part of a relation union
+ * shareable without interning it: subsequent copy-on-write clones of the
+ * relation (see osl_relation_clone_cow()) share the matrices instead of
+ * copying them, plain clones still copy them. Parts with an empty matrix
+ * and parts allocated in an arena are left as is.
+ * \param[in,out] relation The relation whose matrices are made shareable.
+ */
+void osl_relation_share(osl_relation_t* relation) {
+  for (; relation != NULL; relation = relation->next) {
+    if ((relation->shared != NULL) ||
+        ((relation->m == NULL) && (relation->sparse == NULL)))
+      continue;
+    if (osl_arena_lookup((relation->m != NULL) ? (void*)relation->m
+                                               : (void*)relation->sparse))
+      continue;
+    osl_relation_shared_make(relation);
+  }
+}
+
+/**
+ * osl_relation_is_shared function:
+ * this function returns 1 if at least one part of a relation union shares
+ * its matrix (see osl_relation_intern()), 0 otherwise.
+ * \param[in] relation The relation to check.
+ * \return 1 if a part of the relation has a shared matrix, 0 otherwise.
+ */
+int osl_relation_is_shared(const osl_relation_t* relation) {
+  for (; relation != NULL; relation = relation->next)
+    if (relation->shared != NULL)
+      return 1;
+
+  return 0;
+}
+
+/**
+ * osl_relation_unshare function:
+ * this function makes sure that every part of a relation union owns its
+ * matrix, by duplicating the matrices shared with other relations, and
+ * resets the cached array identifiers (see osl_relation_cache_array_id()).
+ * Library functions modifying matrices do it by themselves, but code writing
+ * in m directly has to call this function first.
+ * \param[in,out] relation The relation to unshare.
+ */
+void osl_relation_unshare(osl_relation_t* relation) {
+  for (; relation != NULL; relation = relation->next)
+    osl_relation_part_unshare(relation);
+}
+
+/**
+ * osl_relation_row_compare internal function:
+ * this function compares two rows of a dense matrix according to the order
+ * of canonical relations: equalities come first, then rows are compared
+ * column by column, a row with a non-zero coefficient where the other has a
+ * zero coming first, and smaller coefficients coming first otherwise. The
+ * constants (last column) are simply compared, so that among inequalities
+ * with the same coefficients the tightest one comes first.
+ * \param[in] precision  The precision of the matrix elements.
+ * \param[in] nb_columns The number of columns of the rows.
+ * \param[in] r1         The first row.
+ * \param[in] r2         The second row.
+ * \return A negative value if r1 comes first, positive if r2 comes first,
+ *         0 if the rows are equal.
+ */
+int osl_relation_row_compare(int precision, int nb_columns,
+                             const osl_int_t* r1, const osl_int_t* r2) {
+  int j;
+
+  for (j = 0; j < nb_columns; j++) {
+    if (osl_int_eq(precision, r1[j], r2[j]))
+      continue;
+    if (j == 0)
+      return osl_int_zero(precision, r1[0]) ? -1 : 1;
+    if (j < nb_columns - 1) {
+      if (osl_int_zero(precision, r1[j]))
+        return 1;
+      if (osl_int_zero(precision, r2[j]))
+        return -1;
+    }
+    return osl_int_lt(precision, r1[j], r2[j]) ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+ * osl_relation_row_reduce internal function:
+ * this function divides a row of a dense matrix by the gcd of its
+ * coefficients (the equality/inequality column excepted) and, for an
+ * equality, makes its first non-zero coefficient negative (the OpenScop
+ * convention for output dimensions). It returns 1 if the row is trivially
+ * true (0 == 0 or c >= 0 with c a non-negative constant), 0 otherwise.
+ * \param[in]     precision  The precision of the matrix elements.
+ * \param[in]     nb_columns The number of columns of the row.
+ * \param[in,out] row        The row to reduce.
+ * \return 1 if the row is trivially true, 0 otherwise.
+ */
+int osl_relation_row_reduce(int precision, int nb_columns, osl_int_t* row) {
+  int j, first = -1, trivial = 0;
+  size_t size = (size_t)(nb_columns - 1);
+  osl_int_t gcd;
+
+  for (j = 1; (j < nb_columns - 1) && (first == -1); j++)
+    if (!osl_int_zero(precision, row[j]))
+      first = j;
+
+  osl_int_init(precision, &gcd);
+  osl_int_gcd_array(precision, &gcd, row + 1, size);
+  if (osl_int_zero(precision, gcd)) {
+    trivial = 1;
+  } else if ((first == -1) && !osl_int_zero(precision, row[0]) &&
+             !osl_int_neg(precision, row[nb_columns - 1])) {
+    trivial = 1;
+  } else {
+    if (!osl_int_one(precision, gcd))
+      osl_int_div_exact_array(precision, row + 1, size, gcd);
+    if (osl_int_zero(precision, row[0]) && (first != -1) &&
+        osl_int_pos(precision, row[first]))
+      osl_int_oppose_array(precision, row + 1, size);
+  }
+
+  osl_int_clear(precision, &gcd);
+  return trivial;
+}
+
+/**
+ * osl_relation_part_canonicalize internal function:
+ * this function puts a dense relation union part in canonical form (see
+ * osl_relation_canonicalize()). The matrix is left untouched, hence still
+ * possibly shared, when it is already canonical.
+ * \param[in,out] relation The dense relation part to canonicalize.
+ */
+void osl_relation_part_canonicalize(osl_relation_t* relation) {
+  int i, k, n = 0;
+  int precision = relation->precision;
+  int nb_columns = relation->nb_columns;
+  int* order;
+  osl_relation_p work, temp;
+
+  if (relation->nb_rows == 0)
+    return;
+
+  // Normalize a private copy and keep the indices of the useful rows.
+  work = osl_relation_storage_clone(relation, relation->nb_rows);
+  OSL_malloc(order, int*, (size_t)relation->nb_rows * sizeof(int));
+  for (i = 0; i < relation->nb_rows; i++)
+    if (!osl_relation_row_reduce(precision, nb_columns, work->m[i]))
+      order[n++] = i;
+
+  // Stable insertion sort of the rows.
+  for (i = 1; i < n; i++) {
+    int row = order[i], j = i;
+
+    while ((j > 0) && (osl_relation_row_compare(precision, nb_columns,
+                                                work->m[order[j - 1]],
+                                                work->m[row]) > 0)) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = row;
+  }
+
+  // Drop duplicates and inequalities dominated by a tighter parallel one.
+  for (i = 1, k = 1; i < n; i++) {
+    const osl_int_t* last = work->m[order[k - 1]];
+    const osl_int_t* row = work->m[order[i]];
+    int parallel =
+        !osl_relation_row_compare(precision, nb_columns - 1, last, row);
+
+    if (parallel &&
+        (!osl_int_zero(precision, row[0]) ||
+         osl_int_eq(precision, last[nb_columns - 1], row[nb_columns - 1])))
+      continue;
+    order[k++] = order[i];
+  }
+  n = (n > 0) ? k : 0;
+
+  temp = osl_relation_pmalloc(precision, n, nb_columns);
+  for (i = 0; i < n; i++)
+    for (k = 0; k < nb_columns; k++)
+      osl_int_assign(precision, &temp->m[i][k], work->m[order[i]][k]);
+  osl_relation_free(work);
+  OSL_free(order);
+
+  if ((relation->nb_rows == n) && osl_relation_storage_equal(relation, temp)) {
+    osl_relation_free(temp);
+    return;
+  }
+
+  osl_relation_free_inside(relation);
+
+  // Replace the inside of relation and free the temp "shell".
+  relation->nb_rows = n;
+  relation->m = temp->m;
+  OSL_free(temp);
+}
+
+/**
+ * osl_relation_canonicalize function:
+ * this function puts every part of a relation union in canonical form,
+ * such that relations with the same constraints up to the row order and to
+ * positive row factors become equal (hence have the same hash): each row is
+ * divided by the gcd of its coefficients, the first non-zero coefficient of
+ * each equality is made negative, trivially true and duplicate rows are
+ * removed, as are inequalities implied by a tighter one with the same
+ * coefficients, and rows are sorted (equalities first, then rows with a
+ * non-zero coefficient in the leftmost columns). The layout of each part
+ * (dense or sparse) is preserved.
+ * \param[in,out] relation The relation to canonicalize.
+ */
+void osl_relation_canonicalize(osl_relation_t* relation) {
+  osl_relation_p next;
+
+  for (; relation != NULL; relation = relation->next) {
+    if (relation->sparse == NULL) {
+      osl_relation_part_canonicalize(relation);
+      continue;
+    }
+
+    // Work on this part only to keep the layout of the other ones.
+    next = relation->next;
+    relation->next = NULL;
+    osl_relation_part_to_dense(relation);
+    osl_relation_part_canonicalize(relation);
+    osl_relation_to_sparse(relation);
+    relation->next = next;
+  }
+}
@@ -0,0 +1,442 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                             relation_array.c                             **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/arena.h>
+#include <osl/macros.h>
+#include <osl/relation.h>
+#include <osl/relation_array.h>
+#include <osl/util.h>
+
+static void osl_relation_array_grow(osl_relation_array_t*, int);
+static void osl_relation_array_loop(void*, int);
+
+/**
+ * The osl_relation_array_job_t structure gathers the arguments of
+ * osl_relation_array_parallel_for() for each iteration.
+ */
+struct osl_relation_array_job {
+  osl_relation_array_p array; /**< Relation array to iterate over */
+  osl_relation_array_f body;  /**< Function to call for each part */
+  void* usr;                  /**< User data given to each call */
+};
+typedef struct osl_relation_array_job osl_relation_array_job_t;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_relation_array_idump function:
+ * this function displays an osl_relation_array_t structure (*array) into a
+ * file (file, possibly stdout) in a way that trends to be understandable.
+ * It includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] array The relation array whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_relation_array_idump(FILE* const file,
+                              const osl_relation_array_t* const array,
+                              int level) {
+  int j;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (array != NULL) {
+    fprintf(file, "+-- osl_relation_array_t: %d part(s)\n", array->nb_parts);
+
+    // The union itself.
+    osl_relation_idump(file, osl_relation_array_head(array), level + 1);
+  } else {
+    fprintf(file, "+-- NULL relation array\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_relation_array_dump function:
+ * this function prints the content of an osl_relation_array_t structure
+ * (*array) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] array The relation array whose information has to be printed.
+ */
+void osl_relation_array_dump(FILE* const file,
+                             const osl_relation_array_t* const array) {
+  osl_relation_array_idump(file, array, 0);
+}
+
+/******************************************************************************
+ *                    Memory allocation/deallocation function                 *
+ ******************************************************************************/
+
+/**
+ * osl_relation_array_malloc function:
+ * this function allocates the memory space for an empty osl_relation_array_t
+ * structure (with no union part) and returns a pointer to it.
+ * \return A pointer to an empty relation array.
+ */
+osl_relation_array_t* osl_relation_array_malloc(void) {
+  osl_relation_array_p array;
+
+  OSL_malloc(array, osl_relation_array_p, sizeof(osl_relation_array_t));
+  array->nb_parts = 0;
+  array->size = 0;
+  array->part = NULL;
+
+  return array;
+}
+
+/**
+ * osl_relation_array_free function:
+ * this function frees the allocated memory for an osl_relation_array_t
+ * structure. The union parts are not freed (see osl_relation_free()).
+ * \param[in,out] array The pointer to the relation array to free.
+ */
+void osl_relation_array_free(osl_relation_array_t* array) {
+  if (array == NULL)
+    return;
+
+  OSL_free(array->part);
+  OSL_free(array);
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_relation_array_grow internal function:
+ * this function makes sure a relation array has room for at least size
+ * union parts, doubling its capacity as necessary.
+ * \param[in,out] array The relation array.
+ * \param[in]     size  The number of parts to make room for.
+ */
+void osl_relation_array_grow(osl_relation_array_t* array, int size) {
+  int new_size;
+
+  if (size <= array->size)
+    return;
+
+  new_size = (array->size > 0) ? array->size : 4;
+  while (new_size < size)
+    new_size *= 2;
+  OSL_realloc(array->part, osl_relation_p*,
+              (size_t)new_size * sizeof(osl_relation_p));
+  array->size = new_size;
+}
+
+/**
+ * osl_relation_array_is_current function:
+ * this function returns 1 if a relation union owns an up-to-date relation
+ * array, 0 otherwise, in constant time: the array must start with the
+ * union and match its links at both ends. Other edits of the next fields
+ * are not detected (see osl_relation_array_sync()).
+ * \param[in] relation The relation union.
+ * \return 1 if the relation array of the union is up to date, 0 otherwise.
+ */
+int osl_relation_array_is_current(const osl_relation_t* relation) {
+  const osl_relation_array_t* array;
+
+  if ((relation == NULL) || (relation->parts == NULL))
+    return 0;
+
+  array = relation->parts;
+  if ((array->nb_parts == 0) || (array->part[0] != relation))
+    return 0;
+  if (array->nb_parts == 1)
+    return (relation->next == NULL);
+
+  return (relation->next == array->part[1]) &&
+         (array->part[array->nb_parts - 2]->next ==
+          array->part[array->nb_parts - 1]) &&
+         (array->part[array->nb_parts - 1]->next == NULL);
+}
+
+/**
+ * osl_relation_array_sync function:
+ * this function (re)builds the relation array of a relation union from the
+ * next fields of its parts and attaches it to the union. It has to be
+ * called after editing the next fields directly.
+ * \param[in,out] relation The relation union.
+ * \return The relation array of the union (NULL if the union is NULL).
+ */
+osl_relation_array_t* osl_relation_array_sync(osl_relation_t* relation) {
+  osl_relation_p part;
+  osl_relation_array_p array;
+
+  if (relation == NULL)
+    return NULL;
+
+  array = relation->parts;
+  if (array == NULL)
+    array = osl_relation_array_malloc();
+  array->nb_parts = 0;
+  for (part = relation; part != NULL; part = part->next) {
+    osl_relation_array_grow(array, array->nb_parts + 1);
+    array->part[array->nb_parts++] = part;
+  }
+
+  relation->parts = array;
+  return array;
+}
+
+/**
+ * osl_relation_array_get function:
+ * this function returns the relation array of a relation union, which is
+ * built and attached to the union if it does not exist or is not up to
+ * date. The union keeps the ownership of the array.
+ * \param[in,out] relation The relation union.
+ * \return The relation array of the union (NULL if the union is NULL).
+ */
+osl_relation_array_t* osl_relation_array_get(osl_relation_t* relation) {
+  if (osl_relation_array_is_current(relation))
+    return relation->parts;
+
+  return osl_relation_array_sync(relation);
+}
+
+/**
+ * osl_relation_array_head function:
+ * this function returns the relation union stored in a relation array,
+ * i.e., its first part, linked to the others through its next field.
+ * \param[in] array The relation array.
+ * \return The relation union stored by the array (NULL if none).
+ */
+osl_relation_t* osl_relation_array_head(const osl_relation_array_t* array) {
+  if ((array == NULL) || (array->nb_parts == 0))
+    return NULL;
+
+  return array->part[0];
+}
+
+/**
+ * osl_relation_array_nb_parts function:
+ * this function returns the number of union parts in a relation array, in
+ * constant time.
+ * \param[in] array The relation array.
+ * \return The number of union parts of the array.
+ */
+int osl_relation_array_nb_parts(const osl_relation_array_t* array) {
+  return (array == NULL) ? 0 : array->nb_parts;
+}
+
+/**
+ * osl_relation_array_part function:
+ * this function returns the union part of a given rank in a relation
+ * array, in constant time. The part is still linked to the next ones.
+ * \param[in] array The relation array.
+ * \param[in] k     The rank of the part (from 0).
+ * \return The kth union part of the array.
+ */
+osl_relation_t* osl_relation_array_part(const osl_relation_array_t* array,
+                                        int k) {
+  if ((array == NULL) || (k < 0) || (k >= array->nb_parts))
+    OSL_error("union part rank out of range");
+
+  return array->part[k];
+}
+
+/**
+ * osl_relation_array_add function:
+ * this function links a relation union at the end of the union of a
+ * relation array and records its parts. The relation array of the appended
+ * union, if any, is freed. If the array is empty, the appended union
+ * becomes the owner of the array.
+ * \param[in,out] array    The relation array.
+ * \param[in]     relation The relation union to append (may be NULL).
+ */
+void osl_relation_array_add(osl_relation_array_t* array,
+                            osl_relation_t* relation) {
+  osl_relation_p part;
+  osl_relation_array_p parts;
+
+  if (relation == NULL)
+    return;
+
+  if (array->nb_parts > 0)
+    array->part[array->nb_parts - 1]->next = relation;
+
+  if (osl_relation_array_is_current(relation)) {
+    parts = relation->parts;
+    osl_relation_array_grow(array, array->nb_parts + parts->nb_parts);
+    memcpy(array->part + array->nb_parts, parts->part,
+           (size_t)parts->nb_parts * sizeof(osl_relation_p));
+    array->nb_parts += parts->nb_parts;
+  } else {
+    for (part = relation; part != NULL; part = part->next) {
+      osl_relation_array_grow(array, array->nb_parts + 1);
+      array->part[array->nb_parts++] = part;
+    }
+  }
+
+  if (relation->parts != array) {
+    osl_relation_array_free(relation->parts);
+    relation->parts = NULL;
+  }
+  if (array->part[0] == relation)
+    relation->parts = array;
+}
+
+/**
+ * osl_relation_array_remove function:
+ * this function unlinks the union part of a given rank from the union of a
+ * relation array and returns it, the next parts are shifted. When the first
+ * part is removed, the array moves to the new first part; it is freed with
+ * the last part.
+ * \param[in,out] array The relation array.
+ * \param[in]     k     The rank of the part to remove (from 0).
+ * \return The removed part, which is not linked to any other part.
+ */
+osl_relation_t* osl_relation_array_remove(osl_relation_array_t* array,
+                                          int k) {
+  osl_relation_p part = osl_relation_array_part(array, k);
+  osl_relation_p head;
+
+  if (k > 0)
+    array->part[k - 1]->next = part->next;
+  memmove(array->part + k, array->part + k + 1,
+          (size_t)(array->nb_parts - k - 1) * sizeof(osl_relation_p));
+  array->nb_parts--;
+  part->next = NULL;
+
+  if (k == 0) {
+    part->parts = NULL;
+    if (array->nb_parts == 0) {
+      osl_relation_array_free(array);
+    } else {
+      head = array->part[0];
+      osl_relation_array_free(head->parts);
+      head->parts = array;
+    }
+  }
+
+  return part;
+}
+
+/**
+ * osl_relation_array_loop internal function:
+ * this function calls the user function of a relation array job for one
+ * union part (see osl_util_parallel_for()).
+ * \param[in] data The relation array job.
+ * \param[in] k    The rank of the part.
+ */
+void osl_relation_array_loop(void* data, int k) {
+  osl_relation_array_job_t* job = data;
+
+  job->body(job->array->part[k], k, job->usr);
+}
+
+/**
+ * osl_relation_array_parallel_for function:
+ * this function calls body(part, k, usr) for every union part of a
+ * relation array, with k the rank of the part. The parts are unlinked
+ * during the calls, so that the body sees its part as a single relation
+ * and may modify it in place with any osl_relation_* function that does
+ * not free it. The calls are distributed over threads (see
+ * osl_util_parallel_for()), except while an arena is current since arenas
+ * are bound to a thread, hence they must be independent.
+ * \param[in,out] array The relation array.
+ * \param[in]     body  The function to call for each part.
+ * \param[in]     usr   User data given to each call.
+ */
+void osl_relation_array_parallel_for(osl_relation_array_t* array,
+                                     osl_relation_array_f body, void* usr) {
+  int k, owned;
+  osl_relation_p head;
+  osl_relation_array_job_t job;
+
+  if ((array == NULL) || (array->nb_parts == 0))
+    return;
+
+  // The first part has to look like a single relation too.
+  head = array->part[0];
+  owned = (head->parts == array);
+  if (owned)
+    head->parts = NULL;
+  for (k = 0; k < array->nb_parts; k++)
+    array->part[k]->next = NULL;
+
+  if (osl_arena_get_current() != NULL) {
+    for (k = 0; k < array->nb_parts; k++)
+      body(array->part[k], k, usr);
+  } else {
+    job.array = array;
+    job.body = body;
+    job.usr = usr;
+    osl_util_parallel_for(array->nb_parts, osl_relation_array_loop, &job);
+  }
+
+  for (k = 0; k < array->nb_parts - 1; k++)
+    array->part[k]->next = array->part[k + 1];
+  if (owned) {
+    osl_relation_array_free(head->parts);
+    head->parts = array;
+  }
+}
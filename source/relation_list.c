@@ -401,7 +401,7 @@ void osl_relation_list_free(osl_relation_list_t* list) {
     if (list->elt != NULL)
       osl_relation_free(list->elt);
     tmp = list->next;
-    free(list);
+    OSL_free(list);
     list = tmp;
   }
 }
@@ -458,6 +458,38 @@ osl_relation_list_t* osl_relation_list_clone(const osl_relation_list_t* list) {
   return clone;
 }
 
+/**
+ * osl_relation_list_clone_cow function:
+ * This functions builds and returns a copy-on-write clone of a relation
+ * list: the list nodes and relation headers are copied while the matrices
+ * are shared until they are modified (see osl_relation_clone_cow()).
+ * \param list  The pointer to the relation list we want to copy (its
+ *              matrices get shared).
+ * \return A pointer to the copy-on-write clone of the relation list.
+ */
+osl_relation_list_t* osl_relation_list_clone_cow(osl_relation_list_t* list) {
+  osl_relation_list_p clone = NULL, node, previous = NULL;
+  int first = 1;
+
+  while (list != NULL) {
+    node = osl_relation_list_malloc();
+    node->elt = osl_relation_clone_cow(list->elt);
+
+    if (first) {
+      first = 0;
+      clone = node;
+      previous = node;
+    } else {
+      previous->next = node;
+      previous = previous->next;
+    }
+
+    list = list->next;
+  }
+
+  return clone;
+}
+
 /**
  * osl_relation_list_concat function:
  * this function builds a new relation list as the concatenation of the
@@ -608,6 +640,88 @@ int osl_relation_list_equal(const osl_relation_list_t* l1,
   return 1;
 }
 
+/**
+ * osl_relation_list_hash function:
+ * this function returns a 64-bit hash of the content of a relation list.
+ * The hash depends on the order of the relations in the list.
+ * \param[in] list The relation list to hash (possibly NULL).
+ * \return The hash of the relation list.
+ */
+uint64_t osl_relation_list_hash(const osl_relation_list_t* list) {
+  uint64_t hash = 0;
+  int nb_elts = 0;
+
+  for (; list != NULL; list = list->next) {
+    hash = osl_util_hash_combine(hash, osl_relation_hash(list->elt));
+    nb_elts++;
+  }
+
+  return osl_util_hash_combine(hash, (uint64_t)nb_elts);
+}
+
+/**
+ * osl_relation_list_share function:
+ * this function makes the matrices of every relation of a relation list
+ * shareable by its clones (see osl_relation_share()).
+ * \param[in,out] list The relation list whose matrices are made shareable.
+ */
+void osl_relation_list_share(osl_relation_list_t* list) {
+  for (; list != NULL; list = list->next)
+    osl_relation_share(list->elt);
+}
+
+/**
+ * osl_relation_list_intern function:
+ * this function interns the matrices of every relation of a relation list
+ * in an interning table (see osl_relation_intern()).
+ * \param[in,out] table The interning table.
+ * \param[in,out] list  The relation list to intern.
+ */
+void osl_relation_list_intern(osl_relation_table_t* table,
+                              osl_relation_list_t* list) {
+  for (; list != NULL; list = list->next)
+    osl_relation_intern(table, list->elt);
+}
+
+/**
+ * osl_relation_list_canonicalize function:
+ * this function puts every relation of a relation list in canonical form
+ * (see osl_relation_canonicalize()).
+ * \param[in,out] list The relation list to canonicalize.
+ */
+void osl_relation_list_canonicalize(osl_relation_list_t* list) {
+  for (; list != NULL; list = list->next)
+    osl_relation_canonicalize(list->elt);
+}
+
+/**
+ * osl_relation_list_specialize_parameters function:
+ * this function replaces some parameters of every relation of a relation
+ * list with known values (see osl_relation_specialize_parameters()).
+ * \param[in,out] list   The relation list to specialize.
+ * \param[in]     values The values of the parameters (one per parameter).
+ * \param[in]     mask   For each parameter, non-zero to specialize it (NULL
+ *                       to specialize every parameter).
+ */
+void osl_relation_list_specialize_parameters(osl_relation_list_t* list,
+                                             const long* values,
+                                             const int* mask) {
+  for (; list != NULL; list = list->next)
+    osl_relation_specialize_parameters(list->elt, values, mask);
+}
+
+/**
+ * osl_relation_list_eliminate_equalities function:
+ * this function removes the local dimensions defined by unit equalities
+ * from every relation of a relation list (see
+ * osl_relation_eliminate_equalities()).
+ * \param[in,out] list The relation list to simplify.
+ */
+void osl_relation_list_eliminate_equalities(osl_relation_list_t* list) {
+  for (; list != NULL; list = list->next)
+    osl_relation_eliminate_equalities(list->elt);
+}
+
 /**
  * osl_relation_integrity_check function:
  * This function checks that a list of relation is "well formed" according to
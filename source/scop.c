@@ -63,7 +63,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <osl/arena.h>
 #include <osl/extensions/arrays.h>
+#include <osl/extensions/dependence.h>
 #include <osl/extensions/textual.h>
 #include <osl/generic.h>
 #include <osl/interface.h>
@@ -74,6 +76,35 @@
 #include <osl/strings.h>
 #include <osl/util.h>
 
+/**
+ * The osl_scop_job_t structure gathers the arguments of the operations on
+ * scops that process statements in parallel (see osl_scop_parallel()).
+ */
+struct osl_scop_job {
+  const osl_statement_t** source; /**< Statements to read */
+  const osl_statement_t** other;  /**< Statements to compare with */
+  osl_statement_p* target;        /**< Statements to build or modify */
+  int* result;                    /**< Result for each statement */
+  int value;                      /**< Parameter of the operation */
+};
+typedef struct osl_scop_job osl_scop_job_t;
+
+static int osl_scop_parallel(const osl_statement_t*, int);
+static const osl_statement_t** osl_scop_statement_array(
+    const osl_statement_t*, int);
+static osl_statement_t* osl_scop_statement_link(osl_statement_t**, int);
+static void osl_scop_clone_loop(void*, int);
+static void osl_scop_equal_loop(void*, int);
+static void osl_scop_check_loop(void*, int);
+static void osl_scop_remove_unions_loop(void*, int);
+static void osl_scop_normalize_loop(void*, int);
+static void osl_scop_precision_loop(void*, int);
+static osl_statement_t* osl_scop_statement_clone(const osl_statement_t*);
+static int osl_scop_statement_equal(const osl_statement_t*,
+                                    const osl_statement_t*);
+static int osl_scop_statement_check(const osl_statement_t*, int);
+static void osl_scop_language_check(const char*);
+
 /******************************************************************************
  *                         Structure display functions                        *
  ******************************************************************************/
@@ -228,14 +259,16 @@ void osl_scop_print(FILE* const file, const osl_scop_t* scop) {
 
   while (scop != NULL) {
     // If possible, replace parameter names with scop parameter names.
-    if (osl_generic_has_URI(scop->parameters, OSL_URI_STRINGS)) {
+    if (osl_generic_has_URI(scop->parameters,
+                            osl_interface_atom(OSL_URI_STRINGS))) {
       parameters_backedup = 1;
       parameters_backup = names->parameters;
       names->parameters = scop->parameters->data;
     }
 
     // If possible, replace array names with arrays extension names.
-    arrays = osl_generic_lookup(scop->extension, OSL_URI_ARRAYS);
+    arrays = osl_generic_lookup(scop->extension,
+                                osl_interface_atom(OSL_URI_ARRAYS));
     if (arrays != NULL) {
       arrays_backedup = 1;
       arrays_backup = names->arrays;
@@ -254,7 +287,9 @@ void osl_scop_print(FILE* const file, const osl_scop_t* scop) {
     fprintf(file, "\n");
 
     osl_util_print_provided(
-        file, osl_generic_has_URI(scop->parameters, OSL_URI_STRINGS),
+        file,
+        osl_generic_has_URI(scop->parameters,
+                            osl_interface_atom(OSL_URI_STRINGS)),
         "Parameters are");
     osl_generic_print(file, scop->parameters);
 
@@ -325,14 +360,16 @@ void osl_scop_print_scoplib(FILE* const file, const osl_scop_t* scop) {
 
   while (scop != NULL) {
     // If possible, replace parameter names with scop parameter names.
-    if (osl_generic_has_URI(scop->parameters, OSL_URI_STRINGS)) {
+    if (osl_generic_has_URI(scop->parameters,
+                            osl_interface_atom(OSL_URI_STRINGS))) {
       parameters_backedup = 1;
       parameters_backup = names->parameters;
       names->parameters = scop->parameters->data;
     }
 
     // If possible, replace array names with arrays extension names.
-    arrays = osl_generic_lookup(scop->extension, OSL_URI_ARRAYS);
+    arrays = osl_generic_lookup(scop->extension,
+                                osl_interface_atom(OSL_URI_ARRAYS));
     if (arrays != NULL) {
       arrays_backedup = 1;
       arrays_backup = names->arrays;
@@ -352,7 +389,9 @@ void osl_scop_print_scoplib(FILE* const file, const osl_scop_t* scop) {
     fprintf(file, "\n");
 
     osl_util_print_provided(
-        file, osl_generic_has_URI(scop->parameters, OSL_URI_STRINGS),
+        file,
+        osl_generic_has_URI(scop->parameters,
+                            osl_interface_atom(OSL_URI_STRINGS)),
         "Parameters are");
 
     if (scop->parameters) {
@@ -396,28 +435,46 @@ void osl_scop_print_scoplib(FILE* const file, const osl_scop_t* scop) {
  ******************************************************************************/
 
 /**
- * osl_scop_pread function ("precision read"):
+ * osl_scop_pread_check function ("precision read with check mode"):
  * this function reads a list of scop structures from a file (possibly stdin)
  * complying to the OpenScop textual format and returns a pointer to this
  * scop list. If some relation properties (number of input/output/local
  * dimensions and number of parameters) are undefined, it will define them
- * according to the available information.
+ * according to the available information. The integrity of what has been
+ * read is checked according to the check mode:
+ * - OSL_CHECK_FULL: osl_scop_integrity_check() is run on the whole list once
+ *   it has been read (statements are checked in parallel when several
+ *   threads are enabled, see osl_util_set_nb_threads()),
+ * - OSL_CHECK_INLINE: the context and each statement are checked right after
+ *   they have been read, while their relations are still in cache,
+ * - OSL_CHECK_NONE: no check is done, for trusted inputs only.
+ * In all checking modes, a warning is issued if the check fails. The mode
+ * only applies to this call, hence several threads may read scops with
+ * different modes.
  * \param[in] file      The file where the scop has to be read.
  * \param[in] registry  The list of known interfaces (others are ignored).
  * \param[in] precision The precision of the relation elements.
+ * \param[in] check     The check mode (OSL_CHECK_NONE, _FULL or _INLINE).
  * \return A pointer to the scop structure that has been read.
  */
-osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
-                           int precision) {
+osl_scop_t* osl_scop_pread_check(FILE* const file,
+                                 osl_interface_t* const registry,
+                                 int precision, int check) {
   osl_scop_p list = NULL, current = NULL, scop;
   osl_statement_p stmt = NULL;
   osl_statement_p prev = NULL;
   osl_strings_p language;
   int nb_statements;
+  int nb_parameters = OSL_UNDEFINED;
+  int valid = 1;
   char* tmp;
   int first = 1;
   int i;
 
+  if ((check != OSL_CHECK_NONE) && (check != OSL_CHECK_FULL) &&
+      (check != OSL_CHECK_INLINE))
+    OSL_error("unknown integrity check mode");
+
   if (file == NULL)
     return NULL;
 
@@ -430,7 +487,7 @@ osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
       OSL_debug("no more scop in the file");
       break;
     } else {
-      free(tmp);
+      OSL_free(tmp);
     }
 
     scop = osl_scop_malloc();
@@ -455,6 +512,15 @@ osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
 
     // Read the context domain.
     scop->context = osl_relation_pread(file, precision);
+    if (check == OSL_CHECK_INLINE) {
+      osl_scop_language_check(scop->language);
+      if (!osl_relation_integrity_check(scop->context, OSL_TYPE_CONTEXT,
+                                        OSL_UNDEFINED, OSL_UNDEFINED,
+                                        OSL_UNDEFINED))
+        valid = 0;
+      nb_parameters = (scop->context != NULL) ? scop->context->nb_parameters
+                                              : OSL_UNDEFINED;
+    }
 
     // Read the parameters.
     if (osl_util_read_int(file, NULL) > 0)
@@ -470,6 +536,9 @@ osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
     for (i = 0; i < nb_statements; i++) {
       // Read each statement.
       stmt = osl_statement_pread(file, scop->registry, precision);
+      if ((check == OSL_CHECK_INLINE) && valid &&
+          !osl_statement_integrity_check(stmt, nb_parameters))
+        valid = 0;
       if (scop->statement == NULL)
         scop->statement = stmt;
       else
@@ -494,26 +563,59 @@ osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
     current = scop;
   }
 
-  if (!osl_scop_integrity_check(list))
+  if ((check == OSL_CHECK_FULL) && !osl_scop_integrity_check(list))
+    valid = 0;
+
+  if (!valid)
     OSL_warning("scop integrity check failed");
 
   return list;
 }
 
+/**
+ * osl_scop_pread function ("precision read"):
+ * this function is equivalent to osl_scop_pread_check() with the
+ * OSL_CHECK_FULL check mode.
+ * \param[in] file      The file where the scop has to be read.
+ * \param[in] registry  The list of known interfaces (others are ignored).
+ * \param[in] precision The precision of the relation elements.
+ * \return A pointer to the scop structure that has been read.
+ */
+osl_scop_t* osl_scop_pread(FILE* const file, osl_interface_t* const registry,
+                           int precision) {
+  return osl_scop_pread_check(file, registry, precision, OSL_CHECK_FULL);
+}
+
 /**
  * osl_scop_read function:
  * this function is equivalent to osl_scop_pread() except that
  * (1) the precision corresponds to the precision environment variable or
  *     to the highest available precision if it is not defined, and
- * (2) the list of known interface is set to the default one.
+ * (2) the list of known interface is the frozen (default) registry.
  * \see{osl_scop_pread}
  */
 osl_scop_t* osl_scop_read(FILE* foo) {
   int precision = osl_util_get_precision();
-  osl_interface_p registry = osl_interface_get_default_registry();
-  osl_scop_p scop = osl_scop_pread(foo, registry, precision);
+  osl_interface_p registry = osl_interface_get_frozen_registry();
+
+  return osl_scop_pread(foo, registry, precision);
+}
+
+/**
+ * osl_scop_read_arena function:
+ * this function is equivalent to osl_scop_read() except that the whole
+ * scop list is allocated in the arena provided as parameter, so that it can
+ * be released at once with osl_arena_free() (see osl_arena_t for the rules
+ * about mixing arena and heap objects).
+ * \param[in]     file  The file where the scop has to be read.
+ * \param[in,out] arena The arena where to allocate the scop.
+ * \return A pointer to the scop structure that has been read.
+ */
+osl_scop_t* osl_scop_read_arena(FILE* file, osl_arena_t* arena) {
+  osl_arena_p previous = osl_arena_set_current(arena);
+  osl_scop_p scop = osl_scop_read(file);
 
-  osl_interface_free(registry);
+  osl_arena_set_current(previous);
   return scop;
 }
 
@@ -555,7 +657,7 @@ void osl_scop_free(osl_scop_p scop) {
 
   while (scop != NULL) {
     if (scop->language != NULL)
-      free(scop->language);
+      OSL_free(scop->language);
     osl_generic_free(scop->parameters);
     osl_relation_free(scop->context);
     osl_statement_free(scop->statement);
@@ -563,7 +665,7 @@ void osl_scop_free(osl_scop_p scop) {
     osl_generic_free(scop->extension);
 
     tmp = scop->next;
-    free(scop);
+    OSL_free(scop);
     scop = tmp;
   }
 }
@@ -622,7 +724,7 @@ osl_scop_t* osl_scop_clone(const osl_scop_t* scop) {
       OSL_strdup(node->language, scop->language);
     node->context = osl_relation_clone(scop->context);
     node->parameters = osl_generic_clone(scop->parameters);
-    node->statement = osl_statement_clone(scop->statement);
+    node->statement = osl_scop_statement_clone(scop->statement);
     node->registry = osl_interface_clone(scop->registry);
     node->extension = osl_generic_clone(scop->extension);
 
@@ -641,6 +743,65 @@ osl_scop_t* osl_scop_clone(const osl_scop_t* scop) {
   return clone;
 }
 
+/**
+ * osl_scop_clone_cow function:
+ * This functions builds and returns a copy-on-write clone of a scop list:
+ * the context and statement matrices are shared with the original scop
+ * until they are modified (by any library function modifying a relation,
+ * see osl_relation_unshare()), while the other parts (headers, bodies,
+ * extensions) are copied. It is meant for speculative transformations,
+ * where most of the clones are discarded. The clone is used and released
+ * as a "hard copy" (see osl_relation_clone_cow() for the only restriction).
+ * \param[in,out] scop The scop list to clone (its matrices get shared).
+ * \return A pointer to the copy-on-write clone of the scop list.
+ */
+osl_scop_t* osl_scop_clone_cow(osl_scop_t* scop) {
+  osl_scop_p clone = NULL, node, previous = NULL;
+  int first = 1;
+
+  while (scop != NULL) {
+    node = osl_scop_malloc();
+    node->version = scop->version;
+    if (scop->language != NULL)
+      OSL_strdup(node->language, scop->language);
+    node->context = osl_relation_clone_cow(scop->context);
+    node->parameters = osl_generic_clone(scop->parameters);
+    node->statement = osl_statement_clone_cow(scop->statement);
+    node->registry = osl_interface_clone(scop->registry);
+    node->extension = osl_generic_clone(scop->extension);
+
+    if (first) {
+      first = 0;
+      clone = node;
+      previous = node;
+    } else {
+      previous->next = node;
+      previous = previous->next;
+    }
+
+    scop = scop->next;
+  }
+
+  return clone;
+}
+
+/**
+ * osl_scop_clone_arena function:
+ * this function is equivalent to osl_scop_clone() except that the clone is
+ * allocated in the arena provided as parameter, so that it can be released
+ * at once with osl_arena_free().
+ * \param[in]     scop  The pointer to the scop we want to clone.
+ * \param[in,out] arena The arena where to allocate the clone.
+ * \return A pointer to the full clone of the scop provided as parameter.
+ */
+osl_scop_t* osl_scop_clone_arena(const osl_scop_t* scop, osl_arena_t* arena) {
+  osl_arena_p previous = osl_arena_set_current(arena);
+  osl_scop_p clone = osl_scop_clone(scop);
+
+  osl_arena_set_current(previous);
+  return clone;
+}
+
 /**
  * osl_scop_remove_unions function:
  * Replace each statement having unions of relations by a list of statements,
@@ -649,14 +810,28 @@ osl_scop_t* osl_scop_clone(const osl_scop_t* scop) {
  * \returns  An identical SCoP without unions of relations.
  */
 osl_scop_t* osl_scop_remove_unions(const osl_scop_t* scop) {
+  int nb_statements;
   osl_statement_p statement, new_statement, scop_statement_ptr;
   osl_scop_p new_scop, scop_ptr, result = NULL;
+  osl_scop_job_t job;
 
   for (; scop != NULL; scop = scop->next) {
     statement = scop->statement;
     scop_statement_ptr = NULL;
     new_scop = osl_scop_malloc();
 
+    // Split the statements independently, then link them in order.
+    if ((nb_statements = osl_scop_parallel(statement, 1)) > 0) {
+      job.source = osl_scop_statement_array(statement, nb_statements);
+      OSL_malloc(job.target, osl_statement_p*,
+                 (size_t)nb_statements * sizeof(osl_statement_p));
+      osl_util_parallel_for(nb_statements, osl_scop_remove_unions_loop, &job);
+      new_scop->statement = osl_scop_statement_link(job.target, nb_statements);
+      OSL_free(job.source);
+      OSL_free(job.target);
+      statement = NULL;
+    }
+
     for (; statement != NULL; statement = statement->next) {
       new_statement = osl_statement_remove_unions(statement);
       if (!scop_statement_ptr) {
@@ -664,16 +839,16 @@ osl_scop_t* osl_scop_remove_unions(const osl_scop_t* scop) {
         new_scop->statement = scop_statement_ptr;
       } else {
         scop_statement_ptr->next = new_statement;
-        scop_statement_ptr = scop_statement_ptr->next;
       }
+      // A statement with unions is split into several ones.
+      while (scop_statement_ptr->next != NULL)
+        scop_statement_ptr = scop_statement_ptr->next;
     }
-    while (scop_statement_ptr && scop_statement_ptr->next != NULL)
-      scop_statement_ptr = scop_statement_ptr->next;
 
     new_scop->context = osl_relation_clone(scop->context);
     new_scop->extension = osl_generic_clone(scop->extension);
     if (scop->language != NULL) {
-      new_scop->language = (char*)malloc(strlen(scop->language) + 1);
+      new_scop->language = (char*)osl_util_malloc(strlen(scop->language) + 1);
       new_scop->language = strcpy(new_scop->language, scop->language);
     }
     new_scop->parameters = osl_generic_clone(scop->parameters);
@@ -724,7 +899,7 @@ bool osl_scop_equal(const osl_scop_t* s1, const osl_scop_t* s2) {
       return 0;
     }
 
-    if (!osl_statement_equal(s1->statement, s2->statement)) {
+    if (!osl_scop_statement_equal(s1->statement, s2->statement)) {
       OSL_info("statements are not the same");
       return 0;
     }
@@ -749,6 +924,157 @@ bool osl_scop_equal(const osl_scop_t* s1, const osl_scop_t* s2) {
   return 1;
 }
 
+/**
+ * osl_scop_hash function:
+ * this function returns a 64-bit hash of the content of a scop list. Two
+ * scop lists that are equal according to osl_scop_equal() have the same
+ * hash, whatever their precision. The registry of extension interfaces is
+ * not part of the content and is not hashed.
+ * \param[in] scop The scop list to hash (possibly NULL).
+ * \return The hash of the scop list.
+ */
+uint64_t osl_scop_hash(const osl_scop_t* scop) {
+  uint64_t hash = 0;
+  int nb_scops = 0;
+
+  for (; scop != NULL; scop = scop->next) {
+    hash = osl_util_hash_combine(hash, (uint64_t)scop->version);
+    hash = osl_util_hash_string(hash, scop->language);
+    hash = osl_util_hash_combine(hash, osl_relation_hash(scop->context));
+    hash = osl_util_hash_combine(hash, osl_generic_hash(scop->parameters));
+    hash = osl_util_hash_combine(hash, osl_statement_hash(scop->statement));
+    hash = osl_util_hash_combine(hash, osl_generic_hash(scop->extension));
+    nb_scops++;
+  }
+
+  return osl_util_hash_combine(hash, (uint64_t)nb_scops);
+}
+
+/**
+ * osl_scop_intern function:
+ * this function interns the matrices of the context and of the statement
+ * relations of every scop of a scop list in an interning table (see
+ * osl_relation_intern()). Identical matrices are then stored once, and
+ * osl_scop_clone() shares them instead of copying them, which makes it
+ * proportional to the number of statements rather than to the total size
+ * of the matrices. The table may be freed at any time, e.g.:
+ *   osl_relation_table_p table = osl_relation_table_malloc();
+ *   osl_scop_intern(table, scop);
+ *   osl_relation_table_free(table);
+ * \param[in,out] table The interning table.
+ * \param[in,out] scop  The scop list to intern.
+ */
+void osl_scop_intern(osl_relation_table_t* table, osl_scop_t* scop) {
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_intern(table, scop->context);
+    osl_statement_intern(table, scop->statement);
+  }
+}
+
+/**
+ * osl_scop_share function:
+ * this function makes the context and statement matrices of every scop of
+ * a scop list shareable by their copy-on-write clones (see
+ * osl_scop_clone_cow()), which then share them until they are modified
+ * (see osl_relation_share()).
+ * \param[in,out] scop The scop list whose matrices are made shareable.
+ */
+void osl_scop_share(osl_scop_t* scop) {
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_share(scop->context);
+    osl_statement_share(scop->statement);
+  }
+}
+
+/**
+ * osl_scop_canonicalize function:
+ * this function puts the context and statement relations of every scop of
+ * a scop list in canonical form (see osl_relation_canonicalize()), so that
+ * equivalent constraint systems compare equal, hash identically and are
+ * interned together. Extensions are left untouched.
+ * \param[in,out] scop The scop list to canonicalize.
+ */
+void osl_scop_canonicalize(osl_scop_t* scop) {
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_canonicalize(scop->context);
+    osl_statement_canonicalize(scop->statement);
+  }
+}
+
+/**
+ * osl_scop_eliminate_equalities function:
+ * this function removes the local dimensions defined by unit equalities
+ * from the context and statement relations of every scop of a scop list
+ * (see osl_relation_eliminate_equalities()). Dependence domains are left
+ * untouched since their layout is described by the dependence fields.
+ * \param[in,out] scop The scop list to simplify.
+ */
+void osl_scop_eliminate_equalities(osl_scop_t* scop) {
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_eliminate_equalities(scop->context);
+    osl_statement_eliminate_equalities(scop->statement);
+  }
+}
+
+/**
+ * osl_scop_specialize_parameters function:
+ * this function replaces some parameters of every scop of a scop list (the
+ * scops are expected to have the same parameters) with known values: the
+ * parameter columns of the context, of the statement relations and of the
+ * dependence domains are folded into their constant column and removed, and
+ * the specialized parameters are removed from the parameter names.
+ * \param[in,out] scop   The scop list to specialize.
+ * \param[in]     values The values of the parameters (one per parameter).
+ * \param[in]     mask   For each parameter, non-zero to specialize it, 0 to
+ *                       keep it (NULL to specialize every parameter).
+ */
+void osl_scop_specialize_parameters(osl_scop_t* scop, const long* values,
+                                    const int* mask) {
+  size_t i, j;
+  osl_dependence_p dependence;
+  osl_strings_p parameters;
+
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_specialize_parameters(scop->context, values, mask);
+    osl_statement_specialize_parameters(scop->statement, values, mask);
+
+    dependence = osl_generic_lookup(scop->extension,
+                                    osl_interface_atom(OSL_URI_DEPENDENCE));
+    for (; dependence != NULL; dependence = dependence->next)
+      osl_relation_specialize_parameters(dependence->domain, values, mask);
+
+    if ((scop->parameters == NULL) ||
+        !osl_generic_has_URI(scop->parameters,
+                             osl_interface_atom(OSL_URI_STRINGS)))
+      continue;
+    parameters = scop->parameters->data;
+    for (i = 0, j = 0; parameters->string[i] != NULL; i++) {
+      if ((mask == NULL) || mask[i])
+        OSL_free(parameters->string[i]);
+      else
+        parameters->string[j++] = parameters->string[i];
+    }
+    parameters->string[j] = NULL;
+    osl_strings_sync(parameters);
+    if (j == 0) {
+      osl_generic_free(scop->parameters);
+      scop->parameters = NULL;
+    }
+  }
+}
+
+/**
+ * osl_scop_substitute_iterators function:
+ * this function rewrites the body of every statement of every scop of a
+ * scop list, replacing its original iterators with "@i@" or "(@i@)" where i
+ * is their rank (see osl_statement_substitute_iterators()).
+ * \param[in,out] scop The scop list whose statement bodies are rewritten.
+ */
+void osl_scop_substitute_iterators(osl_scop_t* scop) {
+  for (; scop != NULL; scop = scop->next)
+    osl_statement_substitute_iterators(scop->statement);
+}
+
 /**
  * osl_scop_integrity_check function:
  * This function checks that a scop is "well formed". It returns 0 if the
@@ -761,10 +1087,7 @@ int osl_scop_integrity_check(const osl_scop_t* scop) {
 
   while (scop != NULL) {
     // Check the language.
-    if ((scop->language != NULL) &&
-        (!strcmp(scop->language, "caml") || !strcmp(scop->language, "Caml") ||
-         !strcmp(scop->language, "ocaml") || !strcmp(scop->language, "OCaml")))
-      fprintf(stderr, "[OpenScop] Alert: What ?! Caml ?! Are you sure ?!?!\n");
+    osl_scop_language_check(scop->language);
 
     // Check the context.
     if (!osl_relation_integrity_check(scop->context, OSL_TYPE_CONTEXT,
@@ -780,7 +1103,7 @@ int osl_scop_integrity_check(const osl_scop_t* scop) {
 
     // TODO : check the number of parameter strings.
 
-    if (!osl_statement_integrity_check(scop->statement, expected_nb_parameters))
+    if (!osl_scop_statement_check(scop->statement, expected_nb_parameters))
       return 0;
 
     scop = scop->next;
@@ -809,7 +1132,9 @@ int osl_scop_check_compatible_scoplib(const osl_scop_t* scop) {
   osl_relation_p scattering;
   int precision = scop->statement->scattering->precision;
   int i, j;
+  osl_int_t value;
 
+  osl_int_init(precision, &value);
   statement = scop->statement;
   while (statement != NULL) {
     scattering = statement->scattering;
@@ -832,13 +1157,14 @@ int osl_scop_check_compatible_scoplib(const osl_scop_t* scop) {
     // and the lines MUST be in the right order
     for (i = 0; i < scattering->nb_rows; i++) {
       for (j = 0; j < scattering->nb_output_dims; j++) {
+        osl_relation_get_value(scattering, i, j + 1, &value);
         if (i == j) {  // -1
-          if (!osl_int_mone(precision, scattering->m[i][j + 1])) {
+          if (!osl_int_mone(precision, value)) {
             OSL_error("Wrong -Identity");
             return 0;
           }
         } else {  // 0
-          if (!osl_int_zero(precision, scattering->m[i][j + 1])) {
+          if (!osl_int_zero(precision, value)) {
             OSL_error("Wrong -Identity");
             return 0;
           }
@@ -849,6 +1175,7 @@ int osl_scop_check_compatible_scoplib(const osl_scop_t* scop) {
     statement = statement->next;
   }
 
+  osl_int_clear(precision, &value);
   return 1;
 }
 
@@ -945,9 +1272,10 @@ void osl_scop_get_attributes(const osl_scop_t* scop, int* nb_parameters,
  * \param[in,out] scop The scop to nomalize the scattering functions.
  */
 void osl_scop_normalize_scattering(osl_scop_t* scop) {
+  int i, nb_statements;
   int max_scattering_dims = 0;
   osl_statement_p statement;
-  osl_relation_p extended;
+  osl_scop_job_t job;
 
   if ((scop != NULL) && (scop->statement != NULL)) {
     // Get the max number of scattering dimensions.
@@ -960,16 +1288,351 @@ void osl_scop_normalize_scattering(osl_scop_t* scop) {
       statement = statement->next;
     }
 
+    // Normalize, possibly in parallel.
+    if ((nb_statements = osl_scop_parallel(scop->statement, 1)) > 0) {
+      OSL_malloc(job.target, osl_statement_p*,
+                 (size_t)nb_statements * sizeof(osl_statement_p));
+      statement = scop->statement;
+      for (i = 0; i < nb_statements; i++, statement = statement->next)
+        job.target[i] = statement;
+      job.value = max_scattering_dims;
+      osl_util_parallel_for(nb_statements, osl_scop_normalize_loop, &job);
+      OSL_free(job.target);
+      return;
+    }
+
     // Normalize.
     statement = scop->statement;
     while (statement != NULL) {
-      if (statement->scattering != NULL) {
-        extended = osl_relation_extend_output(statement->scattering,
-                                              max_scattering_dims);
-        osl_relation_free(statement->scattering);
-        statement->scattering = extended;
-      }
+      osl_relation_extend_output_inplace(statement->scattering,
+                                         max_scattering_dims);
       statement = statement->next;
     }
   }
 }
+
+/**
+ * osl_scop_set_precision function:
+ * this function converts the relations of a scop list (contexts,
+ * statement relations and dependence domains) to a given precision, see
+ * osl_relation_set_precision(). The statements are converted in parallel
+ * when worker threads are available (see osl_util_set_nb_threads()).
+ * \param[in]     precision The new precision.
+ * \param[in,out] scop      The scop list to convert.
+ */
+void osl_scop_set_precision(int const precision, osl_scop_t* scop) {
+  int i, nb_statements;
+  osl_statement_p statement;
+  osl_relation_list_p list;
+  osl_dependence_p dependence;
+  osl_scop_job_t job;
+
+  for (; scop != NULL; scop = scop->next) {
+    osl_relation_set_precision(precision, scop->context);
+
+    if ((nb_statements = osl_scop_parallel(scop->statement, 1)) > 0) {
+      OSL_malloc(job.target, osl_statement_p*,
+                 (size_t)nb_statements * sizeof(osl_statement_p));
+      statement = scop->statement;
+      for (i = 0; i < nb_statements; i++, statement = statement->next)
+        job.target[i] = statement;
+      job.value = precision;
+      osl_util_parallel_for(nb_statements, osl_scop_precision_loop, &job);
+      OSL_free(job.target);
+    } else {
+      for (statement = scop->statement; statement != NULL;
+           statement = statement->next) {
+        osl_relation_set_precision(precision, statement->domain);
+        osl_relation_set_precision(precision, statement->scattering);
+        for (list = statement->access; list != NULL; list = list->next)
+          osl_relation_set_precision(precision, list->elt);
+      }
+    }
+
+    dependence = osl_generic_lookup(scop->extension,
+                                    osl_interface_atom(OSL_URI_DEPENDENCE));
+    for (; dependence != NULL; dependence = dependence->next)
+      osl_relation_set_precision(precision, dependence->domain);
+  }
+}
+
+/**
+ * osl_scop_parallel internal function:
+ * this function decides whether an operation on the statements of a scop
+ * should process them in parallel. This is the case when several worker
+ * threads are available (see osl_util_set_nb_threads()), when there is no
+ * current arena (arenas are bound to a thread) and, for operations that
+ * may take or release references to shared matrices, when no statement
+ * relation is shared (reference counts are not updated atomically).
+ * \param[in] statement The statement list to process.
+ * \param[in] shares    1 if the operation may update reference counts.
+ * \return The number of statements to process in parallel, 0 to process
+ *         them serially.
+ */
+int osl_scop_parallel(const osl_statement_t* statement, int shares) {
+  int nb_statements;
+  const osl_statement_t* node;
+  osl_relation_list_p list;
+
+  if ((osl_util_get_nb_threads() < 2) || (osl_arena_get_current() != NULL))
+    return 0;
+
+  nb_statements = osl_statement_number(statement);
+  if (nb_statements < 2)
+    return 0;
+
+  if (shares) {
+    for (node = statement; node != NULL; node = node->next) {
+      if (osl_relation_is_shared(node->domain) ||
+          osl_relation_is_shared(node->scattering))
+        return 0;
+      for (list = node->access; list != NULL; list = list->next)
+        if (osl_relation_is_shared(list->elt))
+          return 0;
+    }
+  }
+
+  return nb_statements;
+}
+
+/**
+ * osl_scop_statement_array internal function:
+ * this function returns a newly allocated array of the first statements
+ * of a statement list, in order.
+ * \param[in] statement     The statement list.
+ * \param[in] nb_statements The number of statements to put in the array.
+ * \return The array of statements.
+ */
+const osl_statement_t** osl_scop_statement_array(
+    const osl_statement_t* statement, int nb_statements) {
+  int i;
+  const osl_statement_t** array;
+
+  OSL_malloc(array, const osl_statement_t**,
+             (size_t)nb_statements * sizeof(const osl_statement_t*));
+  for (i = 0; i < nb_statements; i++, statement = statement->next)
+    array[i] = statement;
+
+  return array;
+}
+
+/**
+ * osl_scop_statement_link internal function:
+ * this function links the statement lists of an array (possibly NULL) in
+ * the array order and returns the resulting list.
+ * \param[in,out] array         The array of statement lists.
+ * \param[in]     nb_statements The size of the array.
+ * \return The concatenation of the statement lists.
+ */
+osl_statement_t* osl_scop_statement_link(osl_statement_t** array,
+                                         int nb_statements) {
+  int i;
+  osl_statement_p result = NULL, last = NULL;
+
+  for (i = 0; i < nb_statements; i++) {
+    if (array[i] == NULL)
+      continue;
+    if (last == NULL)
+      result = array[i];
+    else
+      last->next = array[i];
+    for (last = array[i]; last->next != NULL; last = last->next)
+      continue;
+  }
+
+  return result;
+}
+
+/**
+ * osl_scop_clone_loop internal function:
+ * this function clones one statement of a scop job.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statement.
+ */
+void osl_scop_clone_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+
+  job->target[i] = osl_statement_nclone(job->source[i], 1);
+}
+
+/**
+ * osl_scop_equal_loop internal function:
+ * this function compares one pair of statements of a scop job.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statements.
+ */
+void osl_scop_equal_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+  osl_statement_t s1 = *job->source[i];
+  osl_statement_t s2 = *job->other[i];
+
+  // Compare the statements alone, not the rest of their lists.
+  s1.next = NULL;
+  s2.next = NULL;
+  job->result[i] = osl_statement_equal(&s1, &s2);
+}
+
+/**
+ * osl_scop_check_loop internal function:
+ * this function checks the integrity of one statement of a scop job, with
+ * the expected number of parameters as the job value.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statement.
+ */
+void osl_scop_check_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+  osl_statement_t statement = *job->source[i];
+
+  // Check the statement alone, not the rest of its list.
+  statement.next = NULL;
+  job->result[i] = osl_statement_integrity_check(&statement, job->value);
+}
+
+/**
+ * osl_scop_remove_unions_loop internal function:
+ * this function splits the unions of one statement of a scop job.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statement.
+ */
+void osl_scop_remove_unions_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+
+  job->target[i] = osl_statement_remove_unions(job->source[i]);
+}
+
+/**
+ * osl_scop_normalize_loop internal function:
+ * this function extends the scattering of one statement of a scop job to
+ * the number of output dimensions given as the job value.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statement.
+ */
+void osl_scop_normalize_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+
+  osl_relation_extend_output_inplace(job->target[i]->scattering, job->value);
+}
+
+/**
+ * osl_scop_precision_loop internal function:
+ * this function converts the relations of one statement of a scop job to
+ * the precision given as the job value.
+ * \param[in,out] data The scop job.
+ * \param[in]     i    The rank of the statement.
+ */
+void osl_scop_precision_loop(void* data, int i) {
+  osl_scop_job_t* job = data;
+  osl_statement_p statement = job->target[i];
+  osl_relation_list_p list;
+
+  osl_relation_set_precision(job->value, statement->domain);
+  osl_relation_set_precision(job->value, statement->scattering);
+  for (list = statement->access; list != NULL; list = list->next)
+    osl_relation_set_precision(job->value, list->elt);
+}
+
+/**
+ * osl_scop_statement_clone internal function:
+ * this function clones a statement list, see osl_statement_clone(). The
+ * statements are cloned in parallel when possible (see
+ * osl_scop_parallel()).
+ * \param[in] statement The statement list to clone.
+ * \return The clone of the statement list.
+ */
+osl_statement_t* osl_scop_statement_clone(const osl_statement_t* statement) {
+  int nb_statements;
+  osl_statement_p clone;
+  osl_scop_job_t job;
+
+  if ((nb_statements = osl_scop_parallel(statement, 1)) == 0)
+    return osl_statement_clone(statement);
+
+  job.source = osl_scop_statement_array(statement, nb_statements);
+  OSL_malloc(job.target, osl_statement_p*,
+             (size_t)nb_statements * sizeof(osl_statement_p));
+  osl_util_parallel_for(nb_statements, osl_scop_clone_loop, &job);
+  clone = osl_scop_statement_link(job.target, nb_statements);
+  OSL_free(job.source);
+  OSL_free(job.target);
+
+  return clone;
+}
+
+/**
+ * osl_scop_statement_equal internal function:
+ * this function compares two statement lists, see osl_statement_equal().
+ * The statements are compared in parallel when possible (see
+ * osl_scop_parallel()).
+ * \param[in] s1 The first statement list.
+ * \param[in] s2 The second statement list.
+ * \return 1 if the statement lists are the same, 0 otherwise.
+ */
+int osl_scop_statement_equal(const osl_statement_t* s1,
+                             const osl_statement_t* s2) {
+  int i, equal, nb_statements;
+  osl_scop_job_t job;
+
+  if (s1 == s2)
+    return 1;
+  if ((s1 == NULL) || (s2 == NULL))
+    return 0;
+
+  nb_statements = osl_scop_parallel(s1, 0);
+  if ((nb_statements == 0) || (osl_statement_number(s2) != nb_statements))
+    return osl_statement_equal(s1, s2);
+
+  job.source = osl_scop_statement_array(s1, nb_statements);
+  job.other = osl_scop_statement_array(s2, nb_statements);
+  OSL_malloc(job.result, int*, (size_t)nb_statements * sizeof(int));
+  osl_util_parallel_for(nb_statements, osl_scop_equal_loop, &job);
+  equal = 1;
+  for (i = 0; i < nb_statements; i++)
+    equal = equal && job.result[i];
+  OSL_free(job.source);
+  OSL_free(job.other);
+  OSL_free(job.result);
+
+  return equal;
+}
+
+/**
+ * osl_scop_statement_check internal function:
+ * this function checks the integrity of a statement list, see
+ * osl_statement_integrity_check(). The statements are checked in parallel
+ * when possible (see osl_scop_parallel()).
+ * \param[in] statement              The statement list to check.
+ * \param[in] expected_nb_parameters Expected number of parameters.
+ * \return 1 if the statement list is well formed, 0 otherwise.
+ */
+int osl_scop_statement_check(const osl_statement_t* statement,
+                             int expected_nb_parameters) {
+  int i, valid, nb_statements;
+  osl_scop_job_t job;
+
+  if ((nb_statements = osl_scop_parallel(statement, 0)) == 0)
+    return osl_statement_integrity_check(statement, expected_nb_parameters);
+
+  job.source = osl_scop_statement_array(statement, nb_statements);
+  OSL_malloc(job.result, int*, (size_t)nb_statements * sizeof(int));
+  job.value = expected_nb_parameters;
+  osl_util_parallel_for(nb_statements, osl_scop_check_loop, &job);
+  valid = 1;
+  for (i = 0; i < nb_statements; i++)
+    valid = valid && job.result[i];
+  OSL_free(job.source);
+  OSL_free(job.result);
+
+  return valid;
+}
+
+/**
+ * osl_scop_language_check internal function:
+ * this function warns about some unlikely languages.
+ * \param[in] language The language of a scop.
+ */
+void osl_scop_language_check(const char* language) {
+  if ((language != NULL) &&
+      (!strcmp(language, "caml") || !strcmp(language, "Caml") ||
+       !strcmp(language, "ocaml") || !strcmp(language, "OCaml")))
+    fprintf(stderr, "[OpenScop] Alert: What ?! Caml ?! Are you sure ?!?!\n");
+}
@@ -77,6 +77,11 @@
 static osl_names_t* osl_statement_names(const osl_statement_t*);
 static void osl_statement_dispatch(osl_statement_t*, osl_relation_list_t*);
 static osl_relation_p osl_relation_clone_one_safe(const osl_relation_t*);
+static size_t osl_statement_index_hash(const osl_statement_index_t*,
+                                       const osl_statement_t*);
+static void osl_statement_index_insert(osl_statement_index_t*, int);
+static void osl_statement_index_rehash(osl_statement_index_t*);
+static void osl_statement_index_delete(osl_statement_index_t*, size_t);
 
 /******************************************************************************
  *                         Structure display functions                        *
@@ -208,7 +213,8 @@ void osl_statement_pprint(FILE* const file, const osl_statement_t* statement,
 
   while (statement != NULL) {
     // If possible, replace iterator names with statement iterator names.
-    body = (osl_body_p)osl_generic_lookup(statement->extension, OSL_URI_BODY);
+    body = (osl_body_p)osl_generic_lookup(statement->extension,
+                                          osl_interface_atom(OSL_URI_BODY));
     if (body && body->iterators != NULL) {
       iterators_backedup = 1;
       iterators_backup = names->iterators;
@@ -296,7 +302,8 @@ void osl_statement_pprint_scoplib(FILE* const file,
 
   while (statement != NULL) {
     // If possible, replace iterator names with statement iterator names.
-    body = (osl_body_p)osl_generic_lookup(statement->extension, OSL_URI_BODY);
+    body = (osl_body_p)osl_generic_lookup(statement->extension,
+                                          osl_interface_atom(OSL_URI_BODY));
     if (body && body->iterators != NULL) {
       iterators_backedup = 1;
       iterators_backup = names->iterators;
@@ -367,6 +374,50 @@ void osl_statement_print(FILE* const file, const osl_statement_t* statement) {
   osl_statement_pprint(file, statement, NULL);
 }
 
+/**
+ * osl_statement_index_idump function:
+ * this function displays an osl_statement_index_t structure (*index) into a
+ * file (file, possibly stdout) in a way that trends to be understandable.
+ * It includes an indentation level (level) in order to work with others
+ * idump functions.
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The statement index whose information has to be printed.
+ * \param[in] level Number of spaces before printing, for each line.
+ */
+void osl_statement_index_idump(FILE* const file,
+                               const osl_statement_index_t* const index,
+                               int level) {
+  int j;
+
+  // Go to the right level.
+  for (j = 0; j < level; j++)
+    fprintf(file, "|\t");
+
+  if (index != NULL) {
+    fprintf(file, "+-- osl_statement_index_t: %d statement(s), %zu slot(s)\n",
+            index->nb_statements, index->nb_slots);
+  } else {
+    fprintf(file, "+-- NULL statement index\n");
+  }
+
+  // The last line.
+  for (j = 0; j <= level; j++)
+    fprintf(file, "|\t");
+  fprintf(file, "\n");
+}
+
+/**
+ * osl_statement_index_dump function:
+ * this function prints the content of an osl_statement_index_t structure
+ * (*index) into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] index The statement index whose information has to be printed.
+ */
+void osl_statement_index_dump(FILE* const file,
+                              const osl_statement_index_t* const index) {
+  osl_statement_index_idump(file, index, 0);
+}
+
 /******************************************************************************
  *                               Reading function                             *
  ******************************************************************************/
@@ -463,16 +514,14 @@ osl_statement_t* osl_statement_pread(FILE* const file,
  * this function is equivalent to osl_statement_pread() except that
  * (1) the precision corresponds to the precision environment variable or
  *     to the highest available precision if it is not defined, and
- * (2) the list of known interface is set to the default one.
+ * (2) the list of known interface is the frozen (default) registry.
  * \see{osl_statement_pread}
  */
 osl_statement_t* osl_statement_read(FILE* const foo) {
   int precision = osl_util_get_precision();
-  osl_interface_p registry = osl_interface_get_default_registry();
-  osl_statement_p statement = osl_statement_pread(foo, registry, precision);
+  osl_interface_p registry = osl_interface_get_frozen_registry();
 
-  osl_interface_free(registry);
-  return statement;
+  return osl_statement_pread(foo, registry, precision);
 }
 
 /******************************************************************************
@@ -515,11 +564,26 @@ void osl_statement_free(osl_statement_t* statement) {
     osl_relation_list_free(statement->access);
     osl_generic_free(statement->extension);
 
-    free(statement);
+    OSL_free(statement);
     statement = next;
   }
 }
 
+/**
+ * osl_statement_index_free function:
+ * this function frees the allocated memory for an osl_statement_index_t
+ * structure. The indexed statements are not freed.
+ * \param[in,out] index The pointer to the statement index to free.
+ */
+void osl_statement_index_free(osl_statement_index_t* index) {
+  if (index == NULL)
+    return;
+
+  OSL_free(index->statement);
+  OSL_free(index->slot);
+  OSL_free(index);
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -527,7 +591,9 @@ void osl_statement_free(osl_statement_t* statement) {
 /**
  * osl_statement_add function:
  * this function adds a statement "statement" at the end of the statement
- * list pointed by "location".
+ * list pointed by "location". If the list is indexed (see
+ * osl_statement_index_t), the new statements are indexed at the next use of
+ * the index.
  * \param[in,out] location  Address of the first element of the statement list.
  * \param[in]     statement The statement to add to the list.
  */
@@ -602,6 +668,44 @@ osl_statement_t* osl_statement_clone(const osl_statement_t* const statement) {
   return osl_statement_nclone(statement, -1);
 }
 
+/**
+ * osl_statement_clone_cow function:
+ * This functions builds and returns a copy-on-write clone of a statement
+ * list: the domain, scattering and access matrices are shared with the
+ * original statements until they are modified (see osl_statement_share()),
+ * the other parts are copied. The clone is used and released as a "hard
+ * copy" (see osl_relation_clone_cow() for the only restriction).
+ * \param[in,out] statement The statement list to clone (its matrices get
+ *                          shared).
+ * \return A pointer to the copy-on-write clone of the statement list.
+ */
+osl_statement_t* osl_statement_clone_cow(osl_statement_t* statement) {
+  int first = 1;
+  osl_statement_p clone = NULL, node, previous = NULL;
+
+  while (statement != NULL) {
+    node = osl_statement_malloc();
+    node->domain = osl_relation_clone_cow(statement->domain);
+    node->scattering = osl_relation_clone_cow(statement->scattering);
+    node->access = osl_relation_list_clone_cow(statement->access);
+    node->extension = osl_generic_clone(statement->extension);
+    node->next = NULL;
+
+    if (first) {
+      first = 0;
+      clone = node;
+      previous = node;
+    } else {
+      previous->next = node;
+      previous = previous->next;
+    }
+
+    statement = statement->next;
+  }
+
+  return clone;
+}
+
 /// Clone first part of the union, return NULL if input is NULL.
 osl_relation_t* osl_relation_clone_one_safe(
     const osl_relation_t* const relation) {
@@ -707,6 +811,185 @@ int osl_statement_equal(const osl_statement_t* const s1,
   return 1;
 }
 
+/**
+ * osl_statement_hash function:
+ * this function returns a 64-bit hash of the content of a statement list
+ * (the usr field is not hashed). Two statement lists that are equal
+ * according to osl_statement_equal() have the same hash.
+ * \param[in] statement The statement list to hash (possibly NULL).
+ * \return The hash of the statement list.
+ */
+uint64_t osl_statement_hash(const osl_statement_t* statement) {
+  uint64_t hash = 0;
+  int nb_statements = 0;
+
+  for (; statement != NULL; statement = statement->next) {
+    hash = osl_util_hash_combine(hash, osl_relation_hash(statement->domain));
+    hash = osl_util_hash_combine(hash,
+                                 osl_relation_hash(statement->scattering));
+    hash = osl_util_hash_combine(hash,
+                                 osl_relation_list_hash(statement->access));
+    hash = osl_util_hash_combine(hash,
+                                 osl_generic_hash(statement->extension));
+    nb_statements++;
+  }
+
+  return osl_util_hash_combine(hash, (uint64_t)nb_statements);
+}
+
+/**
+ * osl_statement_share function:
+ * this function makes the domain, scattering and access matrices of every
+ * statement of a statement list shareable by their copy-on-write clones
+ * (see osl_statement_clone_cow()), which then share them until they are
+ * modified (see osl_relation_share()).
+ * \param[in,out] statement The statement list whose matrices are made
+ *                          shareable.
+ */
+void osl_statement_share(osl_statement_t* statement) {
+  for (; statement != NULL; statement = statement->next) {
+    osl_relation_share(statement->domain);
+    osl_relation_share(statement->scattering);
+    osl_relation_list_share(statement->access);
+  }
+}
+
+/**
+ * osl_statement_intern function:
+ * this function interns the matrices of the domain, scattering and access
+ * relations of every statement of a statement list in an interning table
+ * (see osl_relation_intern()). Statements with identical relations then
+ * share a single copy of the matrices, and cloning them is cheap.
+ * \param[in,out] table     The interning table.
+ * \param[in,out] statement The statement list to intern.
+ */
+void osl_statement_intern(osl_relation_table_t* table,
+                          osl_statement_t* statement) {
+  for (; statement != NULL; statement = statement->next) {
+    osl_relation_intern(table, statement->domain);
+    osl_relation_intern(table, statement->scattering);
+    osl_relation_list_intern(table, statement->access);
+  }
+}
+
+/**
+ * osl_statement_canonicalize function:
+ * this function puts the domain, scattering and access relations of every
+ * statement of a statement list in canonical form (see
+ * osl_relation_canonicalize()).
+ * \param[in,out] statement The statement list to canonicalize.
+ */
+void osl_statement_canonicalize(osl_statement_t* statement) {
+  for (; statement != NULL; statement = statement->next) {
+    osl_relation_canonicalize(statement->domain);
+    osl_relation_canonicalize(statement->scattering);
+    osl_relation_list_canonicalize(statement->access);
+  }
+}
+
+/**
+ * osl_statement_specialize_parameters function:
+ * this function replaces some parameters of the domain, scattering and
+ * access relations of every statement of a statement list with known values
+ * (see osl_relation_specialize_parameters()).
+ * \param[in,out] statement The statement list to specialize.
+ * \param[in]     values    The values of the parameters (one per parameter).
+ * \param[in]     mask      For each parameter, non-zero to specialize it
+ *                          (NULL to specialize every parameter).
+ */
+void osl_statement_specialize_parameters(osl_statement_t* statement,
+                                         const long* values, const int* mask) {
+  for (; statement != NULL; statement = statement->next) {
+    osl_relation_specialize_parameters(statement->domain, values, mask);
+    osl_relation_specialize_parameters(statement->scattering, values, mask);
+    osl_relation_list_specialize_parameters(statement->access, values, mask);
+  }
+}
+
+/**
+ * osl_statement_eliminate_equalities function:
+ * this function removes the local dimensions defined by unit equalities
+ * from the domain, scattering and access relations of every statement of a
+ * statement list (see osl_relation_eliminate_equalities()).
+ * \param[in,out] statement The statement list to simplify.
+ */
+void osl_statement_eliminate_equalities(osl_statement_t* statement) {
+  for (; statement != NULL; statement = statement->next) {
+    osl_relation_eliminate_equalities(statement->domain);
+    osl_relation_eliminate_equalities(statement->scattering);
+    osl_relation_list_eliminate_equalities(statement->access);
+  }
+}
+
+/**
+ * osl_statement_substitute_iterators function:
+ * this function rewrites the body of every statement of a statement list,
+ * replacing its original iterators with "@i@" or "(@i@)" where i is their
+ * rank (see osl_util_identifier_substitution()). Both the body and the
+ * extended body extensions are rewritten, and the coordinates of the
+ * accesses of the extended body (relative to the first expression string)
+ * are updated. Each expression is scanned once, and the substitution is
+ * only prepared again when the iterators change from a statement to the
+ * next one.
+ * \param[in,out] statement The statement list whose bodies are rewritten.
+ */
+void osl_statement_substitute_iterators(osl_statement_t* statement) {
+  size_t i, k, a, length, end;
+  size_t* map;
+  char* string;
+  osl_body_p body, previous = NULL;
+  osl_extbody_p extbody;
+  osl_util_substitution_p substitution = NULL;
+
+  for (; statement != NULL; statement = statement->next) {
+    extbody = osl_generic_lookup(statement->extension,
+                                 osl_interface_atom(OSL_URI_EXTBODY));
+    for (k = 0; k < 2; k++) {
+      body = (k == 0) ? osl_generic_lookup(statement->extension,
+                                           osl_interface_atom(OSL_URI_BODY))
+                      : ((extbody != NULL) ? extbody->body : NULL);
+      if ((body == NULL) || (body->iterators == NULL) ||
+          (body->expression == NULL) || (body->expression->string == NULL))
+        continue;
+
+      if ((previous == NULL) ||
+          !osl_strings_equal(previous->iterators, body->iterators)) {
+        osl_util_substitution_free(substitution);
+        substitution =
+            osl_util_substitution_generate(body->iterators->string);
+        previous = body;
+      }
+
+      for (i = 0; body->expression->string[i] != NULL; i++) {
+        map = NULL;
+        length = strlen(body->expression->string[i]);
+        if ((k == 1) && (i == 0) && (extbody->nb_access > 0))
+          OSL_malloc(map, size_t*, (length + 1) * sizeof(size_t));
+        string = osl_util_substitution_apply(
+            substitution, body->expression->string[i], map);
+        OSL_free(body->expression->string[i]);
+        body->expression->string[i] = string;
+        if (map == NULL)
+          continue;
+
+        // The accesses out of the expression are left as they are.
+        for (a = 0; a < extbody->nb_access; a++) {
+          if ((extbody->start[a] < 0) || (extbody->length[a] < 0) ||
+              ((size_t)extbody->start[a] + (size_t)extbody->length[a] >
+               length))
+            continue;
+          end = (size_t)extbody->start[a] + (size_t)extbody->length[a];
+          extbody->start[a] = (int)map[extbody->start[a]];
+          extbody->length[a] = (int)(map[end] - (size_t)extbody->start[a]);
+        }
+        OSL_free(map);
+      }
+      osl_strings_sync(body->expression);
+    }
+  }
+  osl_util_substitution_free(substitution);
+}
+
 /**
  * osl_statement_integrity_check function:
  * this function checks that a statement is "well formed" according to some
@@ -751,7 +1034,8 @@ int osl_statement_integrity_check(const osl_statement_t* statement,
     }
 
     // Check the statement body.
-    body = (osl_body_p)osl_generic_lookup(statement->extension, OSL_URI_BODY);
+    body = (osl_body_p)osl_generic_lookup(statement->extension,
+                                          osl_interface_atom(OSL_URI_BODY));
     if ((expected_nb_iterators != OSL_UNDEFINED) && body &&
         body->iterators != NULL &&
         ((size_t)expected_nb_iterators != osl_strings_size(body->iterators))) {
@@ -845,12 +1129,249 @@ osl_body_t* osl_statement_get_body(const osl_statement_t* const statement) {
     return NULL;
   }
 
-  body = (osl_body_p)osl_generic_lookup(statement->extension, OSL_URI_BODY);
+  body = (osl_body_p)osl_generic_lookup(statement->extension,
+                                        osl_interface_atom(OSL_URI_BODY));
   if (body != NULL)
     return body;
-  ebody =
-      (osl_extbody_p)osl_generic_lookup(statement->extension, OSL_URI_EXTBODY);
+  ebody = (osl_extbody_p)osl_generic_lookup(
+      statement->extension, osl_interface_atom(OSL_URI_EXTBODY));
   if (ebody != NULL)
     return ebody->body;
   return NULL;
 }
+
+/**
+ * osl_statement_index_hash internal function:
+ * this function returns the first slot where to look for the label of a
+ * statement in the hash table of a statement index.
+ * \param[in] index     The statement index.
+ * \param[in] statement The statement.
+ * \return The first slot of the statement.
+ */
+size_t osl_statement_index_hash(const osl_statement_index_t* index,
+                                const osl_statement_t* statement) {
+  uint64_t hash = osl_util_hash_combine(0, (uint64_t)(uintptr_t)statement);
+
+  return (size_t)hash & (index->nb_slots - 1);
+}
+
+/**
+ * osl_statement_index_insert internal function:
+ * this function inserts the label of an indexed statement in the hash
+ * table of a statement index, which must have a free slot.
+ * \param[in,out] index The statement index.
+ * \param[in]     label The label of the statement.
+ */
+void osl_statement_index_insert(osl_statement_index_t* index, int label) {
+  size_t k = osl_statement_index_hash(index, index->statement[label]);
+
+  // Linear probing.
+  while (index->slot[k] != OSL_UNDEFINED)
+    k = (k + 1) & (index->nb_slots - 1);
+  index->slot[k] = label;
+}
+
+/**
+ * osl_statement_index_rehash internal function:
+ * this function rebuilds the hash table of labels of a statement index,
+ * resizing it to keep its load factor under 1/2.
+ * \param[in,out] index The statement index.
+ */
+void osl_statement_index_rehash(osl_statement_index_t* index) {
+  int label;
+  size_t k, nb_slots = 16;
+
+  while (nb_slots < 2 * (size_t)index->nb_statements)
+    nb_slots *= 2;
+  if (nb_slots != index->nb_slots) {
+    OSL_free(index->slot);
+    OSL_malloc(index->slot, int*, nb_slots * sizeof(int));
+    index->nb_slots = nb_slots;
+  }
+  for (k = 0; k < nb_slots; k++)
+    index->slot[k] = OSL_UNDEFINED;
+
+  for (label = 0; label < index->nb_statements; label++)
+    osl_statement_index_insert(index, label);
+}
+
+/**
+ * osl_statement_index_delete internal function:
+ * this function empties a slot of the hash table of a statement index, and
+ * moves back the next labels of its probe sequence that could no longer be
+ * found otherwise (backward shift deletion), so that no tombstone is needed.
+ * \param[in,out] index The statement index.
+ * \param[in]     hole  The slot to empty.
+ */
+void osl_statement_index_delete(osl_statement_index_t* index, size_t hole) {
+  size_t home, mask = index->nb_slots - 1;
+  size_t k = (hole + 1) & mask;
+
+  for (; index->slot[k] != OSL_UNDEFINED; k = (k + 1) & mask) {
+    home = osl_statement_index_hash(index, index->statement[index->slot[k]]);
+    // The label stays if its home slot is cyclically in (hole, k].
+    if (((k - home) & mask) < ((k - hole) & mask))
+      continue;
+    index->slot[hole] = index->slot[k];
+    hole = k;
+  }
+  index->slot[hole] = OSL_UNDEFINED;
+}
+
+/**
+ * osl_statement_index_generate function:
+ * this function builds an index of a statement list, see
+ * osl_statement_index_t. The index keeps the address of the list head to
+ * update it when statements are added or removed through the index.
+ * \param[in] list The address of the head of the statement list to index.
+ * \return A newly allocated statement index.
+ */
+osl_statement_index_t* osl_statement_index_generate(osl_statement_t** list) {
+  osl_statement_index_p index;
+
+  OSL_malloc(index, osl_statement_index_p, sizeof(osl_statement_index_t));
+  index->list = list;
+  index->nb_statements = 0;
+  index->size = 0;
+  index->statement = NULL;
+  index->nb_slots = 0;
+  index->slot = NULL;
+
+  osl_statement_index_add(index, NULL);
+  return index;
+}
+
+/**
+ * osl_statement_index_get function:
+ * this function returns the statement of a given label in a statement
+ * index, in constant time. Statements appended to the indexed list (e.g.,
+ * with osl_statement_add()) since the last use of the index are indexed
+ * first.
+ * \param[in] index The statement index.
+ * \param[in] label The label of the statement (its rank, from 0).
+ * \return The statement with the given label, NULL if there is none.
+ */
+osl_statement_t* osl_statement_index_get(osl_statement_index_t* index,
+                                         int label) {
+  if (index == NULL)
+    return NULL;
+
+  osl_statement_index_add(index, NULL);
+  if ((label < 0) || (label >= index->nb_statements))
+    return NULL;
+
+  return index->statement[label];
+}
+
+/**
+ * osl_statement_index_label function:
+ * this function returns the label of a statement (its rank in the list,
+ * from 0) thanks to a statement index, in constant expected time.
+ * Statements appended to the indexed list since the last use of the index
+ * are indexed first.
+ * \param[in] index     The statement index.
+ * \param[in] statement The statement to find.
+ * \return The label of the statement, OSL_UNDEFINED if it is not indexed.
+ */
+int osl_statement_index_label(osl_statement_index_t* index,
+                              const osl_statement_t* statement) {
+  size_t k;
+
+  if ((index == NULL) || (statement == NULL))
+    return OSL_UNDEFINED;
+
+  osl_statement_index_add(index, NULL);
+  if (index->nb_slots == 0)
+    return OSL_UNDEFINED;
+
+  k = osl_statement_index_hash(index, statement);
+  while (index->slot[k] != OSL_UNDEFINED) {
+    if (index->statement[index->slot[k]] == statement)
+      return index->slot[k];
+    k = (k + 1) & (index->nb_slots - 1);
+  }
+  return OSL_UNDEFINED;
+}
+
+/**
+ * osl_statement_index_add function:
+ * this function appends a statement list at the end of the list indexed by
+ * a statement index, and indexes the new statements. As a special case,
+ * when statement is NULL, the statements of the list that are not indexed
+ * yet are indexed.
+ * \param[in,out] index     The statement index.
+ * \param[in]     statement The statement list to append (may be NULL).
+ */
+void osl_statement_index_add(osl_statement_index_t* index,
+                             osl_statement_t* statement) {
+  int nb_statements = index->nb_statements;
+  osl_statement_p* location;
+
+  // The new statements are linked after the last indexed one.
+  if (index->nb_statements > 0)
+    location = &index->statement[index->nb_statements - 1]->next;
+  else
+    location = index->list;
+  if (statement != NULL) {
+    if (*location != NULL)
+      OSL_error("the indexed list has been modified");
+    *location = statement;
+  }
+
+  for (statement = *location; statement != NULL; statement = statement->next) {
+    if (nb_statements == index->size) {
+      index->size = (index->size > 0) ? 2 * index->size : 16;
+      OSL_realloc(index->statement, osl_statement_p*,
+                  (size_t)index->size * sizeof(osl_statement_p));
+    }
+    index->statement[nb_statements++] = statement;
+  }
+  // The table is only rebuilt when it grows, else the new labels are added.
+  if (2 * (size_t)nb_statements > index->nb_slots) {
+    index->nb_statements = nb_statements;
+    osl_statement_index_rehash(index);
+  } else {
+    while (index->nb_statements < nb_statements)
+      osl_statement_index_insert(index, index->nb_statements++);
+  }
+}
+
+/**
+ * osl_statement_index_remove function:
+ * this function removes the statement of a given label from the list
+ * indexed by a statement index, and returns it. The labels of the next
+ * statements are decremented. The hash table is fixed up in place rather
+ * than rebuilt, in time linear in its size but without any hashing.
+ * \param[in,out] index The statement index.
+ * \param[in]     label The label of the statement to remove.
+ * \return The removed statement, which is not linked to any other one.
+ */
+osl_statement_t* osl_statement_index_remove(osl_statement_index_t* index,
+                                            int label) {
+  int i;
+  size_t k;
+  osl_statement_p statement = osl_statement_index_get(index, label);
+
+  if (statement == NULL)
+    OSL_error("statement label out of range");
+
+  // Delete the label from the table, then shift the next labels.
+  k = osl_statement_index_hash(index, statement);
+  while (index->slot[k] != label)
+    k = (k + 1) & (index->nb_slots - 1);
+  osl_statement_index_delete(index, k);
+  for (k = 0; k < index->nb_slots; k++)
+    if (index->slot[k] > label)
+      index->slot[k]--;
+
+  if (label > 0)
+    index->statement[label - 1]->next = statement->next;
+  else
+    *index->list = statement->next;
+  for (i = label; i < index->nb_statements - 1; i++)
+    index->statement[i] = index->statement[i + 1];
+  index->nb_statements--;
+  statement->next = NULL;
+
+  return statement;
+}
@@ -59,6 +59,7 @@
  ******************************************************************************/
 
 #include <ctype.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -68,6 +69,10 @@
 #include <osl/strings.h>
 #include <osl/util.h>
 
+static int osl_strings_synced(const osl_strings_t*);
+static void osl_strings_set(osl_strings_t*, char**, size_t);
+static void osl_strings_index_insert(osl_strings_t*, size_t);
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -162,7 +167,7 @@ void osl_strings_print(FILE* const file, const osl_strings_t* const strings) {
   string = osl_strings_sprint(strings);
   if (string != NULL) {
     fprintf(file, "%s", string);
-    free(string);
+    OSL_free(string);
   }
 }
 
@@ -230,8 +235,7 @@ osl_strings_t* osl_strings_sread(char** const input) {
 
     // Build the strings structure
     strings = osl_strings_malloc();
-    free(strings->string);
-    strings->string = string;
+    osl_strings_set(strings, string, nb_strings);
   }
 
   return strings;
@@ -274,6 +278,11 @@ osl_strings_t* osl_strings_malloc(void) {
   OSL_malloc(strings, osl_strings_p, sizeof(osl_strings_t));
   OSL_malloc(strings->string, char**, sizeof(char*));
   strings->string[0] = NULL;
+  strings->array = strings->string;
+  strings->size = 0;
+  strings->capacity = 1;
+  strings->nb_slots = 0;
+  strings->slot = NULL;
 
   return strings;
 }
@@ -290,12 +299,13 @@ void osl_strings_free(osl_strings_t* const strings) {
     if (strings->string != NULL) {
       i = 0;
       while (strings->string[i] != NULL) {
-        free(strings->string[i]);
+        OSL_free(strings->string[i]);
         i++;
       }
-      free(strings->string);
+      OSL_free(strings->string);
     }
-    free(strings);
+    OSL_free(strings->slot);
+    OSL_free(strings);
   }
 }
 
@@ -312,6 +322,7 @@ void osl_strings_free(osl_strings_t* const strings) {
  */
 osl_strings_t* osl_strings_clone(const osl_strings_t* const strings) {
   size_t i, nb_strings;
+  char** string;
   osl_strings_p clone = NULL;
 
   if (strings == NULL)
@@ -321,45 +332,81 @@ osl_strings_t* osl_strings_clone(const osl_strings_t* const strings) {
   if ((nb_strings = osl_strings_size(strings)) == 0)
     return clone;
 
-  free(clone->string);
-  OSL_malloc(clone->string, char**, (nb_strings + 1) * sizeof(char*));
-  clone->string[nb_strings] = NULL;
+  OSL_malloc(string, char**, (nb_strings + 1) * sizeof(char*));
+  string[nb_strings] = NULL;
   for (i = 0; i < nb_strings; i++)
-    OSL_strdup(clone->string[i], strings->string[i]);
+    OSL_strdup(string[i], strings->string[i]);
+  osl_strings_set(clone, string, nb_strings);
+
+  // The clone is indexed if the original is.
+  if (strings->nb_slots > 0)
+    osl_strings_index_build(clone);
 
   return clone;
 }
 
 /**
  * osl_strings_find function.
- * this function finds the string in the strings.
+ * this function finds the string in the strings. It uses the hash index of
+ * the strings if there is one (see osl_strings_index_build()), and a linear
+ * scan otherwise. If the string appears several times, the first position
+ * is returned.
  * \param[in,out] strings The strings structure.
  * \param[in]     string  The string to find in strings.
  * \return the index where is the string, osl_strings_size if not found
  */
 size_t osl_strings_find(const osl_strings_t* const strings,
                         char const* const string) {
-  size_t i;
-  for (i = 0; i < osl_strings_size(strings); ++i) {
-    if (strcmp(strings->string[i], string) == 0) {
-      return i;
-    }
+  size_t i, size, mask;
+
+  if ((strings->nb_slots > 0) && osl_strings_synced(strings)) {
+    mask = strings->nb_slots - 1;
+    i = (size_t)osl_util_hash_string(0, string) & mask;
+    for (; strings->slot[i] != 0; i = (i + 1) & mask)
+      if (strcmp(strings->string[strings->slot[i] - 1], string) == 0)
+        return strings->slot[i] - 1;
+    return strings->size;
   }
-  return i;
+
+  size = osl_strings_size(strings);
+  for (i = 0; i < size; i++)
+    if (strcmp(strings->string[i], string) == 0)
+      return i;
+  return size;
 }
 
 /**
  * osl_strings_add function.
- * this function adds a copy of the string in the strings.
+ * this function adds a copy of the string in the strings. The array grows
+ * geometrically, so that adding strings in a loop does not reallocate it at
+ * each call.
  * \param[in,out] strings The strings structure.
  * \param[in]     string  The string to add in strings.
  */
 void osl_strings_add(osl_strings_t* const strings, char const* const string) {
-  size_t original_size = osl_strings_size(strings);
-  OSL_realloc(strings->string, char**, sizeof(char*) * (original_size + 1 + 1));
-  strings->string[original_size + 1] = NULL;
-  strings->string[original_size] = malloc(sizeof(char) * (strlen(string) + 1));
-  strcpy(strings->string[original_size], string);
+  size_t size;
+
+  if (!osl_strings_synced(strings))
+    osl_strings_sync(strings);
+  size = strings->size;
+
+  if (size + 2 > strings->capacity) {
+    strings->capacity = OSL_max(2 * strings->capacity, size + 2);
+    OSL_realloc(strings->string, char**, strings->capacity * sizeof(char*));
+    strings->array = strings->string;
+  }
+  OSL_malloc(strings->string[size], char*, strlen(string) + 1);
+  strcpy(strings->string[size], string);
+  strings->string[size + 1] = NULL;
+  strings->size = size + 1;
+
+  // Keep the index (if any) at most half full.
+  if (strings->nb_slots > 0) {
+    if (2 * strings->size + 2 > strings->nb_slots)
+      osl_strings_index_build(strings);
+    else
+      osl_strings_index_insert(strings, size);
+  }
 }
 
 /**
@@ -388,17 +435,47 @@ bool osl_strings_equal(const osl_strings_t* const s1,
   return 1;
 }
 
+/**
+ * osl_strings_hash function:
+ * this function returns a 64-bit hash of the content of an osl_strings_t
+ * structure. Two structures that are equal according to osl_strings_equal()
+ * have the same hash.
+ * \param[in] strings The strings structure to hash (possibly NULL).
+ * \return The hash of the strings structure.
+ */
+uint64_t osl_strings_hash(const osl_strings_t* const strings) {
+  uint64_t hash = 0;
+  size_t i, nb_strings;
+
+  if (strings == NULL)
+    return osl_util_hash_combine(hash, 0);
+
+  nb_strings = osl_strings_size(strings);
+  hash = osl_util_hash_combine(hash, (uint64_t)nb_strings + 1);
+  for (i = 0; i < nb_strings; i++)
+    hash = osl_util_hash_string(hash, strings->string[i]);
+
+  return hash;
+}
+
 /**
  * osl_strings_size function:
  * this function returns the number of elements in the NULL-terminated
- * strings array of the strings structure.
+ * strings array of the strings structure. It returns the cached size in
+ * constant time, unless the array has been replaced since it was cached.
  * \param[in] strings The strings structure we need to know the size.
  * \return The number of strings in the strings structure.
  */
 size_t osl_strings_size(const osl_strings_t* const strings) {
   size_t size = 0;
 
-  if ((strings != NULL) && (strings->string != NULL)) {
+  if (strings == NULL)
+    return 0;
+
+  if (osl_strings_synced(strings))
+    return strings->size;
+
+  if (strings->string != NULL) {
     while (strings->string[size] != NULL) {
       size++;
     }
@@ -407,6 +484,66 @@ size_t osl_strings_size(const osl_strings_t* const strings) {
   return size;
 }
 
+/**
+ * osl_strings_sync function:
+ * this function updates the cached size and capacity of a strings structure
+ * and rebuilds its hash index (if any). It has to be called after the
+ * strings array has been modified without using the osl_strings functions.
+ * \param[in,out] strings The strings structure to update.
+ */
+void osl_strings_sync(osl_strings_t* const strings) {
+  size_t size = 0;
+
+  if (strings == NULL)
+    return;
+
+  if (strings->string != NULL) {
+    while (strings->string[size] != NULL)
+      size++;
+  }
+
+  // The capacity is only known to be preserved if the array is the same.
+  if (strings->string == NULL)
+    strings->capacity = 0;
+  else if (strings->array == strings->string)
+    strings->capacity = OSL_max(strings->capacity, size + 1);
+  else
+    strings->capacity = size + 1;
+  strings->array = strings->string;
+  strings->size = size;
+
+  if (strings->nb_slots > 0)
+    osl_strings_index_build(strings);
+}
+
+/**
+ * osl_strings_index_build function:
+ * this function builds (or rebuilds) a hash index of the strings, so that
+ * osl_strings_find() takes constant time on average. The index is then
+ * maintained by osl_strings_add() and osl_strings_clone().
+ * \param[in,out] strings The strings structure to index.
+ */
+void osl_strings_index_build(osl_strings_t* const strings) {
+  size_t i;
+
+  if (strings == NULL)
+    return;
+
+  if (!osl_strings_synced(strings))
+    osl_strings_sync(strings);
+
+  OSL_free(strings->slot);
+  strings->nb_slots = 16;
+  while (strings->nb_slots < 2 * strings->size + 2)
+    strings->nb_slots *= 2;
+  OSL_malloc(strings->slot, size_t*, strings->nb_slots * sizeof(size_t));
+  for (i = 0; i < strings->nb_slots; i++)
+    strings->slot[i] = 0;
+
+  for (i = 0; i < strings->size; i++)
+    osl_strings_index_insert(strings, i);
+}
+
 /**
  * osl_strings_encapsulate function:
  * this function builds a new strings structure to encapsulate the string
@@ -415,11 +552,13 @@ size_t osl_strings_size(const osl_strings_t* const strings) {
  * \return A new strings structure containing only the provided string.
  */
 osl_strings_t* osl_strings_encapsulate(char* string) {
+  char** array;
   osl_strings_p capsule = osl_strings_malloc();
-  free(capsule->string);
-  OSL_malloc(capsule->string, char**, 2 * sizeof(char*));
-  capsule->string[0] = string;
-  capsule->string[1] = NULL;
+
+  OSL_malloc(array, char**, 2 * sizeof(char*));
+  array[0] = string;
+  array[1] = NULL;
+  osl_strings_set(capsule, array, (string != NULL) ? 1 : 0);
 
   return capsule;
 }
@@ -441,6 +580,7 @@ osl_interface_t* osl_strings_interface(void) {
   interface->free = (osl_free_f)osl_strings_free;
   interface->clone = (osl_clone_f)osl_strings_clone;
   interface->equal = (osl_equal_f)osl_strings_equal;
+  interface->hash = (osl_hash_f)osl_strings_hash;
 
   return interface;
 }
@@ -472,8 +612,7 @@ osl_strings_t* osl_strings_generate(const char* prefix, int nb_strings) {
   }
 
   generated = osl_strings_malloc();
-  free(generated->string);
-  generated->string = strings;
+  osl_strings_set(generated, strings, (size_t)nb_strings);
   return generated;
 }
 
@@ -499,3 +638,55 @@ void osl_strings_add_strings(osl_strings_t** const dest,
 
   *dest = res;
 }
+
+/**
+ * osl_strings_synced internal function:
+ * this function checks in constant time that the cached fields of a strings
+ * structure may be trusted: the array has not been replaced and its NULL
+ * terminator is at the cached size. Other direct modifications of the
+ * array are not detected, osl_strings_sync() has to be called after them.
+ * \param[in] strings The strings structure to check.
+ * \return 1 if the cached fields are up to date, 0 otherwise.
+ */
+int osl_strings_synced(const osl_strings_t* const strings) {
+  if (strings->array != strings->string)
+    return 0;
+
+  if (strings->string == NULL)
+    return (strings->size == 0);
+
+  return (strings->string[strings->size] == NULL);
+}
+
+/**
+ * osl_strings_set internal function:
+ * this function replaces the (empty) array of a strings structure with a
+ * NULL-terminated array of strings whose size is known.
+ * \param[in,out] strings The strings structure to modify.
+ * \param[in]     array   The new NULL-terminated array (possibly NULL).
+ * \param[in]     size    The number of strings in the new array.
+ */
+void osl_strings_set(osl_strings_t* const strings, char** const array,
+                     size_t size) {
+  OSL_free(strings->string);
+  strings->string = array;
+  strings->array = array;
+  strings->size = size;
+  strings->capacity = (array != NULL) ? size + 1 : 0;
+}
+
+/**
+ * osl_strings_index_insert internal function:
+ * this function inserts the string at a given position into the hash index
+ * of a strings structure. The index must have a free slot.
+ * \param[in,out] strings  The strings structure.
+ * \param[in]     position The position of the string to insert.
+ */
+void osl_strings_index_insert(osl_strings_t* const strings, size_t position) {
+  size_t mask = strings->nb_slots - 1;
+  size_t i = (size_t)osl_util_hash_string(0, strings->string[position]) & mask;
+
+  while (strings->slot[i] != 0)
+    i = (i + 1) & mask;
+  strings->slot[i] = position + 1;
+}
@@ -63,9 +63,68 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef OSL_GMP_IS_HERE
+#include <gmp.h>
+#endif
+
+#ifdef OSL_THREADS_ARE_HERE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#endif
+
+#include <osl/arena.h>
 #include <osl/macros.h>
 #include <osl/util.h>
 
+// Allocator hooks (see osl_set_allocator()), NULL for the C library ones.
+static osl_util_malloc_f osl_util_malloc_hook = NULL;
+static osl_util_realloc_f osl_util_realloc_hook = NULL;
+static osl_util_free_f osl_util_free_hook = NULL;
+static void* osl_util_allocator_user = NULL;
+
+// Number of worker threads of osl_util_parallel_for() (1: no parallelism).
+static int osl_util_nb_threads = 1;
+
+#ifdef OSL_THREADS_ARE_HERE
+/**
+ * The osl_util_pool_t structure is the worker pool of
+ * osl_util_parallel_for(): nb_workers threads wait for a new loop (a new
+ * generation), then share its iterations with the calling thread through
+ * the next counter. A single loop runs on the pool at a time (busy), other
+ * loops run serially.
+ */
+struct osl_util_pool {
+  pthread_mutex_t lock;  /**< Lock of the other fields */
+  pthread_cond_t start;  /**< Signaled when a loop starts or on stop */
+  pthread_cond_t done;   /**< Signaled when the last worker is done */
+  int busy;              /**< 1 if a loop or a resize is in progress */
+  int stop;              /**< 1 if the workers have to exit */
+  int nb_workers;        /**< Number of running worker threads */
+  int nb_active;         /**< Number of workers in the current loop */
+  unsigned generation;   /**< Number of the current loop */
+  pthread_t* worker;     /**< Worker threads */
+  osl_util_loop_f body;  /**< Loop body of the current loop */
+  void* data;            /**< User data of the current loop */
+  int n;                 /**< Number of iterations of the current loop */
+  atomic_int next;       /**< Next iteration to run */
+};
+typedef struct osl_util_pool osl_util_pool_t;
+
+static osl_util_pool_t osl_util_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+// 1 in the worker threads, whose nested loops run serially.
+static _Thread_local int osl_util_pool_member = 0;
+
+static void osl_util_pool_run(void);
+static void* osl_util_pool_work(void*);
+static void osl_util_pool_resize(int);
+#endif
+
 /******************************************************************************
  *                             Utility functions                              *
  ******************************************************************************/
@@ -344,7 +403,7 @@ char* osl_util_read_uptoflag(FILE* file, char** str, const char* flag) {
 
   if (!flag_found) {
     OSL_debug("flag was not found, end of input reached");
-    free(res);
+    OSL_free(res);
     return NULL;
   }
 
@@ -484,6 +543,171 @@ char* osl_util_strdup(char const* str) {
   return dup;
 }
 
+/**
+ * osl_util_malloc function:
+ * this function allocates a memory block of a given size. The block is
+ * carved out of the current arena of the calling thread if any (see
+ * osl_arena_set_current()), otherwise it is allocated on the heap. It is
+ * the allocator behind the OSL_malloc macro.
+ * \param[in] size The size of the block.
+ * \return A pointer to the allocated block, or NULL on failure.
+ */
+void* osl_util_malloc(size_t size) {
+  osl_arena_p arena = osl_arena_get_current();
+
+  if (arena != NULL)
+    return osl_arena_alloc(arena, size);
+  return osl_util_heap_malloc(size);
+}
+
+/**
+ * osl_util_realloc function:
+ * this function resizes a memory block allocated by osl_util_malloc(). The
+ * block stays where it was allocated: in its arena if it belongs to a live
+ * arena, on the heap otherwise. A NULL block is allocated as by
+ * osl_util_malloc(). It is the allocator behind the OSL_realloc macro.
+ * \param[in] ptr  The block to resize (possibly NULL).
+ * \param[in] size The new size of the block.
+ * \return A pointer to the resized block, or NULL on failure.
+ */
+void* osl_util_realloc(void* ptr, size_t size) {
+  osl_arena_p arena;
+
+  if (ptr == NULL)
+    return osl_util_malloc(size);
+
+  arena = (osl_arena_nb_live > 0) ? osl_arena_lookup(ptr) : NULL;
+  if (arena != NULL)
+    return osl_arena_realloc(arena, ptr, size);
+  return osl_util_heap_realloc(ptr, size);
+}
+
+/**
+ * osl_util_free function:
+ * this function releases a memory block allocated by osl_util_malloc() or
+ * osl_util_realloc(). Heap blocks are freed, arena blocks are left to
+ * osl_arena_free(). The arenas are only searched when at least one of them
+ * is alive. It is the deallocator behind the OSL_free macro.
+ * \param[in] ptr The block to release (possibly NULL).
+ */
+void osl_util_free(void* ptr) {
+  if ((ptr == NULL) ||
+      ((osl_arena_nb_live > 0) && (osl_arena_lookup(ptr) != NULL)))
+    return;
+  osl_util_heap_free(ptr);
+}
+
+/**
+ * osl_util_heap_malloc function:
+ * this function allocates a memory block of a given size on the heap,
+ * ignoring the current arena, with the allocator hooks if they are set
+ * (see osl_set_allocator()) or with malloc() otherwise.
+ * \param[in] size The size of the block.
+ * \return A pointer to the allocated block, or NULL on failure.
+ */
+void* osl_util_heap_malloc(size_t size) {
+  if (osl_util_malloc_hook != NULL)
+    return osl_util_malloc_hook(size, osl_util_allocator_user);
+  return malloc(size);
+}
+
+/**
+ * osl_util_heap_realloc function:
+ * this function resizes a memory block allocated by osl_util_heap_malloc(),
+ * with the allocator hooks if they are set or with realloc() otherwise.
+ * \param[in] ptr  The block to resize (possibly NULL).
+ * \param[in] size The new size of the block.
+ * \return A pointer to the resized block, or NULL on failure.
+ */
+void* osl_util_heap_realloc(void* ptr, size_t size) {
+  if (osl_util_realloc_hook != NULL)
+    return osl_util_realloc_hook(ptr, size, osl_util_allocator_user);
+  return realloc(ptr, size);
+}
+
+/**
+ * osl_util_heap_free function:
+ * this function releases a memory block allocated by osl_util_heap_malloc()
+ * or osl_util_heap_realloc(), with the allocator hooks if they are set or
+ * with free() otherwise.
+ * \param[in] ptr The block to release (possibly NULL).
+ */
+void osl_util_heap_free(void* ptr) {
+  if (ptr == NULL)
+    return;
+  if (osl_util_free_hook != NULL)
+    osl_util_free_hook(ptr, osl_util_allocator_user);
+  else
+    free(ptr);
+}
+
+#ifdef OSL_GMP_IS_HERE
+/**
+ * osl_util_gmp_malloc, osl_util_gmp_realloc and osl_util_gmp_free internal
+ * functions:
+ * these functions adapt the allocator hooks to the GMP memory functions
+ * interface (see mp_set_memory_functions()).
+ */
+static void* osl_util_gmp_malloc(size_t size) {
+  void* ptr = osl_util_heap_malloc(size);
+
+  if (ptr == NULL)
+    OSL_error("memory overflow");
+  return ptr;
+}
+
+static void* osl_util_gmp_realloc(void* ptr, size_t old_size, size_t size) {
+  (void)old_size;
+  ptr = osl_util_heap_realloc(ptr, size);
+  if (ptr == NULL)
+    OSL_error("memory overflow");
+  return ptr;
+}
+
+static void osl_util_gmp_free(void* ptr, size_t size) {
+  (void)size;
+  osl_util_heap_free(ptr);
+}
+#endif
+
+/**
+ * osl_set_allocator function:
+ * this function sets the functions used by the library for every heap
+ * allocation (OSL_malloc, OSL_realloc, OSL_strdup and OSL_free when no arena
+ * is current, arena chunks, and GMP integers in multiple precision through
+ * mp_set_memory_functions()). Each hook receives the user pointer provided
+ * as parameter as its last argument, e.g., to select a pool. Either the
+ * three hooks are provided, or none of them (all NULL) to go back to the C
+ * library (and GMP default) allocators. Hooks are process-wide: they have
+ * to be set before any library object is allocated, and not changed while
+ * such objects are alive. Strings returned by the library then have to be
+ * released with OSL_free, not with free().
+ * \param[in] malloc_fn  The allocation hook (possibly NULL).
+ * \param[in] realloc_fn The reallocation hook (possibly NULL).
+ * \param[in] free_fn    The deallocation hook (possibly NULL).
+ * \param[in] user       User data passed to each hook (possibly NULL).
+ */
+void osl_set_allocator(osl_util_malloc_f malloc_fn,
+                       osl_util_realloc_f realloc_fn, osl_util_free_f free_fn,
+                       void* user) {
+  if (((malloc_fn == NULL) != (realloc_fn == NULL)) ||
+      ((malloc_fn == NULL) != (free_fn == NULL)))
+    OSL_error("allocator hooks must be all set or all NULL");
+
+  osl_util_malloc_hook = malloc_fn;
+  osl_util_realloc_hook = realloc_fn;
+  osl_util_free_hook = free_fn;
+  osl_util_allocator_user = user;
+
+#ifdef OSL_GMP_IS_HERE
+  if (malloc_fn != NULL)
+    mp_set_memory_functions(osl_util_gmp_malloc, osl_util_gmp_realloc,
+                            osl_util_gmp_free);
+  else
+    mp_set_memory_functions(NULL, NULL, NULL);
+#endif
+}
+
 /**
  * osl_util_get_precision function:
  * this function returns the precision defined by the precision environment
@@ -538,41 +762,63 @@ void osl_util_print_provided(FILE* file, int provided, const char* title) {
   }
 }
 
+/**
+ * osl_util_is_identifier_char function:
+ * this function returns 1 if a character may be part of an identifier,
+ * i.e., if it is in [A-Za-z0-9_], 0 otherwise.
+ * \param[in] c The character to check.
+ * \return 1 if the character may be part of an identifier, 0 otherwise.
+ */
+static int osl_util_is_identifier_char(char c) {
+  return (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) ||
+          ((c >= '0') && (c <= '9')) || (c == '_'));
+}
+
+/**
+ * osl_util_hash_token function:
+ * this function returns the hash of the first characters of a string, to
+ * hash identifiers and the tokens of an expression the same way.
+ * \param[in] token  The string.
+ * \param[in] length The number of characters to hash.
+ * \return The hash of the length first characters of the string.
+ */
+static uint64_t osl_util_hash_token(const char* token, size_t length) {
+  uint64_t fnv = UINT64_C(0xcbf29ce484222325);
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    fnv ^= (unsigned char)token[i];
+    fnv *= UINT64_C(0x100000001b3);
+  }
+  return osl_util_hash_combine(0, fnv);
+}
+
 /**
  * osl_util_identifier_is_here function:
  * this function returns 1 if the input "identifier" is found at the
  * "index" position in the "expression" input string, 0 otherwise.
- * \param[in] expression The input expression.
- * \param[in] identifier The identifier to look for.
- * \param[in] index      The position in the expression where to look.
+ * \param[in] expression     The input expression.
+ * \param[in] expression_len The length of the expression.
+ * \param[in] identifier     The identifier to look for.
+ * \param[in] identifier_len The length of the identifier.
+ * \param[in] index          The position in the expression where to look.
  * \return 1 if the identifier is found at the position in the expression.
  */
 static int osl_util_identifier_is_here(const char* expression,
-                                       const char* identifier, size_t index) {
-  size_t identifier_len = strlen(identifier);
-  size_t expression_len = strlen(expression);
-
+                                       size_t expression_len,
+                                       const char* identifier,
+                                       size_t identifier_len, size_t index) {
   // If there is no space enough to find the identifier: no.
   if (identifier_len + index > expression_len)
     return 0;
 
   // If there is a character before and it is in [A-Za-z0-9_]: no.
-  if ((index > 0) &&
-      (((expression[index - 1] >= 'A') && (expression[index - 1] <= 'Z')) ||
-       ((expression[index - 1] >= 'a') && (expression[index - 1] <= 'z')) ||
-       ((expression[index - 1] >= '0') && (expression[index - 1] <= '9')) ||
-       (expression[index - 1] == '_')))
+  if ((index > 0) && osl_util_is_identifier_char(expression[index - 1]))
     return 0;
 
   // If there is a character after and it is in [A-Za-z0-9_]: no.
   if ((identifier_len + index < expression_len) &&
-      (((expression[identifier_len + index] >= 'A') &&
-        (expression[identifier_len + index] <= 'Z')) ||
-       ((expression[identifier_len + index] >= 'a') &&
-        (expression[identifier_len + index] <= 'z')) ||
-       ((expression[identifier_len + index] >= '0') &&
-        (expression[identifier_len + index] <= '9')) ||
-       (expression[identifier_len + index] == '_')))
+      osl_util_is_identifier_char(expression[identifier_len + index]))
     return 0;
 
   // If the identifier string is not here: no.
@@ -591,17 +837,17 @@ static int osl_util_identifier_is_here(const char* expression,
  * "A[2*i]". This function is lazy in the sense that it just check obvious
  * cases, not all of them. The identifier must already be at the indicated
  * position, this function does not check that.
- * \param[in] expression The input expression.
- * \param[in] identifier The identifier to check.
- * \param[in] index      The position of the identifier in the expression.
+ * \param[in] expression     The input expression.
+ * \param[in] expression_len The length of the expression.
+ * \param[in] identifier_len The length of the identifier to check.
+ * \param[in] index          The position of the identifier in the expression.
  * \return 1 if the identifier is isolated, 0 if unsure.
  */
 static int osl_util_lazy_isolated_identifier(const char* expression,
-                                             const char* identifier,
+                                             size_t expression_len,
+                                             size_t identifier_len,
                                              size_t index) {
   size_t look;
-  size_t expression_len = strlen(expression);
-  size_t identifier_len = strlen(identifier);
 
   // If the first non-space character before is not in [\[(,\+=]: no.
   look = index - 1;
@@ -634,6 +880,181 @@ static int osl_util_lazy_isolated_identifier(const char* expression,
   return 1;
 }
 
+/**
+ * osl_util_substitution_generate function:
+ * this function prepares the substitution of a list of identifiers, see
+ * osl_util_substitution_t. The identifiers are not copied: they must not
+ * be modified nor freed while the substitution is used.
+ * \param[in] identifiers NULL-terminated array of identifiers.
+ * \return A newly allocated substitution.
+ */
+osl_util_substitution_t* osl_util_substitution_generate(char** identifiers) {
+  osl_util_substitution_p substitution;
+  int j, n = 0, regular;
+  size_t k, i, nb_slots = 16;
+
+  while ((identifiers != NULL) && (identifiers[n] != NULL))
+    n++;
+  while (nb_slots < 2 * (size_t)n)
+    nb_slots *= 2;
+
+  OSL_malloc(substitution, osl_util_substitution_p,
+             sizeof(osl_util_substitution_t));
+  substitution->nb_identifiers = n;
+  substitution->identifiers = identifiers;
+  OSL_malloc(substitution->length, size_t*, ((size_t)n + 1) * sizeof(size_t));
+  OSL_malloc(substitution->irregular, int*, ((size_t)n + 1) * sizeof(int));
+  substitution->nb_irregular = 0;
+  substitution->nb_slots = nb_slots;
+  OSL_malloc(substitution->slot, int*, nb_slots * sizeof(int));
+  for (k = 0; k < nb_slots; k++)
+    substitution->slot[k] = 0;
+
+  for (j = 0; j < n; j++) {
+    substitution->length[j] = strlen(identifiers[j]);
+    regular = 1;
+    for (i = 0; i < substitution->length[j]; i++)
+      if (!osl_util_is_identifier_char(identifiers[j][i]))
+        regular = 0;
+
+    if (substitution->length[j] == 0) {
+      // An empty identifier never matches.
+      continue;
+    } else if (!regular) {
+      substitution->irregular[substitution->nb_irregular++] = j;
+      continue;
+    }
+
+    // Linear probing, a duplicate keeps the rank of its first occurrence.
+    k = (size_t)osl_util_hash_token(identifiers[j], substitution->length[j]) &
+        (nb_slots - 1);
+    while ((substitution->slot[k] != 0) &&
+           strcmp(identifiers[substitution->slot[k] - 1], identifiers[j]))
+      k = (k + 1) & (nb_slots - 1);
+    if (substitution->slot[k] == 0)
+      substitution->slot[k] = j + 1;
+  }
+
+  return substitution;
+}
+
+/**
+ * osl_util_substitution_free function:
+ * this function frees the allocated memory for an osl_util_substitution_t
+ * structure. The identifiers are not freed.
+ * \param[in,out] substitution The pointer to the substitution to free.
+ */
+void osl_util_substitution_free(osl_util_substitution_t* substitution) {
+  if (substitution == NULL)
+    return;
+
+  OSL_free(substitution->length);
+  OSL_free(substitution->irregular);
+  OSL_free(substitution->slot);
+  OSL_free(substitution);
+}
+
+/**
+ * osl_util_substitution_apply function:
+ * this function replaces the identifiers of a substitution in an input
+ * expression string and returns the final string, as
+ * osl_util_identifier_substitution() does. The expression is scanned once:
+ * the identifier that may start at each token is found by hashing.
+ * Optionally, the position in the result of each position in the
+ * expression is stored in map, an array of strlen(expression) + 1 elements
+ * (positions inside a replaced identifier are mapped to its replacement).
+ * \param[in]  substitution The substitution to apply.
+ * \param[in]  expression   The original expression.
+ * \param[out] map          Array where to store the positions, or NULL.
+ * \return A new string where the ith identifier is replaced by \@i\@.
+ */
+char* osl_util_substitution_apply(const osl_util_substitution_t* substitution,
+                                  const char* expression, size_t* map) {
+  size_t index, end, k, length = strlen(expression);
+  size_t size = 0, nb_copied, high_water_mark = length + 1;
+  int j, r, rank;
+  char buffer[OSL_MAX_STRING];
+  const char* copy;
+  char* string;
+
+  OSL_malloc(string, char*, high_water_mark * sizeof(char));
+
+  index = 0;
+  while (index < length) {
+    // The end of the token starting here, if any.
+    end = index;
+    while ((end < length) && osl_util_is_identifier_char(expression[end]))
+      end++;
+
+    // Identifiers only start where the previous character cannot be part of
+    // one: the first identifier equal to the token (if it is one), unless
+    // an irregular identifier with a lower rank is here.
+    rank = -1;
+    if ((index == 0) || !osl_util_is_identifier_char(expression[index - 1])) {
+      if (end > index) {
+        k = (size_t)osl_util_hash_token(expression + index, end - index) &
+            (substitution->nb_slots - 1);
+        for (; substitution->slot[k] != 0;
+             k = (k + 1) & (substitution->nb_slots - 1)) {
+          j = substitution->slot[k] - 1;
+          if ((substitution->length[j] == end - index) &&
+              !strncmp(expression + index, substitution->identifiers[j],
+                       end - index)) {
+            rank = j;
+            break;
+          }
+        }
+      }
+      for (r = 0; r < substitution->nb_irregular; r++) {
+        j = substitution->irregular[r];
+        if ((rank >= 0) && (j > rank))
+          break;
+        if (osl_util_identifier_is_here(expression, length,
+                                        substitution->identifiers[j],
+                                        substitution->length[j], index)) {
+          rank = j;
+          break;
+        }
+      }
+    }
+
+    // The replacement, or the token (or character) as it is.
+    if (rank >= 0) {
+      if (osl_util_lazy_isolated_identifier(
+              expression, length, substitution->length[rank], index))
+        sprintf(buffer, "@%d@", rank);
+      else
+        sprintf(buffer, "(@%d@)", rank);
+      end = index + substitution->length[rank];
+      copy = buffer;
+      nb_copied = strlen(buffer);
+    } else {
+      if (end == index)
+        end++;
+      copy = expression + index;
+      nb_copied = end - index;
+    }
+    if (size + nb_copied >= high_water_mark) {
+      while (size + nb_copied >= high_water_mark)
+        high_water_mark *= 2;
+      OSL_realloc(string, char*, high_water_mark * sizeof(char));
+    }
+    memcpy(string + size, copy, nb_copied);
+
+    if (map != NULL) {
+      for (k = index; k < end; k++)
+        map[k] = (rank >= 0) ? size : size + (k - index);
+    }
+    size += nb_copied;
+    index = end;
+  }
+  string[size] = '\0';
+  if (map != NULL)
+    map[length] = size;
+
+  return string;
+}
+
 /**
  * osl_util_identifier_substitution function:
  * this function replaces some identifiers in an input expression string and
@@ -644,46 +1065,259 @@ static int osl_util_lazy_isolated_identifier(const char* expression,
  * the identifier can be replaced with an arbitrary expression without the
  * need of parentheses. For instance, let us consider the input expression
  * "C[i+j]+=A[2*i]*B[j];" and the array of strings {"i", "j"}: the resulting
- * string would be "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];".
+ * string would be "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];". To substitute the same
+ * identifiers in several expressions, see osl_util_substitution_generate().
  * \param[in] expression The original expression.
  * \param[in] identifiers NULL-terminated array of identifiers.
  * \return A new string where the ith identifier is replaced by \@i\@.
  */
 char* osl_util_identifier_substitution(const char* expression,
                                        char** identifiers) {
-  size_t index;
-  int j, found;
-  size_t high_water_mark = OSL_MAX_STRING;
-  char buffer[OSL_MAX_STRING];
+  osl_util_substitution_p substitution;
   char* string;
 
-  OSL_malloc(string, char*, high_water_mark * sizeof(char));
-  string[0] = '\0';
+  substitution = osl_util_substitution_generate(identifiers);
+  string = osl_util_substitution_apply(substitution, expression, NULL);
+  osl_util_substitution_free(substitution);
 
-  index = 0;
-  while (index < strlen(expression)) {
-    j = 0;
-    found = 0;
-    while (identifiers[j] != NULL) {
-      if (osl_util_identifier_is_here(expression, identifiers[j], index)) {
-        if (osl_util_lazy_isolated_identifier(expression, identifiers[j],
-                                              index))
-          sprintf(buffer, "@%d@", j);
-        else
-          sprintf(buffer, "(@%d@)", j);
-        osl_util_safe_strcat(&string, buffer, &high_water_mark);
-        index += strlen(identifiers[j]);
-        found = 1;
-        break;
-      }
-      j++;
+  return string;
+}
+
+/**
+ * osl_util_hash_combine function:
+ * this function mixes a 64-bit value into a running hash and returns the
+ * updated hash. The mixing is order-dependent (combining a then b differs
+ * from combining b then a) and only depends on the numeric values, hence
+ * hashes built with it are stable across runs and platforms.
+ * \param[in] hash  The running hash (0 to start a new hash).
+ * \param[in] value The value to mix into the hash.
+ * \return The updated hash.
+ */
+uint64_t osl_util_hash_combine(uint64_t hash, uint64_t value) {
+  uint64_t x = hash ^ (value + UINT64_C(0x9e3779b97f4a7c15) + (hash << 6) +
+                       (hash >> 2));
+
+  // SplitMix64 finalizer.
+  x ^= x >> 30;
+  x *= UINT64_C(0xbf58476d1ce4e5b9);
+  x ^= x >> 27;
+  x *= UINT64_C(0x94d049bb133111eb);
+  x ^= x >> 31;
+  return x;
+}
+
+/**
+ * osl_util_hash_string function:
+ * this function mixes a string (possibly NULL) into a running hash and
+ * returns the updated hash. A NULL string and an empty string hash
+ * differently.
+ * \param[in] hash   The running hash (0 to start a new hash).
+ * \param[in] string The string to mix into the hash (possibly NULL).
+ * \return The updated hash.
+ */
+uint64_t osl_util_hash_string(uint64_t hash, const char* string) {
+  uint64_t fnv = UINT64_C(0xcbf29ce484222325);
+
+  if (string == NULL)
+    return osl_util_hash_combine(hash, 0);
+
+  // FNV-1a over the bytes, then mixed into the running hash.
+  for (; *string != '\0'; string++) {
+    fnv ^= (unsigned char)*string;
+    fnv *= UINT64_C(0x100000001b3);
+  }
+  return osl_util_hash_combine(hash, fnv);
+}
+
+#ifdef OSL_THREADS_ARE_HERE
+/**
+ * osl_util_pool_run internal function:
+ * this function runs iterations of the current loop of the worker pool
+ * until there is none left.
+ */
+void osl_util_pool_run(void) {
+  int i;
+
+  while ((i = atomic_fetch_add(&osl_util_pool.next, 1)) < osl_util_pool.n)
+    osl_util_pool.body(osl_util_pool.data, i);
+}
+
+/**
+ * osl_util_pool_work internal function:
+ * this function is the main function of the worker threads: it waits for
+ * the loops of the worker pool and takes part in them until the pool
+ * stops.
+ * \param[in] arg The loop generation when the worker was started.
+ * \return NULL.
+ */
+void* osl_util_pool_work(void* arg) {
+  unsigned generation = (unsigned)(uintptr_t)arg;
+
+  osl_util_pool_member = 1;
+  pthread_mutex_lock(&osl_util_pool.lock);
+  for (;;) {
+    while (!osl_util_pool.stop && (osl_util_pool.generation == generation))
+      pthread_cond_wait(&osl_util_pool.start, &osl_util_pool.lock);
+    if (osl_util_pool.stop)
+      break;
+    generation = osl_util_pool.generation;
+    pthread_mutex_unlock(&osl_util_pool.lock);
+
+    osl_util_pool_run();
+
+    pthread_mutex_lock(&osl_util_pool.lock);
+    if (--osl_util_pool.nb_active == 0)
+      pthread_cond_signal(&osl_util_pool.done);
+  }
+  pthread_mutex_unlock(&osl_util_pool.lock);
+
+  return NULL;
+}
+
+/**
+ * osl_util_pool_resize internal function:
+ * this function stops the worker threads of the worker pool, then starts
+ * nb_workers new ones (fewer if the system refuses to create them). It is
+ * called with the pool lock held and the pool marked busy.
+ * \param[in] nb_workers The number of worker threads to start.
+ */
+void osl_util_pool_resize(int nb_workers) {
+  int i;
+
+  if (osl_util_pool.nb_workers > 0) {
+    osl_util_pool.stop = 1;
+    pthread_cond_broadcast(&osl_util_pool.start);
+    pthread_mutex_unlock(&osl_util_pool.lock);
+    for (i = 0; i < osl_util_pool.nb_workers; i++)
+      pthread_join(osl_util_pool.worker[i], NULL);
+    pthread_mutex_lock(&osl_util_pool.lock);
+    osl_util_pool.stop = 0;
+    osl_util_pool.nb_workers = 0;
+  }
+  free(osl_util_pool.worker);
+  osl_util_pool.worker = NULL;
+  if (nb_workers == 0)
+    return;
+
+  // The pool is not allocated with OSL_malloc: it may outlive any arena.
+  osl_util_pool.worker = malloc((size_t)nb_workers * sizeof(pthread_t));
+  if (osl_util_pool.worker == NULL)
+    return;
+  for (i = 0; i < nb_workers; i++) {
+    if (pthread_create(&osl_util_pool.worker[i], NULL, osl_util_pool_work,
+                       (void*)(uintptr_t)osl_util_pool.generation) != 0)
+      break;
+    osl_util_pool.nb_workers++;
+  }
+}
+#endif
+
+/**
+ * osl_util_set_nb_threads function:
+ * this function sets the number of threads the library may use for its
+ * parallel operations (see osl_util_parallel_for()), the calling thread
+ * included. The default is 1, i.e., the library does not start any thread.
+ * Otherwise, a pool of nb_threads - 1 worker threads is started on the
+ * first parallel operation and reused by the next ones; setting 1 again
+ * stops it. The setting has no effect when the library is built without
+ * thread support (see osl_util_is_parallel_supported()). It has to be set
+ * while no other thread is using the library.
+ * \param[in] nb_threads The number of threads (at least 1).
+ */
+void osl_util_set_nb_threads(int nb_threads) {
+  if (nb_threads < 1)
+    OSL_error("the number of threads must be at least 1");
+
+  osl_util_nb_threads = nb_threads;
+
+#ifdef OSL_THREADS_ARE_HERE
+  pthread_mutex_lock(&osl_util_pool.lock);
+  if (!osl_util_pool.busy && (osl_util_pool.nb_workers > nb_threads - 1)) {
+    osl_util_pool.busy = 1;
+    osl_util_pool_resize(0);
+    osl_util_pool.busy = 0;
+  }
+  pthread_mutex_unlock(&osl_util_pool.lock);
+#endif
+}
+
+/**
+ * osl_util_get_nb_threads function:
+ * this function returns the number of threads the library may use for its
+ * parallel operations, see osl_util_set_nb_threads().
+ * \return The number of threads.
+ */
+int osl_util_get_nb_threads(void) {
+  return osl_util_nb_threads;
+}
+
+/**
+ * osl_util_is_parallel_supported function:
+ * this function returns 1 if the library is built with its worker pool
+ * (pthreads), i.e., if osl_util_parallel_for() may run iterations in
+ * parallel, and 0 otherwise.
+ * \return 1 if parallel operations are supported, 0 otherwise.
+ */
+int osl_util_is_parallel_supported(void) {
+#ifdef OSL_THREADS_ARE_HERE
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * osl_util_parallel_for function:
+ * this function calls body(data, i) for every i from 0 to n - 1. The calls
+ * are distributed over the calling thread and the worker pool (see
+ * osl_util_set_nb_threads()), hence they must be independent. They are
+ * done in order by the calling thread when a single thread is set, when
+ * the library is built without thread support, from a worker thread
+ * (nested loops) and while another thread runs a loop on the pool.
+ * \param[in] n    The number of iterations.
+ * \param[in] body The function to call for each iteration.
+ * \param[in] data User data given to each call.
+ */
+void osl_util_parallel_for(int n, osl_util_loop_f body, void* data) {
+  int i;
+
+#ifdef OSL_THREADS_ARE_HERE
+  int nb_workers = osl_util_nb_threads - 1;
+
+  if ((n > 1) && (nb_workers > 0) && !osl_util_pool_member) {
+    pthread_mutex_lock(&osl_util_pool.lock);
+    if (!osl_util_pool.busy) {
+      osl_util_pool.busy = 1;
+      if (osl_util_pool.nb_workers != nb_workers)
+        osl_util_pool_resize(nb_workers);
+    } else {
+      nb_workers = 0;
     }
-    if (!found) {
-      sprintf(buffer, "%c", expression[index]);
-      osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      index++;
+    if ((nb_workers > 0) && (osl_util_pool.nb_workers > 0)) {
+      osl_util_pool.body = body;
+      osl_util_pool.data = data;
+      osl_util_pool.n = n;
+      atomic_store(&osl_util_pool.next, 0);
+      osl_util_pool.nb_active = osl_util_pool.nb_workers;
+      osl_util_pool.generation++;
+      pthread_cond_broadcast(&osl_util_pool.start);
+      pthread_mutex_unlock(&osl_util_pool.lock);
+
+      osl_util_pool_run();
+
+      pthread_mutex_lock(&osl_util_pool.lock);
+      while (osl_util_pool.nb_active > 0)
+        pthread_cond_wait(&osl_util_pool.done, &osl_util_pool.lock);
+      osl_util_pool.busy = 0;
+      pthread_mutex_unlock(&osl_util_pool.lock);
+      return;
     }
+    if (nb_workers > 0)
+      osl_util_pool.busy = 0;
+    pthread_mutex_unlock(&osl_util_pool.lock);
   }
+#endif
 
-  return string;
+  for (i = 0; i < n; i++)
+    body(data, i);
 }
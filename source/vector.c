@@ -190,9 +190,9 @@ void osl_vector_free(osl_vector_p vector) {
       for (i = 0; i < vector->size; i++)
         osl_int_clear(vector->precision, &vector->v[i]);
 
-      free(vector->v);
+      OSL_free(vector->v);
     }
-    free(vector);
+    OSL_free(vector);
   }
 }
 
@@ -0,0 +1,214 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                            osl_access_index.c                            **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+// S1: A[i] = B[i]; S2: A[i] += A[i] (may write), C[i] = 0; S3: read A[i].
+static const char* const test_scop =
+    "<OpenScop>\n"
+    "C\n"
+    "CONTEXT\n"
+    "0 3 0 0 0 1\n"
+    "1\n"
+    "<strings>\n"
+    "N\n"
+    "</strings>\n"
+    "3\n"
+    "3\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "   1    1    0    0\n"
+    "   1   -1    1   -1\n"
+    "WRITE\n"
+    "2 6 2 1 0 1\n"
+    "   0   -1    0    0    0    1\n"
+    "   0    0   -1    1    0    0\n"
+    "READ\n"
+    "2 6 2 1 0 1\n"
+    "   0   -1    0    0    0    2\n"
+    "   0    0   -1    1    0    0\n"
+    "0\n"
+    "4\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "   1    1    0    0\n"
+    "   1   -1    1   -1\n"
+    "READ\n"
+    "2 6 2 1 0 1\n"
+    "   0   -1    0    0    0    1\n"
+    "   0    0   -1    1    0    0\n"
+    "MAY_WRITE\n"
+    "2 6 2 1 0 1\n"
+    "   0   -1    0    0    0    1\n"
+    "   0    0   -1    1    0    0\n"
+    "WRITE\n"
+    "2 6 2 1 0 1\n"
+    "   0   -2    0    0    0    6\n"
+    "   0    0   -1    1    0    0\n"
+    "0\n"
+    "2\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "   1    1    0    0\n"
+    "   1   -1    1   -1\n"
+    "READ\n"
+    "2 6 2 1 0 1\n"
+    "   0   -1    0    0    0    1\n"
+    "   0    0   -1    1    0    0\n"
+    "0\n"
+    "</OpenScop>\n";
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  FILE* file;
+  osl_int_t value;
+  osl_relation_p access, clone;
+  osl_scop_p scop;
+  osl_access_index_p index;
+  const osl_access_ref_t* refs;
+
+  file = tmpfile();
+  fputs(test_scop, file);
+  rewind(file);
+  scop = osl_scop_read(file);
+  fclose(file);
+
+  // Array identifiers are cached on request, and dropped on modification.
+  access = scop->statement->next->access->next->next->elt;
+  nb_fail += (access->array_id == 0) ? 0 : 1;
+  nb_fail += (osl_relation_get_array_id(access) == 3) ? 0 : 1;
+  osl_relation_cache_array_id(access);
+  nb_fail += (access->array_id == 3) ? 0 : 1;
+  clone = osl_relation_clone(access);
+  nb_fail += (clone->array_id == 3) ? 0 : 1;
+  osl_relation_to_sparse(clone);
+  nb_fail += (clone->array_id == 0) ? 0 : 1;
+  nb_fail += (osl_relation_get_array_id(clone) == 3) ? 0 : 1;
+  osl_relation_cache_array_id(clone);
+  nb_fail += (clone->array_id == 3) ? 0 : 1;
+  osl_relation_to_dense(clone);
+  osl_int_init_set_si(clone->precision, &value, 4);
+  osl_relation_set_value(clone, 0, 5, value);
+  osl_int_clear(clone->precision, &value);
+  nb_fail += (clone->array_id == 0) ? 0 : 1;
+  nb_fail += (osl_relation_get_array_id(clone) == 2) ? 0 : 1;
+  osl_relation_free(clone);
+
+  // Writing in the matrix directly goes through osl_relation_unshare(),
+  // which resets the cache, so renumbered identifiers are not missed.
+  osl_relation_unshare(access);
+  nb_fail += (access->array_id == 0) ? 0 : 1;
+  osl_int_set_si(access->precision, &access->m[0][access->nb_columns - 1], 14);
+  nb_fail += (osl_relation_get_array_id(access) == 7) ? 0 : 1;
+  osl_relation_unshare(access);
+  osl_int_set_si(access->precision, &access->m[0][access->nb_columns - 1], 6);
+  printf("cache: nb fail = %d\n", nb_fail);
+
+  // Inverted index.
+  index = osl_access_index_generate(scop);
+  nb_fail += (index->nb_refs == 6) ? 0 : 1;
+  nb_fail += (index->nb_unindexed == 0) ? 0 : 1;
+  nb_fail += (index->max_array_id == 3) ? 0 : 1;
+  nb_fail += (osl_access_index_lookup(index, 1, OSL_UNDEFINED, NULL) == 4)
+                 ? 0
+                 : 1;
+  nb_fail += (osl_access_index_lookup(index, 1, OSL_TYPE_READ, &refs) == 2)
+                 ? 0
+                 : 1;
+  nb_fail += (refs[0].label == 1) && (refs[1].label == 2) ? 0 : 1;
+  nb_fail += (refs[1].statement == scop->statement->next->next) ? 0 : 1;
+  nb_fail += (osl_access_index_writers(index, 1, &refs) == 2) ? 0 : 1;
+  nb_fail += (refs[0].access->type == OSL_TYPE_WRITE) ? 0 : 1;
+  nb_fail += (refs[0].label == 0) ? 0 : 1;
+  nb_fail += (refs[1].access->type == OSL_TYPE_MAY_WRITE) ? 0 : 1;
+  nb_fail += (refs[1].label == 1) ? 0 : 1;
+  nb_fail += (osl_access_index_writers(index, 2, &refs) == 0) ? 0 : 1;
+  nb_fail += (refs == NULL) ? 0 : 1;
+  nb_fail += (osl_access_index_writers(index, 3, &refs) == 1) ? 0 : 1;
+  nb_fail += (refs[0].access == access) ? 0 : 1;
+  nb_fail += (osl_access_index_lookup(index, 4, OSL_TYPE_READ, &refs) == 0)
+                 ? 0
+                 : 1;
+  nb_fail += (refs == NULL) ? 0 : 1;
+  osl_access_index_dump(stdout, index);
+  osl_access_index_free(index);
+
+  // Empty scops give empty indexes.
+  index = osl_access_index_generate(NULL);
+  nb_fail += (index->nb_refs == 0) ? 0 : 1;
+  nb_fail += (osl_access_index_writers(index, 1, NULL) == 0) ? 0 : 1;
+  osl_access_index_free(index);
+  printf("index: nb fail = %d\n", nb_fail);
+
+  osl_scop_free(scop);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
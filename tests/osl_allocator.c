@@ -0,0 +1,131 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                             osl_allocator.c                              **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+// Counting allocator: user data is the number of live blocks.
+static void* test_malloc(size_t size, void* user) {
+  (*(long*)user)++;
+  return malloc(size);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user) {
+  if (ptr == NULL)
+    (*(long*)user)++;
+  return realloc(ptr, size);
+}
+
+static void test_free(void* ptr, void* user) {
+  (*(long*)user)--;
+  free(ptr);
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  long live = 0;
+  char string[] =
+      "DOMAIN\n"
+      "4 5 2 0 0 1\n"
+      "   1    1    0    0    0\n"
+      "   1   -1    0    1   -1\n"
+      "   1    0    1    0    0\n"
+      "   1    0   -1    1   -1\n";
+  char* input = string;
+  char* output;
+  osl_relation_p relation, clone;
+  osl_arena_p arena;
+
+  osl_set_allocator(test_malloc, test_realloc, test_free, &live);
+
+  relation = osl_relation_sread(&input);
+  clone = osl_relation_clone(relation);
+  nb_fail += (live > 0) ? 0 : 1;
+  nb_fail += osl_relation_equal(relation, clone) ? 0 : 1;
+  output = osl_relation_sprint(clone);
+  nb_fail += (strstr(output, "DOMAIN") != NULL) ? 0 : 1;
+  OSL_free(output);
+  osl_relation_free(clone);
+  osl_relation_free(relation);
+  nb_fail += (live == 0) ? 0 : 1;
+  printf("heap: nb fail = %d\n", nb_fail);
+
+  // Arena chunks come from the hooks as well.
+  arena = osl_arena_malloc();
+  osl_arena_alloc(arena, 16);
+  nb_fail += (live == 3) ? 0 : 1;
+  osl_arena_free(arena);
+  nb_fail += (live == 0) ? 0 : 1;
+  printf("arena: nb fail = %d\n", nb_fail);
+
+  osl_set_allocator(NULL, NULL, NULL, NULL);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
@@ -0,0 +1,189 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               osl_arena.c                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+static const char* const test_scop =
+    "<OpenScop>\n"
+    "C\n"
+    "CONTEXT\n"
+    "1 3 0 0 0 1\n"
+    "   1    1   -1\n"
+    "1\n"
+    "<strings>\n"
+    "N\n"
+    "</strings>\n"
+    "1\n"
+    "3\n"
+    "DOMAIN\n"
+    "4 5 2 0 0 1\n"
+    "   1    1    0    0    0\n"
+    "   1   -1    0    1   -1\n"
+    "   1    0    1    0    0\n"
+    "   1    0   -1    1   -1\n"
+    "SCATTERING\n"
+    "5 10 5 2 0 1\n"
+    "   0   -1    0    0    0    0    0    0    0    0\n"
+    "   0    0   -1    0    0    0    1    0    0    0\n"
+    "   0    0    0   -1    0    0    0    0    0    0\n"
+    "   0    0    0    0   -1    0    0    1    0    0\n"
+    "   0    0    0    0    0   -1    0    0    0    0\n"
+    "WRITE\n"
+    "3 8 3 2 0 1\n"
+    "   0   -1    0    0    0    0    0    1\n"
+    "   0    0   -1    0    1    0    0    0\n"
+    "   0    0    0   -1    0    1    0    0\n"
+    "1\n"
+    "<body>\n"
+    "2\n"
+    "i j\n"
+    "C[i][j] = 0.0;\n"
+    "</body>\n"
+    "<arrays>\n"
+    "1\n"
+    "1 C\n"
+    "</arrays>\n"
+    "</OpenScop>\n";
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  FILE* file;
+  osl_arena_p arena, previous;
+  osl_scop_p heap_scop, arena_scop, arena_clone;
+  char* block;
+  size_t i;
+
+  // Raw allocations: alignment, growth, in place and moving realloc.
+  nb_fail += (osl_arena_nb_live == 0) ? 0 : 1;
+  arena = osl_arena_malloc();
+  nb_fail += (osl_arena_nb_live == 1) ? 0 : 1;
+  block = osl_arena_alloc(arena, 10);
+  strcpy(block, "openscop");
+  nb_fail += ((size_t)block % OSL_ARENA_ALIGNMENT == 0) ? 0 : 1;
+  block = osl_arena_realloc(arena, block, 100);
+  nb_fail += (strcmp(block, "openscop") == 0) ? 0 : 1;
+  nb_fail += (osl_arena_lookup(block) == arena) ? 0 : 1;
+  osl_arena_alloc(arena, 1);
+  block = osl_arena_realloc(arena, block, 4 * OSL_ARENA_CHUNK_SIZE);
+  nb_fail += (strcmp(block, "openscop") == 0) ? 0 : 1;
+  nb_fail += (arena->nb_chunks == 2) ? 0 : 1;
+  nb_fail += osl_arena_owns(arena, &nb_fail) ? 1 : 0;
+  printf("raw allocations: nb fail = %d\n", nb_fail);
+
+  // The allocation macros follow the current arena.
+  previous = osl_arena_set_current(arena);
+  OSL_malloc(block, char*, 16);
+  nb_fail += osl_arena_owns(arena, block) ? 0 : 1;
+  osl_arena_set_current(previous);
+  OSL_realloc(block, char*, 32);
+  nb_fail += osl_arena_owns(arena, block) ? 0 : 1;
+  OSL_free(block);
+  OSL_malloc(block, char*, 16);
+  nb_fail += osl_arena_owns(arena, block) ? 1 : 0;
+  OSL_free(block);
+  osl_arena_free(arena);
+  nb_fail += (osl_arena_get_current() == NULL) ? 0 : 1;
+  nb_fail += (osl_arena_nb_live == 0) ? 0 : 1;
+  printf("allocation macros: nb fail = %d\n", nb_fail);
+
+  // Reading and cloning a scop in an arena.
+  file = tmpfile();
+  fputs(test_scop, file);
+  rewind(file);
+  heap_scop = osl_scop_read(file);
+  rewind(file);
+  arena = osl_arena_malloc();
+  arena_scop = osl_scop_read_arena(file, arena);
+  fclose(file);
+  nb_fail += osl_scop_equal(heap_scop, arena_scop) ? 0 : 1;
+  nb_fail += osl_arena_owns(arena, arena_scop) ? 0 : 1;
+  nb_fail += osl_arena_owns(arena, arena_scop->statement->domain->m[0]) ? 0 : 1;
+  nb_fail += osl_arena_owns(arena, heap_scop) ? 1 : 0;
+
+  arena_clone = osl_scop_clone_arena(heap_scop, arena);
+  nb_fail += osl_scop_equal(heap_scop, arena_clone) ? 0 : 1;
+  nb_fail += osl_arena_owns(arena, arena_clone) ? 0 : 1;
+
+  // Heap objects attached to an arena scop are released by osl_scop_free.
+  osl_relation_free(arena_clone->context);
+  arena_clone->context = osl_relation_clone(heap_scop->context);
+  osl_scop_free(arena_clone);
+  for (i = 0; i < 1000; i++)
+    osl_arena_alloc(arena, 64);
+  printf("arena scop: nb fail = %d\n", nb_fail);
+
+  // GMP limbs are not arena blocks: release them before the arena.
+  osl_scop_free(arena_scop);
+  osl_arena_free(arena);
+  osl_scop_free(heap_scop);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
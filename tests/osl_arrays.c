@@ -0,0 +1,183 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               osl_arrays.c                               **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+// Check the index lookups against the linear scan of the names.
+static int test_lookups(const osl_arrays_t* arrays) {
+  int i, nb_fail = 0;
+  size_t expected;
+  char name[32];
+
+  for (i = 0; i < arrays->nb_names + 2; i++) {
+    sprintf(name, "A%d", i);
+    for (expected = 0; expected < (size_t)arrays->nb_names; expected++)
+      if (!strcmp(arrays->names[expected], name))
+        break;
+    nb_fail +=
+        (osl_arrays_get_index_from_name(arrays, name) == expected) ? 0 : 1;
+    for (expected = 0; expected < (size_t)arrays->nb_names; expected++)
+      if (arrays->id[expected] == i)
+        break;
+    nb_fail += (osl_arrays_get_index_from_id(arrays, i) == expected) ? 0 : 1;
+  }
+
+  return nb_fail;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  int i;
+  char name[32];
+  char* input;
+  char* string;
+  osl_arrays_p arrays, clone, read;
+
+  // Structures are indexed by the first lookup.
+  arrays = osl_arrays_malloc();
+  nb_fail += (osl_arrays_get_index_from_id(arrays, 1) == 0) ? 0 : 1;
+  for (i = 1; i < 16; i++) {
+    sprintf(name, "A%d", i);
+    osl_arrays_add(arrays, i, name);
+  }
+  nb_fail += (arrays->nb_indexed == arrays->nb_names) ? 0 : 1;
+  osl_arrays_free(arrays);
+  arrays = osl_arrays_malloc();
+  for (i = 1; i < 16; i++) {
+    sprintf(name, "A%d", i);
+    osl_arrays_add(arrays, i, name);
+  }
+  nb_fail += (arrays->nb_indexed == 0) ? 0 : 1;
+  nb_fail += test_lookups(arrays);
+  nb_fail += (arrays->nb_indexed == arrays->nb_names) ? 0 : 1;
+  nb_fail += test_lookups(arrays);
+  printf("small: nb fail = %d\n", nb_fail);
+
+  // Indexes follow additions, duplicates give the first index.
+  for (i = 16; i <= 1000; i++) {
+    sprintf(name, "A%d", i % 700);
+    osl_arrays_add(arrays, i, name);
+  }
+  osl_arrays_add(arrays, 3, "B");
+  nb_fail += (arrays->nb_indexed == arrays->nb_names) ? 0 : 1;
+  nb_fail += (arrays->size >= arrays->nb_names) ? 0 : 1;
+  nb_fail += (arrays->size <= 2 * arrays->nb_names) ? 0 : 1;
+  nb_fail += test_lookups(arrays);
+  nb_fail += (osl_arrays_get_index_from_id(arrays, 3) == 2) ? 0 : 1;
+  nb_fail += (osl_arrays_get_index_from_name(arrays, "B") == 1000) ? 0 : 1;
+  printf("large: nb fail = %d\n", nb_fail);
+
+  // Clones of indexed structures are indexed, read structures are not yet.
+  clone = osl_arrays_clone(arrays);
+  nb_fail += (clone->nb_indexed == clone->nb_names) ? 0 : 1;
+  nb_fail += osl_arrays_equal(clone, arrays) ? 0 : 1;
+  nb_fail += test_lookups(clone);
+  osl_arrays_free(clone);
+  string = osl_arrays_sprint(arrays);
+  input = string;
+  read = osl_arrays_sread(&input);
+  OSL_free(string);
+  nb_fail += (read->nb_indexed == 0) ? 0 : 1;
+  nb_fail += osl_arrays_equal(read, arrays) ? 0 : 1;
+  nb_fail += test_lookups(read);
+  nb_fail += (read->nb_indexed == read->nb_names) ? 0 : 1;
+  printf("clone/read: nb fail = %d\n", nb_fail);
+
+  // Direct modifications are taken into account after reindexing, and keys
+  // missing from up to date maps are not found.
+  nb_fail += (osl_arrays_get_index_from_id(arrays, 2000) ==
+              (size_t)arrays->nb_names)
+                 ? 0
+                 : 1;
+  nb_fail += (osl_arrays_get_index_from_name(arrays, "Z") ==
+              (size_t)arrays->nb_names)
+                 ? 0
+                 : 1;
+  arrays->id[5] = 2000;
+  OSL_free(arrays->names[5]);
+  OSL_strdup(arrays->names[5], "Z");
+  osl_arrays_index_build(arrays);
+  nb_fail += (osl_arrays_get_index_from_id(arrays, 2000) == 5) ? 0 : 1;
+  nb_fail += (osl_arrays_get_index_from_name(arrays, "Z") == 5) ? 0 : 1;
+  nb_fail += test_lookups(arrays);
+  read->id[0] = 2000;
+  osl_arrays_index_build(read);
+  nb_fail += (osl_arrays_get_index_from_id(read, 2000) == 0) ? 0 : 1;
+  nb_fail += test_lookups(read);
+  read->nb_names--;
+  nb_fail += test_lookups(read);
+  read->nb_names++;
+  osl_arrays_free(read);
+  osl_arrays_free(arrays);
+  printf("modifications: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
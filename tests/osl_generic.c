@@ -0,0 +1,218 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              osl_generic.c                               **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+static const char* const uris[] = {OSL_URI_COMMENT, OSL_URI_ARRAYS,
+                                   OSL_URI_COORDINATES, OSL_URI_STRINGS,
+                                   OSL_URI_BODY};
+
+// Returns a generic with the frozen interface of a given URI.
+static osl_generic_p test_generic(const char* URI) {
+  osl_interface_p interface;
+
+  interface = osl_interface_lookup(osl_interface_get_frozen_registry(), URI);
+  interface = osl_interface_nclone(interface, 1);
+  return osl_generic_shell(interface->malloc(), interface);
+}
+
+// Returns the data of the generic of a given URI, without the list index.
+static void* test_lookup(const osl_generic_t* list, const char* URI) {
+  for (; list != NULL; list = list->next)
+    if (!strcmp(list->interface->URI, URI))
+      return list->data;
+  return NULL;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int i, j, nb_fail = 0;
+  char copy[64];
+  const char* atom;
+  osl_generic_p generic;
+  osl_generic_index_p index;
+  osl_scop_p scop = osl_scop_malloc();
+  osl_statement_p statement = osl_statement_malloc();
+
+  // Atoms are the URIs of the frozen registry.
+  for (i = 0; i < 5; i++) {
+    strcpy(copy, uris[i]);
+    atom = osl_interface_atom(copy);
+    nb_fail += ((atom != NULL) && (atom != copy) && !strcmp(atom, uris[i]))
+                   ? 0
+                   : 1;
+    nb_fail += (osl_interface_atom(atom) == atom) ? 0 : 1;
+    generic = test_generic(copy);
+    nb_fail += (generic->interface->URI == atom) ? 0 : 1;
+    nb_fail += osl_generic_has_URI(generic, atom) ? 0 : 1;
+    nb_fail += osl_generic_has_URI(generic, copy) ? 0 : 1;
+    osl_generic_free(generic);
+  }
+  nb_fail += (osl_interface_atom("unknown") == NULL) ? 0 : 1;
+  nb_fail += (osl_interface_atom(NULL) == NULL) ? 0 : 1;
+  printf("atoms: nb fail = %d\n", nb_fail);
+
+  // Atoms which differ are unequal, while an equal string still matches.
+  generic = test_generic(OSL_URI_ARRAYS);
+  nb_fail += osl_interface_is_atom(generic->interface->URI) ? 0 : 1;
+  nb_fail += osl_interface_is_atom(uris[1]) ? 1 : 0;
+  nb_fail += osl_generic_has_URI(generic, osl_interface_atom(OSL_URI_BODY))
+                 ? 1
+                 : 0;
+  nb_fail += osl_generic_has_URI(generic, uris[1]) ? 0 : 1;
+  nb_fail += osl_generic_has_URI(generic, NULL) ? 1 : 0;
+  osl_generic_free(generic);
+  printf("atom compare: nb fail = %d\n", nb_fail);
+
+  // The index of the extensions of a scop follows additions and removals.
+  osl_generic_add(&scop->extension, test_generic(OSL_URI_COMMENT));
+  index = scop->extension->index;
+  nb_fail += ((index != NULL) && (index->nb_generics == 1)) ? 0 : 1;
+  generic = test_generic(OSL_URI_ARRAYS);
+  osl_generic_add(&generic, test_generic(OSL_URI_STRINGS));
+  osl_generic_add(&scop->extension, generic);
+  nb_fail += ((scop->extension->index == index) && (generic->index == NULL))
+                 ? 0
+                 : 1;
+  nb_fail += (index->nb_generics == 3) ? 0 : 1;
+  nb_fail += (osl_generic_count(scop->extension) == 3) ? 0 : 1;
+  for (i = 0; i < 4; i++)
+    nb_fail += (osl_generic_lookup(scop->extension, uris[i]) ==
+                test_lookup(scop->extension, uris[i]))
+                   ? 0
+                   : 1;
+  nb_fail += (osl_generic_lookup(scop->extension, OSL_URI_ARRAYS) != NULL)
+                 ? 0
+                 : 1;
+  nb_fail += (osl_generic_lookup(scop->extension, "unknown") == NULL) ? 0 : 1;
+  osl_generic_remove(&scop->extension, OSL_URI_COMMENT);
+  osl_generic_remove(&scop->extension, "unknown");
+  index = scop->extension->index;
+  nb_fail += ((index != NULL) && (index->nb_generics == 2)) ? 0 : 1;
+  nb_fail += (osl_generic_count(scop->extension) == 2) ? 0 : 1;
+  nb_fail += (osl_generic_lookup(scop->extension, OSL_URI_COMMENT) == NULL)
+                 ? 0
+                 : 1;
+  nb_fail += (osl_generic_lookup(scop->extension, OSL_URI_STRINGS) ==
+              test_lookup(scop->extension, OSL_URI_STRINGS))
+                 ? 0
+                 : 1;
+  printf("scop index: nb fail = %d\n", nb_fail);
+
+  // The same with the extensions of a statement, starting from none.
+  nb_fail += (osl_generic_lookup(statement->extension, OSL_URI_BODY) == NULL)
+                 ? 0
+                 : 1;
+  for (i = 0; i < 5; i++)
+    osl_generic_add(&statement->extension, test_generic(uris[i]));
+  nb_fail += (statement->extension->index->nb_generics == 5) ? 0 : 1;
+  for (i = 0; i < 5; i++) {
+    atom = osl_interface_atom(uris[i]);
+    nb_fail += (osl_generic_lookup(statement->extension, atom) ==
+                test_lookup(statement->extension, uris[i]))
+                   ? 0
+                   : 1;
+  }
+  // Removing nodes in any order keeps the other ones reachable.
+  for (i = 0; i < 5; i++) {
+    osl_generic_remove(&statement->extension, uris[(2 * i) % 5]);
+    nb_fail += (osl_generic_lookup(statement->extension, uris[(2 * i) % 5]) ==
+                NULL)
+                   ? 0
+                   : 1;
+    for (j = 0; j < 5; j++)
+      nb_fail += (osl_generic_lookup(statement->extension, uris[j]) ==
+                  test_lookup(statement->extension, uris[j]))
+                     ? 0
+                     : 1;
+  }
+  nb_fail += (statement->extension == NULL) ? 0 : 1;
+  printf("statement index: nb fail = %d\n", nb_fail);
+
+  // Clones are indexed, and a list linked directly is indexed again.
+  generic = osl_generic_clone(scop->extension);
+  nb_fail += ((generic->index != NULL) && (generic->index->nb_generics == 2))
+                 ? 0
+                 : 1;
+  generic->next->next = test_generic(OSL_URI_BODY);
+  osl_generic_index_sync(generic);
+  nb_fail += (generic->index->nb_generics == 3) ? 0 : 1;
+  nb_fail += (osl_generic_lookup(generic, OSL_URI_BODY) ==
+              generic->next->next->data)
+                 ? 0
+                 : 1;
+  osl_generic_free(generic);
+  printf("clone index: nb fail = %d\n", nb_fail);
+
+  osl_statement_free(statement);
+  osl_scop_free(scop);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
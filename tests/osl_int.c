@@ -349,6 +349,27 @@ int main(int argc, char** argv)
           error++; printf("Error osl_int_abs\n");
         }
       }
+
+      // osl_int_addmul_array and osl_int_oppose_array
+      if (!error) {
+        osl_int_assign(OSL_PRECISION_SP, &c_sp, a_sp);
+        osl_int_assign(OSL_PRECISION_DP, &c_dp, a_dp);
+        osl_int_assign(OSL_PRECISION_MP, &c_mp, a_mp);
+        osl_int_addmul_array(OSL_PRECISION_SP, &c_sp, &b_sp, 1, a_sp);
+        osl_int_addmul_array(OSL_PRECISION_DP, &c_dp, &b_dp, 1, a_dp);
+        osl_int_addmul_array(OSL_PRECISION_MP, &c_mp, &b_mp, 1, a_mp);
+        osl_int_oppose_array(OSL_PRECISION_SP, &c_sp, 1);
+        osl_int_oppose_array(OSL_PRECISION_DP, &c_dp, 1);
+        osl_int_oppose_array(OSL_PRECISION_MP, &c_mp, 1);
+
+        int c_sp_i = osl_int_get_si(OSL_PRECISION_SP, c_sp);
+        int c_dp_i = osl_int_get_si(OSL_PRECISION_DP, c_dp);
+        int c_mp_i = osl_int_get_si(OSL_PRECISION_MP, c_mp);
+
+        if (c_sp_i != c_dp_i || c_sp_i != c_mp_i || c_sp_i != -(i + i * j)) {
+          error++; printf("Error osl_int_addmul_array\n");
+        }
+      }
       
       // osl_int_size_in_base_2
       if (!error) {
@@ -402,6 +423,18 @@ int main(int argc, char** argv)
         }
       }
 
+      // osl_int_eq_array
+      if (!error) {
+        int c1, c2, c3;
+        c1 = osl_int_eq_array(OSL_PRECISION_SP, &a_sp, &b_sp, 1);
+        c2 = osl_int_eq_array(OSL_PRECISION_DP, &a_dp, &b_dp, 1);
+        c3 = osl_int_eq_array(OSL_PRECISION_MP, &a_mp, &b_mp, 1);
+
+        if (c1 != c2 || c1 != c3 || c2 != c3 || c1 != (i == j)) {
+          error++; printf("Error osl_int_eq_array\n");
+        }
+      }
+
       // osl_int_pos
       if (!error) {
         int c1, c2, c3;
@@ -0,0 +1,157 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                             osl_interface.c                              **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+static const char* const test_scop =
+    "<OpenScop>\n"
+    "C\n"
+    "CONTEXT\n"
+    "0 2 0 0 0 0\n"
+    "0\n"
+    "0\n"
+    "<arrays>\n"
+    "1\n"
+    "1 A\n"
+    "</arrays>\n"
+    "</OpenScop>\n";
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  FILE* file;
+  osl_interface_p frozen, interface, registry;
+  osl_generic_p generic;
+  osl_scop_p scop, clone;
+
+  // The frozen registry is built once and matches the default one.
+  frozen = osl_interface_get_frozen_registry();
+  registry = osl_interface_get_default_registry();
+  nb_fail += (osl_interface_get_frozen_registry() == frozen) ? 0 : 1;
+  nb_fail += (osl_interface_number(frozen) ==
+              osl_interface_number(registry))
+                 ? 0
+                 : 1;
+  for (interface = registry; interface != NULL; interface = interface->next)
+    nb_fail += osl_interface_equal(
+                   osl_interface_lookup(frozen, interface->URI), interface)
+                   ? 0
+                   : 1;
+  osl_interface_free(registry);
+  nb_fail += (osl_interface_lookup(frozen, "unknown") == NULL) ? 0 : 1;
+  interface = osl_interface_lookup(frozen, OSL_URI_ARRAYS);
+  nb_fail += (osl_interface_lookup(interface, OSL_URI_STRINGS) == NULL) ? 0
+                                                                        : 1;
+  printf("registry: nb fail = %d\n", nb_fail);
+
+  // Frozen interfaces are shared, not copied nor freed.
+  nb_fail += (osl_interface_clone(frozen) == frozen) ? 0 : 1;
+  interface = osl_interface_nclone(interface, 1);
+  nb_fail += (interface->frozen && (interface->next == NULL)) ? 0 : 1;
+  nb_fail += (osl_interface_clone(interface) == interface) ? 0 : 1;
+  osl_interface_free(interface);
+  osl_interface_free(frozen);
+  nb_fail += (osl_interface_get_frozen_registry() == frozen) ? 0 : 1;
+  printf("sharing: nb fail = %d\n", nb_fail);
+
+  // Scops and generics read with the frozen registry refer to it.
+  file = tmpfile();
+  fputs(test_scop, file);
+  rewind(file);
+  scop = osl_scop_read(file);
+  fclose(file);
+  nb_fail += (scop->registry == frozen) ? 0 : 1;
+  generic = scop->extension;
+  nb_fail += osl_generic_has_URI(generic, OSL_URI_ARRAYS) ? 0 : 1;
+  nb_fail += (generic->interface->frozen) ? 0 : 1;
+  clone = osl_scop_clone(scop);
+  nb_fail += (clone->registry == frozen) ? 0 : 1;
+  nb_fail += osl_scop_equal(scop, clone) ? 0 : 1;
+  osl_scop_free(clone);
+  printf("reading: nb fail = %d\n", nb_fail);
+
+  // Registering an extension copies the frozen registry first.
+  interface = osl_interface_malloc();
+  OSL_strdup(interface->URI, "test");
+  osl_scop_register_extension(scop, interface);
+  nb_fail += (scop->registry != frozen) ? 0 : 1;
+  nb_fail += (scop->registry->frozen == 0) ? 0 : 1;
+  nb_fail += (osl_interface_lookup(scop->registry, "test") == interface) ? 0
+                                                                         : 1;
+  nb_fail += (osl_interface_lookup(frozen, "test") == NULL) ? 0 : 1;
+  nb_fail += (osl_interface_number(scop->registry) ==
+              osl_interface_number(frozen) + 1)
+                 ? 0
+                 : 1;
+  osl_scop_free(scop);
+  printf("registration: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
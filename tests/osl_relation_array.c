@@ -0,0 +1,194 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                           osl_relation_array.c                           **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+// Union of three parts: i = 0, i = 1, i = 2 (with one free parameter).
+static const char* const test_union =
+    "DOMAIN\n"
+    "3\n"
+    "1 4 1 0 0 1\n"
+    "   0    1    0    0\n"
+    "1 4 1 0 0 1\n"
+    "   0    1    0   -1\n"
+    "1 4 1 0 0 1\n"
+    "   0    1    0   -2\n";
+
+static const char* const test_part =
+    "DOMAIN\n"
+    "1 4 1 0 0 1\n"
+    "   0    1    0   -3\n";
+
+// Returns the constant of the first row of a relation part.
+static long test_constant(const osl_relation_t* relation) {
+  long constant;
+  osl_int_t value;
+
+  osl_int_init(relation->precision, &value);
+  osl_relation_get_value(relation, 0, relation->nb_columns - 1, &value);
+  constant = osl_int_get_si(relation->precision, value);
+  osl_int_clear(relation->precision, &value);
+  return constant;
+}
+
+// Converts each part to sparse form and counts the visits of each rank.
+static void test_body(osl_relation_t* part, int k, void* usr) {
+  int* visits = usr;
+
+  if (part->next == NULL)
+    visits[k]++;
+  osl_relation_to_sparse(part);
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int k, nb_fail = 0;
+  int visits[3] = {0, 0, 0};
+  char* string;
+  char* input;
+  osl_relation_p relation, part, clone;
+  osl_relation_array_p array;
+
+  string = osl_util_strdup(test_union);
+  input = string;
+  relation = osl_relation_sread(&input);
+  free(string);
+
+  // The reader attaches the part array: random access to linked parts.
+  nb_fail += osl_relation_array_is_current(relation) ? 0 : 1;
+  array = osl_relation_array_get(relation);
+  nb_fail += (array == relation->parts) ? 0 : 1;
+  nb_fail += (osl_relation_array_nb_parts(array) == 3) ? 0 : 1;
+  nb_fail += (osl_relation_array_head(array) == relation) ? 0 : 1;
+  nb_fail += (osl_relation_array_part(array, 2) == relation->next->next)
+                 ? 0
+                 : 1;
+  nb_fail += (osl_relation_nb_components(relation) == 3) ? 0 : 1;
+  string = osl_util_strdup(test_part);
+  input = string;
+  part = osl_relation_sread(&input);
+  free(string);
+  osl_relation_add(&relation, part);
+  nb_fail += (relation->parts == array) ? 0 : 1;
+  nb_fail += (osl_relation_array_nb_parts(array) == 4) ? 0 : 1;
+  nb_fail += (osl_relation_array_part(array, 2)->next == part) ? 0 : 1;
+  nb_fail += (osl_relation_nb_components(relation) == 4) ? 0 : 1;
+  printf("access: nb fail = %d\n", nb_fail);
+
+  // Removal keeps the linkage and the array consistent.
+  part = osl_relation_array_remove(array, 1);
+  nb_fail += (part->next == NULL) ? 0 : 1;
+  nb_fail += (test_constant(part) == -1) ? 0 : 1;
+  osl_relation_free(part);
+  nb_fail += (osl_relation_array_nb_parts(array) == 3) ? 0 : 1;
+  nb_fail += (relation->next == osl_relation_array_part(array, 1)) ? 0 : 1;
+  nb_fail += (osl_relation_nb_components(relation) == 3) ? 0 : 1;
+  part = relation;
+  osl_relation_remove_part(&relation, part);
+  osl_relation_free(part);
+  nb_fail += (relation->parts == array) ? 0 : 1;
+  nb_fail += (test_constant(relation) == -2) ? 0 : 1;
+  nb_fail += (osl_relation_nb_components(relation) == 2) ? 0 : 1;
+  osl_relation_add(&relation, osl_relation_nclone(relation, 1));
+  nb_fail += (osl_relation_nb_components(relation) == 3) ? 0 : 1;
+  printf("removal: nb fail = %d\n", nb_fail);
+
+  // Cloning attaches an array to the clone.
+  clone = osl_relation_clone(relation);
+  nb_fail += osl_relation_array_is_current(clone) ? 0 : 1;
+  nb_fail += (osl_relation_nb_components(clone) == 3) ? 0 : 1;
+  nb_fail += osl_relation_equal(clone, relation) ? 0 : 1;
+
+  // Direct edits of the next fields need a synchronization.
+  part = clone->next->next;
+  clone->next->next = NULL;
+  nb_fail += osl_relation_array_is_current(clone) ? 1 : 0;
+  nb_fail += (osl_relation_nb_components(clone) == 2) ? 0 : 1;
+  osl_relation_array_sync(clone);
+  nb_fail += (osl_relation_array_nb_parts(clone->parts) == 2) ? 0 : 1;
+  osl_relation_free(part);
+  osl_relation_free(clone);
+  printf("cloning: nb fail = %d\n", nb_fail);
+
+  // Parallel iteration sees unlinked parts and relinks them.
+  osl_relation_array_parallel_for(array, test_body, visits);
+  for (k = 0; k < 3; k++) {
+    nb_fail += (visits[k] == 1) ? 0 : 1;
+    nb_fail += osl_relation_is_sparse(osl_relation_array_part(array, k)) ? 0
+                                                                         : 1;
+  }
+  nb_fail += (relation->next == osl_relation_array_part(array, 1)) ? 0 : 1;
+  nb_fail += osl_relation_array_is_current(relation) ? 0 : 1;
+  nb_fail += (test_constant(relation->next->next) == -2) ? 0 : 1;
+  osl_relation_free(relation);
+  printf("parallel iteration: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                       osl_relation_canonicalize.c                        **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+#include "osl_relation_test.h"
+
+static const char* const test_relation =
+    "DOMAIN\n"
+    "3 5 2 0 0 1\n"
+    "   0   -1    0    1    0\n"
+    "   1    0    1    0    0\n"
+    "   1    0   -1    1   -1\n";
+
+// Same constraints, permuted, scaled, duplicated, plus a trivial one.
+static const char* const test_variant =
+    "DOMAIN\n"
+    "5 5 2 0 0 1\n"
+    "   1    0   -2    2   -2\n"
+    "   1    0    0    0    3\n"
+    "   0    2    0   -2    0\n"
+    "   1    0    1    0    0\n"
+    "   1    0    1    0    0\n";
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  osl_int_t** m;
+  osl_relation_table_p table;
+  osl_relation_p r1, r2;
+
+  // Equivalent constraint systems get the same canonical form.
+  r1 = test_read(test_relation);
+  r2 = test_read(test_variant);
+  nb_fail += osl_relation_equal(r1, r2) ? 1 : 0;
+  osl_relation_canonicalize(r1);
+  osl_relation_canonicalize(r2);
+  nb_fail += (r2->nb_rows == 3) ? 0 : 1;
+  nb_fail += osl_relation_equal(r1, r2) ? 0 : 1;
+  nb_fail += (osl_relation_hash(r1) == osl_relation_hash(r2)) ? 0 : 1;
+  nb_fail += (osl_int_get_si(r2->precision, r2->m[0][0]) == 0) ? 0 : 1;
+  nb_fail += (osl_int_get_si(r2->precision, r2->m[0][1]) == -1) ? 0 : 1;
+  printf("canonical form: nb fail = %d\n", nb_fail);
+
+  // Canonical relations are left untouched, so they stay shared.
+  table = osl_relation_table_malloc();
+  osl_relation_intern(table, r1);
+  osl_relation_intern(table, r2);
+  m = r1->m;
+  osl_relation_canonicalize(r1);
+  nb_fail += ((r1->m == m) && (r2->m == m)) ? 0 : 1;
+  nb_fail += osl_relation_is_shared(r1) ? 0 : 1;
+  osl_relation_free(r1);
+  osl_relation_free(r2);
+  osl_relation_table_free(table);
+  printf("idempotence: nb fail = %d\n", nb_fail);
+
+  // The layout of each part is preserved.
+  r1 = test_read(test_relation);
+  r2 = test_read(test_variant);
+  osl_relation_to_sparse(r2);
+  osl_relation_canonicalize(r1);
+  osl_relation_canonicalize(r2);
+  nb_fail += osl_relation_is_sparse(r2) ? 0 : 1;
+  nb_fail += osl_relation_equal(r1, r2) ? 0 : 1;
+  osl_relation_free(r1);
+  osl_relation_free(r2);
+  printf("sparse layout: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
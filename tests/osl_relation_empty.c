@@ -0,0 +1,210 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                           osl_relation_empty.c                           **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+#include "osl_relation_test.h"
+
+// Union of 0 <= i <= N, i <= j <= i + 2 and j = 2 i, 0 <= j <= N.
+static const char* const test_union =
+    "DOMAIN\n"
+    "2\n"
+    "4 5 2 0 0 1\n"
+    "   1    1    0    0    0\n"
+    "   1   -1    0    1    0\n"
+    "   1   -1    1    0    0\n"
+    "   1    1   -1    0    2\n"
+    "3 5 2 0 0 1\n"
+    "   0   -2    1    0    0\n"
+    "   1    0    1    0    0\n"
+    "   1    0   -1    1    0\n";
+
+// Shadow of i <= 3 j <= i + 1, not exact on integers.
+static const char* const test_shadow =
+    "DOMAIN\n"
+    "2 4 2 0 0 0\n"
+    "   1   -1    3    0\n"
+    "   1    1   -3    1\n";
+
+// Union of i >= 1 and -i >= 0, 2 i == 1, and 1 <= 3 i <= 2: no integer.
+static const char* const test_empty =
+    "DOMAIN\n"
+    "3\n"
+    "2 3 1 0 0 0\n"
+    "   1    1   -1\n"
+    "   1   -1    0\n"
+    "1 3 1 0 0 0\n"
+    "   0    2   -1\n"
+    "2 3 1 0 0 0\n"
+    "   1    3   -1\n"
+    "   1   -3    2\n";
+
+// 3 i + 1 >= 0, 3 i + 4 j >= 5 and 3 i + 2 j <= 3: rational points only,
+// with i = 0 and 5 / 4 <= j <= 3 / 2.
+static const char* const test_lattice =
+    "DOMAIN\n"
+    "3 4 2 0 0 0\n"
+    "   1    3    0    1\n"
+    "   1    3    4   -5\n"
+    "   1   -3   -2    3\n";
+
+// 3 i - 2 j + 3 == 0 and i - 2 j + 3 == 0: i = 0 and j = 3 / 2.
+static const char* const test_equalities =
+    "DOMAIN\n"
+    "2 4 2 0 0 0\n"
+    "   0    3   -2    3\n"
+    "   0    1   -2    3\n";
+
+// The empty set k <= i <= k - 100 for every 0 <= k < n (no redundancy
+// removed), whose elimination builds n * n rows.
+static osl_relation_t* test_bounds(int n) {
+  int k;
+  osl_relation_p relation = osl_relation_malloc(2 * n, 3);
+
+  relation->type = OSL_TYPE_DOMAIN;
+  relation->nb_output_dims = 1;
+  relation->nb_input_dims = 0;
+  relation->nb_local_dims = 0;
+  relation->nb_parameters = 0;
+  for (k = 0; k < n; k++) {
+    osl_int_set_si(relation->precision, &relation->m[k][0], 1);
+    osl_int_set_si(relation->precision, &relation->m[k][1], 1);
+    osl_int_set_si(relation->precision, &relation->m[k][2], -k);
+    osl_int_set_si(relation->precision, &relation->m[n + k][0], 1);
+    osl_int_set_si(relation->precision, &relation->m[n + k][1], -1);
+    osl_int_set_si(relation->precision, &relation->m[n + k][2], k - 100);
+  }
+  return relation;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  osl_relation_p r1, r2;
+  osl_dependence_p deps;
+
+  // Emptiness: rational, gcd and tightening contradictions.
+  r1 = test_read(test_empty);
+  r2 = test_read(test_union);
+  nb_fail += osl_relation_is_trivially_empty(r1) ? 0 : 1;
+  nb_fail += osl_relation_is_trivially_empty(r2) ? 1 : 0;
+  r2->next->next = r1;
+  nb_fail += osl_relation_is_trivially_empty(r2->next) ? 1 : 0;
+  r2->next->next = NULL;
+  osl_relation_free(r1);
+  r1 = test_read(test_shadow);
+  nb_fail += osl_relation_is_trivially_empty(r1) ? 1 : 0;
+  osl_relation_free(r1);
+
+  // The test gives up before building more than the row limit.
+  r1 = test_bounds(10);
+  nb_fail += osl_relation_is_trivially_empty(r1) ? 0 : 1;
+  osl_relation_free(r1);
+  r1 = test_bounds(65);
+  nb_fail += osl_relation_is_trivially_empty(r1) ? 1 : 0;
+  osl_relation_free(r1);
+
+  printf("trivial emptiness: nb fail = %d\n", nb_fail);
+
+  // Exact emptiness: integer points hidden by rational ones.
+  r1 = test_read(test_empty);
+  nb_fail += osl_relation_is_empty(r1) ? 0 : 1;
+  osl_relation_free(r1);
+  nb_fail += osl_relation_is_empty(r2) ? 1 : 0;
+  r1 = test_read(test_shadow);
+  nb_fail += osl_relation_is_empty(r1) ? 1 : 0;
+  osl_relation_free(r1);
+  r1 = test_read(test_lattice);
+  nb_fail += osl_relation_is_trivially_empty(r1) ? 1 : 0;
+  nb_fail += osl_relation_is_empty(r1) ? 0 : 1;
+  osl_relation_add(&r1, test_read(test_equalities));
+  nb_fail += osl_relation_is_empty(r1) ? 0 : 1;
+  nb_fail += osl_relation_is_empty(r1->next) ? 0 : 1;
+  osl_relation_free(r1);
+  r1 = test_bounds(65);
+  nb_fail += osl_relation_is_empty(r1) ? 0 : 1;
+  osl_relation_free(r1);
+  nb_fail += osl_relation_is_empty(NULL) ? 1 : 0;
+  printf("exact emptiness: nb fail = %d\n", nb_fail);
+
+  // Dependences with an empty polyhedron are pruned, not the ones without.
+  deps = osl_dependence_malloc();
+  deps->domain = test_read(test_lattice);
+  deps->next = osl_dependence_malloc();
+  deps->next->domain = r2;
+  deps->next->next = osl_dependence_malloc();
+  nb_fail += (osl_dependence_prune_empty(&deps) == 1) ? 0 : 1;
+  nb_fail += ((deps != NULL) && (deps->domain == r2)) ? 0 : 1;
+  nb_fail += (osl_nb_dependences(deps) == 2) ? 0 : 1;
+  osl_dependence_free(deps);
+  printf("pruning: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
@@ -0,0 +1,242 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                          osl_relation_intern.c                           **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+static const char* const test_relation =
+    "DOMAIN\n"
+    "4 5 2 0 0 1\n"
+    "   1    1    0    0    0\n"
+    "   1   -1    0    1   -1\n"
+    "   1    0    1    0    0\n"
+    "   1    0   -1    1   -1\n";
+
+static const char* const test_scop =
+    "<OpenScop>\n"
+    "C\n"
+    "CONTEXT\n"
+    "1 3 0 0 0 1\n"
+    "   1    1   -1\n"
+    "1\n"
+    "<strings>\n"
+    "N\n"
+    "</strings>\n"
+    "2\n"
+    "2\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "   1    1    0    0\n"
+    "   1   -1    1   -1\n"
+    "SCATTERING\n"
+    "3 7 3 1 0 1\n"
+    "   0   -1    0    0    0    0    0\n"
+    "   0    0   -1    0    1    0    0\n"
+    "   0    0    0   -1    0    0    0\n"
+    "0\n"
+    "2\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "   1    1    0    0\n"
+    "   1   -1    1   -1\n"
+    "SCATTERING\n"
+    "3 7 3 1 0 1\n"
+    "   0   -1    0    0    0    0    1\n"
+    "   0    0   -1    0    1    0    0\n"
+    "   0    0    0   -1    0    0    0\n"
+    "0\n"
+    "</OpenScop>\n";
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  char* string;
+  char* input;
+  FILE* file;
+  osl_int_t value;
+  osl_relation_table_p table;
+  osl_relation_p r1, r2, clone;
+  osl_statement_p s1, s2;
+  osl_scop_p scop, scop_clone;
+
+  // Identical relations share one matrix.
+  string = osl_util_strdup(test_relation);
+  input = string;
+  r1 = osl_relation_sread(&input);
+  input = string;
+  r2 = osl_relation_sread(&input);
+  free(string);
+  table = osl_relation_table_malloc();
+  osl_relation_intern(table, r1);
+  osl_relation_intern(table, r2);
+  osl_relation_intern(table, r2);
+  nb_fail += (r1->m == r2->m) ? 0 : 1;
+  nb_fail += (r1->shared == r2->shared) ? 0 : 1;
+  nb_fail += (table->nb_entries == 1) ? 0 : 1;
+  nb_fail += (r1->shared->refcount == 2) ? 0 : 1;
+  printf("interning: nb fail = %d\n", nb_fail);
+
+  // Hard copies never share the matrix.
+  clone = osl_relation_clone(r1);
+  nb_fail += (clone->m != r1->m) ? 0 : 1;
+  nb_fail += osl_relation_is_shared(clone) ? 1 : 0;
+  nb_fail += (r1->shared->refcount == 2) ? 0 : 1;
+  osl_int_set_si(clone->precision, &clone->m[0][1], 42);
+  nb_fail += osl_relation_equal(r1, r2) ? 0 : 1;
+  osl_relation_free(clone);
+  printf("hard copy: nb fail = %d\n", nb_fail);
+
+  // Copy-on-write clones share the matrix until they are modified.
+  clone = osl_relation_clone_cow(r1);
+  nb_fail += (clone->m == r1->m) ? 0 : 1;
+  nb_fail += (r1->shared->refcount == 3) ? 0 : 1;
+  nb_fail += osl_relation_equal(r1, clone) ? 0 : 1;
+  nb_fail += (osl_relation_hash(r1) == osl_relation_hash(clone)) ? 0 : 1;
+  osl_int_init_set_si(clone->precision, &value, 42);
+  osl_relation_set_value(clone, 0, 1, value);
+  osl_int_clear(clone->precision, &value);
+  nb_fail += (clone->m != r1->m) ? 0 : 1;
+  nb_fail += osl_relation_is_shared(clone) ? 1 : 0;
+  nb_fail += (r1->shared->refcount == 2) ? 0 : 1;
+  nb_fail += osl_relation_equal(r1, r2) ? 0 : 1;
+  nb_fail += osl_relation_equal(r1, clone) ? 1 : 0;
+  osl_relation_free(clone);
+  printf("copy on write: nb fail = %d\n", nb_fail);
+
+  // Interned matrices outlive the table and the other sharers.
+  osl_relation_table_free(table);
+  osl_relation_free(r1);
+  nb_fail += (r2->shared->refcount == 1) ? 0 : 1;
+  nb_fail += (r2->shared->table == NULL) ? 0 : 1;
+  osl_relation_unshare(r2);
+  nb_fail += osl_relation_is_shared(r2) ? 1 : 0;
+  osl_relation_free(r2);
+  printf("release: nb fail = %d\n", nb_fail);
+
+  // Interning a scop makes identical statement relations share matrices.
+  file = tmpfile();
+  fputs(test_scop, file);
+  rewind(file);
+  scop = osl_scop_read(file);
+  fclose(file);
+  table = osl_relation_table_malloc();
+  osl_scop_intern(table, scop);
+  s1 = scop->statement;
+  s2 = s1->next;
+  nb_fail += (s1->domain->m == s2->domain->m) ? 0 : 1;
+  nb_fail += (s1->scattering->m != s2->scattering->m) ? 0 : 1;
+  nb_fail += (table->nb_entries == 4) ? 0 : 1;
+
+  scop_clone = osl_scop_clone(scop);
+  nb_fail += osl_scop_equal(scop, scop_clone) ? 0 : 1;
+  nb_fail += (scop_clone->statement->domain->m != s1->domain->m) ? 0 : 1;
+  osl_scop_free(scop_clone);
+  scop_clone = osl_scop_clone_cow(scop);
+  nb_fail += osl_scop_equal(scop, scop_clone) ? 0 : 1;
+  nb_fail += (scop_clone->statement->domain->m == s1->domain->m) ? 0 : 1;
+  osl_relation_insert_blank_column(scop_clone->statement->domain, 1);
+  osl_relation_set_precision(OSL_PRECISION_SP, scop_clone->context);
+  nb_fail += osl_scop_equal(scop, scop_clone) ? 1 : 0;
+  nb_fail += (s1->domain->nb_columns == 4) ? 0 : 1;
+  nb_fail += osl_relation_equal(s1->domain, s2->domain) ? 0 : 1;
+  nb_fail += (scop->context->precision == osl_util_get_precision()) ? 0 : 1;
+  osl_scop_free(scop_clone);
+  osl_relation_table_free(table);
+  osl_scop_free(scop);
+  printf("scop: nb fail = %d\n", nb_fail);
+
+  // Copy-on-write clones need no table.
+  file = tmpfile();
+  fputs(test_scop, file);
+  rewind(file);
+  scop = osl_scop_read(file);
+  fclose(file);
+  scop_clone = osl_scop_clone_cow(scop);
+  s1 = scop->statement;
+  s2 = scop_clone->statement;
+  nb_fail += osl_scop_equal(scop, scop_clone) ? 0 : 1;
+  nb_fail += (s1->domain->m == s2->domain->m) ? 0 : 1;
+  nb_fail += (s1->domain->m != s1->next->domain->m) ? 0 : 1;
+  nb_fail += (s1->domain->shared->refcount == 2) ? 0 : 1;
+  osl_relation_swap_constraints(s2->scattering, 0, 1);
+  nb_fail += (s1->scattering->m != s2->scattering->m) ? 0 : 1;
+  nb_fail += (s1->scattering->shared->refcount == 1) ? 0 : 1;
+  nb_fail += osl_scop_equal(scop, scop_clone) ? 1 : 0;
+  osl_relation_extend_output_inplace(s1->domain, 3);
+  nb_fail += (s1->domain->m != s2->domain->m) ? 0 : 1;
+  nb_fail += (s1->domain->nb_output_dims == 3) ? 0 : 1;
+  nb_fail += (s2->domain->nb_columns == 4) ? 0 : 1;
+  osl_scop_free(scop);
+  nb_fail += (s2->domain->shared->refcount == 1) ? 0 : 1;
+  nb_fail += (s2->domain->nb_columns == 4) ? 0 : 1;
+  osl_scop_free(scop_clone);
+  printf("copy-on-write clone: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
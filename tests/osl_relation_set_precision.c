@@ -81,6 +81,7 @@ int main(int argc, char** argv)
   osl_relation_set_precision(OSL_PRECISION_SP, r1);
   printf("r1 %d =\n", r1->precision);
   osl_relation_print(stdout, r1);
+  nb_fail += (osl_relation_hash(r0) == osl_relation_hash(r1)) ? 0 : 1;
   osl_relation_set_same_precision(r0, r1);
   nb_fail += osl_relation_equal(r0, r1) ? 0 : 1;
   printf("nb fail = %u\n\n", nb_fail);
@@ -88,6 +89,7 @@ int main(int argc, char** argv)
   osl_relation_set_precision(OSL_PRECISION_DP, r1);
   printf("r1 %d =\n", r1->precision);
   osl_relation_print(stdout, r1);
+  nb_fail += (osl_relation_hash(r0) == osl_relation_hash(r1)) ? 0 : 1;
   osl_relation_set_same_precision(r0, r1);
   nb_fail += osl_relation_equal(r0, r1) ? 0 : 1;
   printf("nb fail = %u\n\n", nb_fail);
@@ -95,6 +97,7 @@ int main(int argc, char** argv)
   osl_relation_set_precision(OSL_PRECISION_MP, r1);
   printf("r1 %d =\n", r1->precision);
   osl_relation_print(stdout, r1);
+  nb_fail += (osl_relation_hash(r0) == osl_relation_hash(r1)) ? 0 : 1;
   osl_relation_set_same_precision(r0, r1);
   nb_fail += osl_relation_equal(r0, r1) ? 0 : 1;
   printf("nb fail = %u\n\n", nb_fail);
@@ -0,0 +1,179 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                          osl_relation_sparse.c                           **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  int precision = osl_util_get_precision();
+  char string[] =
+      "DOMAIN\n"
+      "2\n"
+      "4 5 2 0 0 1\n"
+      "   1    1    0    0    0\n"
+      "   1   -1    0    1   -1\n"
+      "   1    0    1    0    0\n"
+      "   1    0   -1    1   -1\n"
+      "1 5 2 0 0 1\n"
+      "   0    1   -1    0    0\n";
+  char* input;
+  char *dense_string, *sparse_string;
+  osl_relation_p dense, sparse, clone, extended;
+  osl_int_t value;
+
+  input = string;
+  dense = osl_relation_psread(&input, precision);
+  input = string;
+  sparse = osl_relation_psread_sparse(&input, precision);
+
+  // Reading, printing, cloning and comparing.
+  nb_fail += osl_relation_is_sparse(dense) ? 1 : 0;
+  nb_fail += osl_relation_is_sparse(sparse) ? 0 : 1;
+  nb_fail += (sparse->m == NULL) ? 0 : 1;
+  nb_fail += (sparse->sparse->nb_nonzeros == 12) ? 0 : 1;
+  nb_fail += osl_relation_equal(dense, sparse) ? 0 : 1;
+  nb_fail += osl_relation_equal(sparse, dense) ? 0 : 1;
+  dense_string = osl_relation_sprint(dense);
+  sparse_string = osl_relation_sprint(sparse);
+  nb_fail += (strcmp(dense_string, sparse_string) == 0) ? 0 : 1;
+  OSL_free(dense_string);
+  OSL_free(sparse_string);
+  clone = osl_relation_clone(sparse);
+  nb_fail += osl_relation_is_sparse(clone) ? 0 : 1;
+  nb_fail += osl_relation_equal(clone, sparse) ? 0 : 1;
+  nb_fail += osl_relation_integrity_check(clone, OSL_TYPE_DOMAIN, 2, 0, 1)
+                 ? 0
+                 : 1;
+  printf("read/print/clone: nb fail = %d\n", nb_fail);
+
+  // Element accessors on both layouts.
+  osl_int_init(precision, &value);
+  osl_relation_get_value(sparse, 1, 3, &value);
+  nb_fail += osl_int_one(precision, value) ? 0 : 1;
+  osl_relation_get_value(sparse, 1, 2, &value);
+  nb_fail += osl_int_zero(precision, value) ? 0 : 1;
+  osl_int_set_si(precision, &value, 5);
+  osl_relation_set_value(clone, 1, 2, value);
+  osl_relation_set_value(dense, 1, 2, value);
+  nb_fail += (clone->sparse->nb_nonzeros == 13) ? 0 : 1;
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  osl_int_set_si(precision, &value, 0);
+  osl_relation_set_value(clone, 1, 2, value);
+  osl_relation_set_value(dense, 1, 2, value);
+  osl_relation_set_value(clone, 0, 1, value);
+  osl_relation_set_value(dense, 0, 1, value);
+  nb_fail += (clone->sparse->nb_nonzeros == 11) ? 0 : 1;
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  osl_int_clear(precision, &value);
+  printf("accessors: nb fail = %d\n", nb_fail);
+
+  // Conversions and mutators.
+  osl_relation_to_dense(clone);
+  nb_fail += osl_relation_is_sparse(clone) ? 1 : 0;
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  osl_relation_to_sparse(clone);
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  osl_relation_insert_blank_row(clone, 0);
+  osl_relation_insert_blank_row(dense, 0);
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  osl_relation_row_oppose(clone, 1);
+  osl_relation_row_oppose(dense, 1);
+  nb_fail += osl_relation_equal(clone, dense) ? 0 : 1;
+  nb_fail += (clone->sparse == NULL) ? 0 : 1;
+  nb_fail += (clone->next->sparse != NULL) ? 0 : 1;
+  osl_relation_free(clone);
+  printf("conversions: nb fail = %d\n", nb_fail);
+
+  // In-place output extension on both layouts.
+  extended = osl_relation_extend_output(sparse, 4);
+  clone = osl_relation_clone(sparse);
+  osl_relation_extend_output_inplace(clone, 4);
+  nb_fail += osl_relation_equal(clone, extended) ? 0 : 1;
+  nb_fail += (clone->nb_output_dims == 4) ? 0 : 1;
+  nb_fail += (clone->next->nb_rows == 3) ? 0 : 1;
+  osl_relation_extend_output_inplace(clone, 4);
+  nb_fail += osl_relation_equal(clone, extended) ? 0 : 1;
+  osl_relation_free(clone);
+  osl_relation_free(extended);
+  extended = osl_relation_extend_output(dense, 4);
+  clone = osl_relation_clone(dense);
+  osl_relation_extend_output_inplace(clone, 3);
+  osl_relation_extend_output_inplace(clone, 4);
+  nb_fail += osl_relation_equal(clone, extended) ? 0 : 1;
+  osl_relation_free(clone);
+  osl_relation_free(extended);
+  printf("extension: nb fail = %d\n", nb_fail);
+
+  osl_relation_free(dense);
+  osl_relation_free(sparse);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
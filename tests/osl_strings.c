@@ -0,0 +1,164 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              osl_strings.c                               **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  int i;
+  char name[32];
+  char* input;
+  char** saved;
+  char** array;
+  char line[] = "i j N\n";
+  osl_strings_p strings, clone;
+
+  // Adding in a loop keeps the cached size and grows geometrically.
+  strings = osl_strings_malloc();
+  for (i = 0; i < 1000; i++) {
+    sprintf(name, "s%d", i % 500);
+    osl_strings_add(strings, name);
+  }
+  nb_fail += (osl_strings_size(strings) == 1000) ? 0 : 1;
+  nb_fail += (strings->capacity >= 1001) ? 0 : 1;
+  nb_fail += (strings->capacity <= 2048) ? 0 : 1;
+  nb_fail += (strings->string[1000] == NULL) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "s42") == 42) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "x") == 1000) ? 0 : 1;
+  printf("size: nb fail = %d\n", nb_fail);
+
+  // The index gives the linear scan results, first occurrence included.
+  osl_strings_index_build(strings);
+  nb_fail += (strings->nb_slots >= 2002) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "s42") == 42) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "s499") == 499) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "x") == 1000) ? 0 : 1;
+  for (i = 0; i < 100; i++) {
+    sprintf(name, "t%d", i);
+    osl_strings_add(strings, name);
+  }
+  nb_fail += (osl_strings_find(strings, "t99") == 1099) ? 0 : 1;
+  clone = osl_strings_clone(strings);
+  nb_fail += (clone->nb_slots > 0) ? 0 : 1;
+  nb_fail += osl_strings_equal(clone, strings) ? 0 : 1;
+  nb_fail += (osl_strings_hash(clone) == osl_strings_hash(strings)) ? 0 : 1;
+  nb_fail += (osl_strings_find(clone, "t50") == 1050) ? 0 : 1;
+  osl_strings_free(clone);
+  printf("index: nb fail = %d\n", nb_fail);
+
+  // Direct modifications are visible after a synchronization.
+  OSL_free(strings->string[1099]);
+  strings->string[1099] = NULL;
+  osl_strings_sync(strings);
+  nb_fail += (osl_strings_size(strings) == 1099) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "t99") == 1099) ? 0 : 1;
+  OSL_free(strings->string[0]);
+  OSL_strdup(strings->string[0], "first");
+  osl_strings_sync(strings);
+  nb_fail += (osl_strings_find(strings, "first") == 0) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "s0") == 500) ? 0 : 1;
+  osl_strings_add(strings, "last");
+  nb_fail += (osl_strings_find(strings, "last") == 1099) ? 0 : 1;
+
+  // Replacing the array is detected without a synchronization.
+  saved = strings->string;
+  OSL_malloc(array, char**, 3 * sizeof(char*));
+  OSL_strdup(array[0], "a");
+  OSL_strdup(array[1], "b");
+  array[2] = NULL;
+  strings->string = array;
+  nb_fail += (osl_strings_size(strings) == 2) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "b") == 1) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "last") == 2) ? 0 : 1;
+  strings->string = saved;
+  nb_fail += (osl_strings_find(strings, "last") == 1099) ? 0 : 1;
+  for (i = 0; i < 2; i++)
+    OSL_free(array[i]);
+  OSL_free(array);
+  osl_strings_free(strings);
+  printf("synchronization: nb fail = %d\n", nb_fail);
+
+  // Other constructors set the cached fields.
+  input = line;
+  strings = osl_strings_sread(&input);
+  nb_fail += (strings->size == 3) ? 0 : 1;
+  nb_fail += (osl_strings_find(strings, "N") == 2) ? 0 : 1;
+  osl_strings_add(strings, "M");
+  nb_fail += (osl_strings_find(strings, "M") == 3) ? 0 : 1;
+  osl_strings_free(strings);
+  strings = osl_strings_generate("Dummy", 0);
+  osl_strings_add(strings, "A");
+  nb_fail += (osl_strings_size(strings) == 1) ? 0 : 1;
+  osl_strings_free(strings);
+  printf("constructors: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
@@ -0,0 +1,191 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                            osl_substitution.c                            **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+static char* identifiers[] = {"i", "ii", "j", "a.b", "i", "N_1", "+k", NULL};
+
+// Returns 1 if c may be part of an identifier, 0 otherwise.
+static int test_is_identifier_char(char c) {
+  return (((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) ||
+          ((c >= '0') && (c <= '9')) || (c == '_'));
+}
+
+// Reference substitution: every identifier is tried at every position.
+static void test_reference(const char* expression, char** ids, char* out) {
+  size_t i = 0, n = strlen(expression), len = 0, look;
+  int j, isolated;
+
+  out[0] = '\0';
+  while (i < n) {
+    for (j = 0; ids[j] != NULL; j++) {
+      len = strlen(ids[j]);
+      if ((i + len <= n) &&
+          ((i == 0) || !test_is_identifier_char(expression[i - 1])) &&
+          ((i + len == n) || !test_is_identifier_char(expression[i + len])) &&
+          !strncmp(expression + i, ids[j], len))
+        break;
+    }
+    if (ids[j] == NULL) {
+      strncat(out, expression + i, 1);
+      i++;
+      continue;
+    }
+    isolated = 1;
+    for (look = i; (look > 0) && (expression[look - 1] == ' '); look--)
+      continue;
+    if ((look > 0) && !strchr("[(+=,", expression[look - 1]))
+      isolated = 0;
+    for (look = i + len; (look < n) && (expression[look] == ' '); look++)
+      continue;
+    if ((look < n) && !strchr("])+,;", expression[look]))
+      isolated = 0;
+    sprintf(out + strlen(out), isolated ? "@%d@" : "(@%d@)", j);
+    i += len;
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int t, k, length, nb_fail = 0;
+  char expression[64], reference[512];
+  char* string;
+  char* iterators[] = {"i", "j", NULL};
+  const char alphabet[] = "ij.ab+kN_1 [](),*;=";
+  osl_util_substitution_p substitution;
+  osl_generic_p generic;
+  osl_interface_p interface, registry = osl_interface_get_frozen_registry();
+  osl_body_p body;
+  osl_extbody_p extbody;
+  osl_statement_p statement;
+  osl_scop_p scop;
+  char* input;
+  char body_string[] =
+      "2\n"
+      "i j\n"
+      "C[i][j] = C[i][j] + A[2*i][j];\n";
+  char extbody_string[] =
+      "3\n"
+      "0 7\n"
+      "10 7\n"
+      "20 9\n"
+      "2\n"
+      "i j\n"
+      "C[i][j] = C[i][j] + A[2*i][j];\n";
+
+  // The documented example.
+  string = osl_util_identifier_substitution("C[i+j]+=A[2*i]*B[j];", iterators);
+  nb_fail += strcmp(string, "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];") ? 1 : 0;
+  free(string);
+  printf("example: nb fail = %d\n", nb_fail);
+
+  // Random expressions give the same result as the reference.
+  srand(42);
+  substitution = osl_util_substitution_generate(identifiers);
+  for (t = 0; t < 2000; t++) {
+    length = rand() % 40;
+    for (k = 0; k < length; k++)
+      expression[k] = alphabet[(size_t)rand() % (sizeof(alphabet) - 1)];
+    expression[k] = '\0';
+    test_reference(expression, identifiers, reference);
+    string = osl_util_substitution_apply(substitution, expression, NULL);
+    nb_fail += strcmp(string, reference) ? 1 : 0;
+    free(string);
+  }
+  osl_util_substitution_free(substitution);
+  printf("random: nb fail = %d\n", nb_fail);
+
+  // Statement bodies are rewritten and the access coordinates follow.
+  statement = osl_statement_malloc();
+  input = body_string;
+  body = osl_body_sread(&input);
+  interface = osl_interface_lookup(registry, OSL_URI_BODY);
+  generic = osl_generic_shell(body, osl_interface_nclone(interface, 1));
+  osl_generic_add(&statement->extension, generic);
+  input = extbody_string;
+  extbody = osl_extbody_sread(&input);
+  interface = osl_interface_lookup(registry, OSL_URI_EXTBODY);
+  generic = osl_generic_shell(extbody, osl_interface_nclone(interface, 1));
+  osl_generic_add(&statement->extension, generic);
+  scop = osl_scop_malloc();
+  scop->statement = statement;
+  osl_scop_substitute_iterators(scop);
+
+  string = "C[@0@][@1@] = C[@0@][@1@] + A[2*(@0@)][@1@];";
+  nb_fail += strcmp(body->expression->string[0], string) ? 1 : 0;
+  nb_fail += strcmp(extbody->body->expression->string[0], string) ? 1 : 0;
+  nb_fail += ((extbody->start[0] == 0) && (extbody->length[0] == 11)) ? 0 : 1;
+  nb_fail += ((extbody->start[1] == 14) && (extbody->length[1] == 11)) ? 0 : 1;
+  nb_fail += ((extbody->start[2] == 28) && (extbody->length[2] == 15)) ? 0 : 1;
+  osl_scop_free(scop);
+  printf("bodies: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
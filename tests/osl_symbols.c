@@ -0,0 +1,153 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              osl_symbols.c                               **
+ **--------------------------------------------------------------------------**
+ **                        First version: 19/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+// Build a symbol with a textual identifier.
+static osl_symbols_p test_symbol(int type, const char* name, int nb_dims) {
+  char* string;
+  osl_symbols_p symbol = osl_symbols_malloc();
+
+  OSL_strdup(string, name);
+  symbol->type = type;
+  symbol->nb_dims = nb_dims;
+  symbol->identifier = osl_generic_shell(osl_strings_encapsulate(string),
+                                         osl_strings_interface());
+  return symbol;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    printf("argv are ignored\n");
+  }
+
+  int nb_fail = 0;
+  int i, n;
+  char name[32];
+  osl_symbols_p symbols = NULL, symbol;
+  osl_symbols_t* const* typed;
+  osl_symbols_index_p index;
+
+  // A list of iterators, parameters and arrays, with one duplicate name.
+  for (i = 0; i < 300; i++) {
+    sprintf(name, "s%d", i);
+    osl_symbols_add(&symbols, test_symbol(OSL_SYMBOL_TYPE_ITERATOR + i % 3,
+                                          name, i % 3));
+  }
+  osl_symbols_add(&symbols, test_symbol(OSL_SYMBOL_TYPE_FUNCTION, "s7", 0));
+  osl_symbols_add(&symbols, osl_symbols_malloc());
+
+  // Name lookups.
+  index = osl_symbols_index_build(symbols);
+  nb_fail += (index->nb_symbols == 302) ? 0 : 1;
+  symbol = osl_symbols_index_lookup(index, "s7");
+  nb_fail += (symbol == index->symbol[7]) ? 0 : 1;
+  nb_fail += (symbol->type == OSL_SYMBOL_TYPE_PARAMETER) ? 0 : 1;
+  nb_fail += (osl_symbols_lookup(symbols, symbol->identifier) == symbol) ? 0
+                                                                        : 1;
+  nb_fail += (osl_symbols_index_lookup(index, "s299") == index->symbol[299])
+                 ? 0
+                 : 1;
+  nb_fail += (osl_symbols_index_lookup(index, "x") == NULL) ? 0 : 1;
+  nb_fail += (index->name[301] == NULL) ? 0 : 1;
+  printf("lookup: nb fail = %d\n", nb_fail);
+
+  // Type queries.
+  n = osl_symbols_index_get_type(index, OSL_SYMBOL_TYPE_ARRAY, &typed);
+  nb_fail += (n == 100) ? 0 : 1;
+  for (i = 0; i < n; i++)
+    nb_fail += (typed[i] == index->symbol[3 * i + 2]) ? 0 : 1;
+  n = osl_symbols_index_get_type(index, OSL_SYMBOL_TYPE_FUNCTION, &typed);
+  nb_fail += (n == 1) ? 0 : 1;
+  nb_fail += (typed[0] == index->symbol[300]) ? 0 : 1;
+  n = osl_symbols_index_get_type(index, OSL_UNDEFINED, &typed);
+  nb_fail += (n == 1) ? 0 : 1;
+  for (i = 0; i < index->nb_symbols; i++)
+    nb_fail += (index->nb_dims[i] == index->symbol[i]->nb_dims) ? 0 : 1;
+  osl_symbols_index_free(index);
+  printf("type: nb fail = %d\n", nb_fail);
+
+  // Removal, then a new index.
+  symbol = osl_symbols_remove(&symbols, symbol);
+  nb_fail += (symbol != NULL) ? 0 : 1;
+  nb_fail += (osl_symbols_get_nb_symbols(symbols) == 301) ? 0 : 1;
+  index = osl_symbols_index_build(symbols);
+  nb_fail += (osl_symbols_index_lookup(index, "s7")->type ==
+              OSL_SYMBOL_TYPE_FUNCTION)
+                 ? 0
+                 : 1;
+  osl_symbols_index_free(index);
+  nb_fail += (osl_symbols_remove(&symbols, symbol) == NULL) ? 0 : 1;
+  osl_symbols_free(symbol);
+  osl_symbols_free(symbols);
+  index = osl_symbols_index_build(NULL);
+  nb_fail += (osl_symbols_index_lookup(index, "s7") == NULL) ? 0 : 1;
+  osl_symbols_index_free(index);
+  printf("removal: nb fail = %d\n", nb_fail);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+
+  return nb_fail;
+}
@@ -64,6 +64,8 @@
 #include <stdio.h>
 #include <dirent.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <osl/osl.h>
@@ -121,6 +123,375 @@ static int test_unions(osl_scop_p scop) {
   return 1;
 }
 
+/// Check whether a point (one value per column but the first and the last
+/// ones) satisfies the constraints of a dense relation union part.
+static int test_contains(osl_relation_p relation, const long* point) {
+  int i, j, precision = relation->precision;
+  long value;
+
+  for (i = 0; i < relation->nb_rows; i++) {
+    value = osl_int_get_si(precision, relation->m[i][relation->nb_columns - 1]);
+    for (j = 1; j < relation->nb_columns - 1; j++)
+      value += osl_int_get_si(precision, relation->m[i][j]) * point[j - 1];
+    if (osl_int_zero(precision, relation->m[i][0]) ? (value != 0) : (value < 0))
+      return 0;
+  }
+  return 1;
+}
+
+/// Check that two relation unions have the same integer points, part by
+/// part, in the box [-1, 2]^n (sampled when it is too large).
+static int test_same_points(osl_relation_p r1, osl_relation_p r2) {
+  int j, n, exhaustive;
+  long p, nb_points;
+  long* point;
+
+  srand(42);
+  for ( ; r1 != NULL && r2 != NULL; r1 = r1->next, r2 = r2->next) {
+    if (r1->nb_columns != r2->nb_columns || r1->sparse != NULL ||
+        r2->sparse != NULL)
+      return 0;
+    n = r1->nb_columns - 2;
+    exhaustive = (n <= 6);
+    nb_points = exhaustive ? (1L << (2 * n)) : 4096;
+    point = malloc((size_t)(n + 1) * sizeof(long));
+    for (p = 0; p < nb_points; p++) {
+      for (j = 0; j < n; j++)
+        point[j] = (exhaustive ? ((p >> (2 * j)) & 3) : (rand() & 3)) - 1;
+      if (test_contains(r1, point) != test_contains(r2, point)) {
+        free(point);
+        return 0;
+      }
+    }
+    free(point);
+  }
+  return (r1 == NULL) && (r2 == NULL);
+}
+
+/// Check that a canonical relation union has the same integer points as the
+/// original one, and that reversing and scaling the rows of the original
+/// one gives the same canonical form.
+static int test_canonical_relation(osl_relation_p relation,
+                                   osl_relation_p canonical) {
+  int i, j, result;
+  osl_relation_p variant, part;
+
+  if (!test_same_points(relation, canonical))
+    return 0;
+
+  variant = osl_relation_clone(relation);
+  for (part = variant; part != NULL; part = part->next) {
+    for (i = 0; i < part->nb_rows / 2; i++)
+      osl_relation_swap_constraints(part, i, part->nb_rows - 1 - i);
+    for (i = 0; i < part->nb_rows; i++)
+      for (j = 1; j < part->nb_columns; j++)
+        osl_int_mul_si(part->precision, &part->m[i][j], part->m[i][j], 3);
+  }
+  osl_relation_canonicalize(variant);
+  result = osl_relation_equal(variant, canonical);
+  osl_relation_free(variant);
+  return result;
+}
+
+/// Check that canonicalizing a scop keeps it well formed, is idempotent and
+/// preserves the integer points of every relation.
+static int test_canonical(osl_scop_p scop) {
+  int result;
+  uint64_t hash;
+  osl_scop_p canonical_scop = osl_scop_clone(scop);
+  osl_scop_p canonical = canonical_scop;
+  osl_statement_p statement, canonical_statement;
+  osl_relation_list_p access, canonical_access;
+
+  osl_scop_canonicalize(canonical_scop);
+  result = osl_scop_integrity_check(canonical_scop);
+  for ( ; scop != NULL && result; scop = scop->next) {
+    result = test_canonical_relation(scop->context, canonical->context);
+    canonical_statement = canonical->statement;
+    for (statement = scop->statement; statement != NULL && result;
+         statement = statement->next) {
+      result = test_canonical_relation(statement->domain,
+                                       canonical_statement->domain) &&
+               test_canonical_relation(statement->scattering,
+                                       canonical_statement->scattering);
+      canonical_access = canonical_statement->access;
+      for (access = statement->access; access != NULL && result;
+           access = access->next) {
+        result = test_canonical_relation(access->elt, canonical_access->elt);
+        canonical_access = canonical_access->next;
+      }
+      canonical_statement = canonical_statement->next;
+    }
+    canonical = canonical->next;
+  }
+  hash = osl_scop_hash(canonical_scop);
+  osl_scop_canonicalize(canonical_scop);
+  result = result && (osl_scop_hash(canonical_scop) == hash);
+  osl_scop_free(canonical_scop);
+  return result;
+}
+
+/// Check that the constraints of a specialized relation union are the
+/// original ones with the specialized parameters folded into the constant.
+static int test_specialized_relation(osl_relation_p original,
+                                     osl_relation_p specialized,
+                                     const long* values, const int* mask) {
+  int i, j, k, first, constant, result = 1;
+  long expected;
+
+  osl_relation_to_dense(original);
+  osl_relation_to_dense(specialized);
+  for (; (original != NULL) && (specialized != NULL) && result;
+       original = original->next, specialized = specialized->next) {
+    result = (original->nb_rows == specialized->nb_rows);
+    constant = original->nb_columns - 1;
+    first = constant - original->nb_parameters;
+    for (i = 0; (i < original->nb_rows) && result; i++) {
+      expected = osl_int_get_si(original->precision, original->m[i][constant]);
+      for (j = 0, k = 0; (j < constant) && result; j++) {
+        if ((j < first) || ((mask != NULL) && !mask[j - first]))
+          result = osl_int_eq(original->precision, original->m[i][j],
+                              specialized->m[i][k++]);
+        else
+          expected += values[j - first] *
+                      osl_int_get_si(original->precision, original->m[i][j]);
+      }
+      result = result && (k == specialized->nb_columns - 1) &&
+               (osl_int_get_si(specialized->precision,
+                               specialized->m[i][k]) == expected);
+    }
+  }
+  return result && (original == NULL) && (specialized == NULL);
+}
+
+/// Check that specializing the parameters of a scop folds their values into
+/// the constraints and keeps the names of the other parameters.
+static int test_specialize(osl_scop_p scop) {
+  int i, nb_parameters, nb_kept, result = 1;
+  long *values, *kept_values;
+  int* mask;
+  osl_strings_p names = NULL, kept_names;
+  osl_scop_p specialized_scop;
+
+  if ((scop == NULL) || (scop->context == NULL) ||
+      (scop->context->nb_parameters <= 0))
+    return 1;
+
+  nb_parameters = scop->context->nb_parameters;
+  values = malloc((size_t)nb_parameters * sizeof(long));
+  kept_values = malloc((size_t)nb_parameters * sizeof(long));
+  mask = malloc((size_t)nb_parameters * sizeof(int));
+  nb_kept = 0;
+  for (i = 0; i < nb_parameters; i++) {
+    values[i] = 10 + i;
+    mask[i] = (i + 1) % 2;
+    if (!mask[i])
+      kept_values[nb_kept++] = values[i];
+  }
+  if ((scop->parameters != NULL) &&
+      osl_generic_has_URI(scop->parameters,
+                          osl_interface_atom(OSL_URI_STRINGS)))
+    names = scop->parameters->data;
+
+  // Specialize every other parameter: the others keep their names.
+  specialized_scop = osl_scop_clone(scop);
+  osl_scop_specialize_parameters(specialized_scop, values, mask);
+  result = osl_scop_integrity_check(specialized_scop);
+  result = result && test_specialized_relation(scop->context,
+                                               specialized_scop->context,
+                                               values, mask);
+  result = result && ((scop->statement == NULL) ||
+                       test_specialized_relation(
+                           scop->statement->domain,
+                           specialized_scop->statement->domain, values, mask));
+  result = result && (specialized_scop->context->nb_parameters == nb_kept);
+  if (result && (names != NULL)) {
+    result = ((specialized_scop->parameters != NULL) == (nb_kept > 0));
+    if (result && (nb_kept > 0)) {
+      kept_names = specialized_scop->parameters->data;
+      result = ((int)osl_strings_size(kept_names) == nb_kept);
+      for (i = 0; (i < nb_kept) && result; i++)
+        result = !strcmp(kept_names->string[i], names->string[2 * i + 1]);
+    }
+  }
+
+  // Specialize the remaining parameters, their values are indexed by their
+  // new positions.
+  osl_scop_specialize_parameters(specialized_scop, kept_values, NULL);
+  result = result && osl_scop_integrity_check(specialized_scop);
+  result = result && test_specialized_relation(scop->context,
+                                               specialized_scop->context,
+                                               values, NULL);
+  result = result && ((scop->statement == NULL) ||
+                       test_specialized_relation(
+                           scop->statement->domain,
+                           specialized_scop->statement->domain, values, NULL));
+  result = result && (specialized_scop->context->nb_parameters == 0);
+  result = result && (specialized_scop->parameters == NULL);
+  osl_scop_free(specialized_scop);
+  free(values);
+  free(kept_values);
+  free(mask);
+  return result;
+}
+
+/// Check that a statement index is consistent with the statement list.
+static int test_statement_index(osl_scop_p scop) {
+  int label, nb_statements, result = 1;
+  osl_scop_p indexed_scop = osl_scop_clone(scop);
+  osl_statement_p statement;
+  osl_statement_index_p index;
+  osl_dependence_p dependence;
+
+  if (indexed_scop == NULL)
+    return 1;
+
+  index = osl_statement_index_generate(&indexed_scop->statement);
+  nb_statements = osl_statement_number(indexed_scop->statement);
+  result = (index->nb_statements == nb_statements);
+  label = 0;
+  for (statement = indexed_scop->statement; statement != NULL;
+       statement = statement->next) {
+    result = result && (osl_statement_index_get(index, label) == statement);
+    result = result && (osl_statement_index_label(index, statement) == label);
+    label++;
+  }
+
+  // Move the first statement at the end of the list.
+  if (nb_statements > 0) {
+    statement = osl_statement_index_remove(index, 0);
+    result = result && (osl_statement_index_label(index, statement) ==
+                        OSL_UNDEFINED);
+    result = result && (osl_statement_index_get(index, 0) ==
+                        indexed_scop->statement);
+    osl_statement_index_add(index, statement);
+    result = result && (osl_statement_index_label(index, statement) ==
+                        nb_statements - 1);
+    result = result &&
+             (osl_statement_number(indexed_scop->statement) == nb_statements);
+
+    // Resolve a dependence from the last statement to the first one.
+    dependence = osl_dependence_malloc();
+    dependence->label_source = nb_statements - 1;
+    dependence->label_target = 0;
+    dependence->ref_source = 0;
+    dependence->ref_target = 0;
+    osl_dependence_resolve(dependence, index);
+    result = result && (dependence->stmt_source_ptr == statement);
+    result = result && (dependence->stmt_target_ptr == indexed_scop->statement);
+    result = result && ((statement->access == NULL) ||
+                        (dependence->ref_source_access_ptr ==
+                         statement->access->elt));
+    osl_dependence_free(dependence);
+
+    // Statements appended to the list are indexed at the next lookup.
+    statement = osl_statement_nclone(indexed_scop->statement, 1);
+    osl_statement_add(&indexed_scop->statement, statement);
+    result = result && (osl_statement_index_label(index, statement) ==
+                        nb_statements);
+    result = result &&
+             (osl_statement_index_get(index, nb_statements) == statement);
+
+    // Remove every other statement, the labels of the others follow.
+    for (label = 0; label < osl_statement_number(indexed_scop->statement);
+         label++)
+      osl_statement_free(osl_statement_index_remove(index, label));
+    label = 0;
+    for (statement = indexed_scop->statement; statement != NULL;
+         statement = statement->next) {
+      result = result && (osl_statement_index_get(index, label) == statement);
+      result = result && (osl_statement_index_label(index, statement) == label);
+      label++;
+    }
+    result = result && (index->nb_statements == label);
+  }
+
+  osl_statement_index_free(index);
+  osl_scop_free(indexed_scop);
+  return result;
+}
+
+/// Iteration counters of test_rendezvous().
+typedef struct {
+  atomic_int started; ///< Number of iterations started
+  atomic_int met;     ///< Number of iterations that saw all the others start
+} test_rendezvous_t;
+
+/// Loop body that waits (a few seconds at most) for the 4 iterations of its
+/// loop to start, which they only do in time if they run concurrently.
+static void test_rendezvous(void* data, int i) {
+  test_rendezvous_t* rendezvous = data;
+  time_t deadline = time(NULL) + 5;
+
+  (void)i;
+  atomic_fetch_add(&rendezvous->started, 1);
+  while ((atomic_load(&rendezvous->started) < 4) && (time(NULL) < deadline))
+    continue;
+  if (atomic_load(&rendezvous->started) == 4)
+    atomic_fetch_add(&rendezvous->met, 1);
+}
+
+/// Check that the parallel scop operations give the serial results, and that
+/// the worker pool runs iterations concurrently.
+static int test_parallel(osl_scop_p scop) {
+  int result;
+  test_rendezvous_t rendezvous;
+  osl_scop_p serial_clone, parallel_clone, serial_split, parallel_split;
+
+  serial_clone = osl_scop_clone(scop);
+  serial_split = osl_scop_remove_unions(scop);
+  osl_scop_normalize_scattering(serial_clone);
+
+  osl_util_set_nb_threads(4);
+  parallel_clone = osl_scop_clone(scop);
+  result = osl_scop_equal(scop, parallel_clone);
+  result = result && (osl_scop_hash(scop) == osl_scop_hash(parallel_clone));
+  result = result && osl_scop_integrity_check(parallel_clone);
+  parallel_split = osl_scop_remove_unions(scop);
+  result = result && osl_scop_equal(serial_split, parallel_split);
+  osl_scop_normalize_scattering(parallel_clone);
+  result = result && osl_scop_equal(serial_clone, parallel_clone);
+  osl_scop_set_precision(OSL_PRECISION_MP, parallel_clone);
+  osl_scop_set_precision(osl_util_get_precision(), parallel_clone);
+  result = result && osl_scop_equal(serial_clone, parallel_clone);
+  if (osl_util_is_parallel_supported()) {
+    atomic_init(&rendezvous.started, 0);
+    atomic_init(&rendezvous.met, 0);
+    osl_util_parallel_for(4, test_rendezvous, &rendezvous);
+    result = result && (atomic_load(&rendezvous.met) == 4);
+  }
+  osl_util_set_nb_threads(1);
+
+  osl_scop_free(serial_clone);
+  osl_scop_free(parallel_clone);
+  osl_scop_free(serial_split);
+  osl_scop_free(parallel_split);
+  return result;
+}
+
+/// Check that a scop reads the same whatever the integrity check mode.
+static int test_read_check(osl_scop_p scop) {
+  int i, result = 1;
+  int checks[] = {OSL_CHECK_INLINE, OSL_CHECK_NONE, OSL_CHECK_FULL};
+  FILE* file;
+  osl_scop_p read_scop;
+
+  for (i = 0; i < 3; i++) {
+    file = tmpfile();
+    if (file == NULL)
+      OSL_error("cannot open temporary output file for writing");
+    osl_scop_print(file, scop);
+    rewind(file);
+    read_scop = osl_scop_pread_check(file, osl_interface_get_frozen_registry(),
+                                     osl_util_get_precision(), checks[i]);
+    fclose(file);
+    result = result && osl_scop_equal(scop, read_scop);
+    osl_scop_free(read_scop);
+  }
+
+  return result;
+}
+
 /**
  * test_file function
  * This function tests an onpenscop file. A test has six steps:
@@ -140,6 +511,11 @@ static int test_file(char* input_name, int verbose) {
   int dumping = 0;
   int equal   = 0;
   int unions  = 0;
+  int canonical = 0;
+  int specialize = 0;
+  int indexing = 0;
+  int parallel = 0;
+  int checking = 0;
   FILE* input_file;
   FILE* output_file;
   osl_scop_p input_scop;
@@ -164,7 +540,8 @@ static int test_file(char* input_name, int verbose) {
   // PART II. Clone and test.
   cloned_scop = osl_scop_clone(input_scop);
   // Compare the two scops.
-  if ((cloning = osl_scop_equal(input_scop, cloned_scop)))
+  if ((cloning = osl_scop_equal(input_scop, cloned_scop) &&
+                 osl_scop_hash(input_scop) == osl_scop_hash(cloned_scop)))
     printf("- cloning succeeded\n");
   else
     printf("- cloning failed\n");
@@ -191,7 +568,8 @@ static int test_file(char* input_name, int verbose) {
   }
 
   // Compare the two scops.
-  if ((dumping = osl_scop_equal(input_scop, output_scop)))
+  if ((dumping = osl_scop_equal(input_scop, output_scop) &&
+                 osl_scop_hash(input_scop) == osl_scop_hash(output_scop)))
     printf("- dumping succeeded\n");
   else
     printf("- dumping failed\n");
@@ -199,8 +577,40 @@ static int test_file(char* input_name, int verbose) {
   // PART V. Remove unions.
   unions = test_unions(input_scop);
 
+  // PART VI. Canonicalize.
+  if ((canonical = test_canonical(input_scop)))
+    printf("- canonicalization succeeded\n");
+  else
+    printf("- canonicalization failed\n");
+
+  // PART VII. Specialize parameters.
+  if ((specialize = test_specialize(input_scop)))
+    printf("- specialization succeeded\n");
+  else
+    printf("- specialization failed\n");
+
+  // PART VIII. Index statements.
+  if ((indexing = test_statement_index(input_scop)))
+    printf("- statement indexing succeeded\n");
+  else
+    printf("- statement indexing failed\n");
+
+  // PART IX. Parallel operations.
+  if ((parallel = test_parallel(input_scop)))
+    printf("- parallel operations succeeded\n");
+  else
+    printf("- parallel operations failed\n");
+
+  // PART X. Integrity check modes.
+  if ((checking = test_read_check(input_scop)))
+    printf("- read check modes succeeded\n");
+  else
+    printf("- read check modes failed\n");
+
   // PART IV. Report.
-  if ((equal = (cloning + dumping + unions > 2) ? 1 : 0))
+  equal = cloning + dumping + unions + canonical + specialize + indexing +
+          parallel + checking;
+  if ((equal = (equal > 7) ? 1 : 0))
     printf("Success :-)\n");
   else
     printf("Failure :-(\n");